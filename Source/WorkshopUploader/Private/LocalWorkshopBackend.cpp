@@ -0,0 +1,320 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "LocalWorkshopBackend.h"
+#include "WorkshopUploader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+static TArray<FString> GetStringArray(const FJsonObject& Object, const FString& Field)
+{
+	TArray<FString> Values;
+	Object.TryGetStringArrayField(Field, Values);
+	return Values;
+}
+
+static void SetStringArray(FJsonObject& Object, const FString& Field, const TArray<FString>& Values)
+{
+	TArray<TSharedPtr<FJsonValue>> JsonValues;
+	for (const FString& Value : Values)
+		JsonValues.Add(MakeShared<FJsonValueString>(Value));
+
+	Object.SetArrayField(Field, JsonValues);
+}
+
+void FLocalWorkshopBackend::Tick()
+{
+	// Completions can make more calls, those wait for the next tick
+	TArray<TFunction<void()>> Completions = MoveTemp(PendingCompletions);
+	PendingCompletions.Reset();
+
+	for (TFunction<void()>& Completion : Completions)
+		Completion();
+}
+
+void FLocalWorkshopBackend::CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete)
+{
+	const TArray<uint64> Items = FindItems();
+	const uint64 PublishedFileId = Items.Num() > 0 ? FMath::Max(Items) + 1 : 1;
+
+	TSharedRef<FJsonObject> Item = MakeShared<FJsonObject>();
+	Item->SetNumberField(TEXT("consumerAppId"), ConsumerAppId);
+	Item->SetNumberField(TEXT("visibility"), (int32)EWorkshopVisibility::Private);
+
+	const bool bSaved = SaveItem(PublishedFileId, Item);
+
+	if (bSaved)
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Created local Workshop item %llu in %s"), PublishedFileId, *GetItemDir(PublishedFileId));
+
+	PendingCompletions.Add([OnComplete, bSaved, PublishedFileId]()
+	{
+		OnComplete(MakeResult(bSaved, bSaved ? TEXT("Created the local item.") : TEXT("Couldn't write the local item.")), bSaved ? PublishedFileId : 0, false);
+	});
+}
+
+void FLocalWorkshopBackend::SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete)
+{
+	const FString ItemDir = GetItemDir(Update.PublishedFileId);
+
+	const FWorkshopResult Result = ChangeItem(Update.PublishedFileId, [&Update, &ItemDir](FJsonObject& Item, FString& OutError)
+	{
+		// Other languages are kept next to the english text rather than replacing it, like Steam does
+		FJsonObject* Text = &Item;
+
+		if (Update.Language != TEXT("english"))
+		{
+			const TSharedPtr<FJsonObject>* Existing = nullptr;
+
+			TSharedPtr<FJsonObject> Localizations = Item.TryGetObjectField(TEXT("localizations"), Existing) ? *Existing : MakeShared<FJsonObject>();
+			Item.SetObjectField(TEXT("localizations"), Localizations);
+
+			TSharedPtr<FJsonObject> LocalizedText = Localizations->TryGetObjectField(Update.Language, Existing) ? *Existing : MakeShared<FJsonObject>();
+			Localizations->SetObjectField(Update.Language, LocalizedText);
+
+			Text = LocalizedText.Get();
+		}
+
+		if (Update.Title.IsSet())
+			Text->SetStringField(TEXT("title"), Update.Title.GetValue());
+		if (Update.Description.IsSet())
+			Text->SetStringField(TEXT("description"), Update.Description.GetValue());
+
+		if (Update.Metadata.IsSet())
+			Item.SetStringField(TEXT("metadata"), Update.Metadata.GetValue());
+		if (Update.Visibility.IsSet())
+			Item.SetNumberField(TEXT("visibility"), (int32)Update.Visibility.GetValue());
+		if (Update.Tags.IsSet())
+			SetStringArray(Item, TEXT("tags"), Update.Tags.GetValue());
+
+		if (Update.KeyValueTags.Num() > 0)
+		{
+			// Stored as "key=value", a key given in the update replaces all of its old values
+			TArray<FString> KeyValueTags = GetStringArray(Item, TEXT("keyValueTags"));
+
+			for (const TPair<FString, FString>& Tag : Update.KeyValueTags)
+				KeyValueTags.RemoveAll([&Tag](const FString& Existing) { return Existing.StartsWith(Tag.Key + TEXT("=")); });
+
+			for (const TPair<FString, FString>& Tag : Update.KeyValueTags)
+				KeyValueTags.Add(Tag.Key + TEXT("=") + Tag.Value);
+
+			SetStringArray(Item, TEXT("keyValueTags"), KeyValueTags);
+		}
+
+		// Previews are only tracked by key, the files themselves aren't copied
+		TArray<FString> Previews = GetStringArray(Item, TEXT("previews"));
+
+		for (const FWorkshopPreviewChange& Change : Update.PreviewChanges)
+		{
+			if (Change.Action == FWorkshopPreviewChange::EAction::Add)
+				Previews.Add(Change.Preview.Key);
+			else if (Change.Action == FWorkshopPreviewChange::EAction::Replace && Previews.IsValidIndex(Change.Index))
+				Previews[Change.Index] = Change.Preview.Key;
+			else if (Change.Action == FWorkshopPreviewChange::EAction::Remove && Previews.IsValidIndex(Change.Index))
+				Previews.RemoveAt(Change.Index);
+		}
+
+		SetStringArray(Item, TEXT("previews"), Previews);
+
+		if (!Update.PreviewFile.IsEmpty())
+			Item.SetStringField(TEXT("preview"), Update.PreviewFile);
+
+		if (!Update.ContentFolder.IsEmpty())
+		{
+			// Replaced as a whole, like a Steam content upload
+			const FString ContentDir = ItemDir / TEXT("Content");
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+			PlatformFile.DeleteDirectoryRecursively(*ContentDir);
+
+			if (!PlatformFile.CreateDirectoryTree(*ContentDir) || !PlatformFile.CopyDirectoryTree(*ContentDir, *Update.ContentFolder, true))
+			{
+				OutError = FString::Printf(TEXT("Couldn't copy %s to the local item."), *Update.ContentFolder);
+				return false;
+			}
+		}
+
+		if (!Update.ChangeNote.IsEmpty())
+		{
+			TArray<FString> ChangeNotes = GetStringArray(Item, TEXT("changeNotes"));
+			ChangeNotes.Add(Update.ChangeNote);
+			SetStringArray(Item, TEXT("changeNotes"), ChangeNotes);
+		}
+
+		return true;
+	});
+
+	PendingCompletions.Add([OnComplete, Result]() { OnComplete(Result, false); });
+}
+
+void FLocalWorkshopBackend::AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	const FWorkshopResult Result = ChangeItem(ParentPublishedFileId, [ChildPublishedFileId](FJsonObject& Item, FString& OutError)
+	{
+		TArray<FString> Dependencies = GetStringArray(Item, TEXT("dependencies"));
+		Dependencies.AddUnique(FString::Printf(TEXT("%llu"), ChildPublishedFileId));
+		SetStringArray(Item, TEXT("dependencies"), Dependencies);
+		return true;
+	});
+
+	PendingCompletions.Add([OnComplete, Result]() { OnComplete(Result); });
+}
+
+void FLocalWorkshopBackend::RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	const FWorkshopResult Result = ChangeItem(ParentPublishedFileId, [ChildPublishedFileId](FJsonObject& Item, FString& OutError)
+	{
+		TArray<FString> Dependencies = GetStringArray(Item, TEXT("dependencies"));
+		Dependencies.Remove(FString::Printf(TEXT("%llu"), ChildPublishedFileId));
+		SetStringArray(Item, TEXT("dependencies"), Dependencies);
+		return true;
+	});
+
+	PendingCompletions.Add([OnComplete, Result]() { OnComplete(Result); });
+}
+
+void FLocalWorkshopBackend::QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	TArray<FWorkshopItemDetails> Items;
+
+	for (uint64 PublishedFileId : PublishedFileIds)
+	{
+		if (TSharedPtr<FJsonObject> Item = LoadItem(PublishedFileId))
+			Items.Add(GetItemDetails(PublishedFileId, *Item));
+	}
+
+	PendingCompletions.Add([OnComplete, Items]() { OnComplete(MakeResult(true, FString()), Items); });
+}
+
+void FLocalWorkshopBackend::QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete)
+{
+	TArray<uint64> PublishedFileIds = FindItems();
+
+	// IDs count up, so newest first is highest first
+	PublishedFileIds.Sort([](uint64 A, uint64 B) { return A > B; });
+
+	TArray<FWorkshopItemDetails> Items;
+
+	for (uint64 PublishedFileId : PublishedFileIds)
+	{
+		TSharedPtr<FJsonObject> Item = LoadItem(PublishedFileId);
+
+		if (Item.IsValid() && (uint32)Item->GetNumberField(TEXT("consumerAppId")) == ConsumerAppId)
+			Items.Add(GetItemDetails(PublishedFileId, *Item));
+	}
+
+	PendingCompletions.Add([OnComplete, Items]() { OnComplete(MakeResult(true, FString()), Items); });
+}
+
+void FLocalWorkshopBackend::DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete)
+{
+	const FString ContentDir = GetItemDir(PublishedFileId) / TEXT("Content");
+	const bool bHasContent = IFileManager::Get().DirectoryExists(*ContentDir);
+
+	PendingCompletions.Add([OnComplete, ContentDir, bHasContent]()
+	{
+		OnComplete(MakeResult(bHasContent, bHasContent ? FString() : TEXT("The local item has no content.")), bHasContent ? ContentDir : FString());
+	});
+}
+
+void FLocalWorkshopBackend::ShowLegalAgreement(uint64 PublishedFileId)
+{
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Local Workshop items don't have a legal agreement (item %llu)"), PublishedFileId);
+}
+
+FString FLocalWorkshopBackend::GetRootDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("LocalWorkshop");
+}
+
+FString FLocalWorkshopBackend::GetItemDir(uint64 PublishedFileId)
+{
+	return GetRootDir() / FString::Printf(TEXT("%llu"), PublishedFileId);
+}
+
+TArray<uint64> FLocalWorkshopBackend::FindItems() const
+{
+	TArray<FString> ItemDirs;
+	IFileManager::Get().FindFiles(ItemDirs, *(GetRootDir() / TEXT("*")), false, true);
+
+	TArray<uint64> PublishedFileIds;
+
+	for (const FString& ItemDir : ItemDirs)
+	{
+		const uint64 PublishedFileId = FCString::Strtoui64(*ItemDir, nullptr, 10);
+		if (PublishedFileId != 0)
+			PublishedFileIds.Add(PublishedFileId);
+	}
+
+	return PublishedFileIds;
+}
+
+TSharedPtr<FJsonObject> FLocalWorkshopBackend::LoadItem(uint64 PublishedFileId) const
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *(GetItemDir(PublishedFileId) / TEXT("item.json"))))
+		return nullptr;
+
+	TSharedPtr<FJsonObject> Item;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	if (!FJsonSerializer::Deserialize(Reader, Item))
+		return nullptr;
+
+	return Item;
+}
+
+bool FLocalWorkshopBackend::SaveItem(uint64 PublishedFileId, const TSharedRef<FJsonObject>& Item) const
+{
+	// Pretty printed, these are meant to be looked at
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+	if (!FJsonSerializer::Serialize(Item, Writer))
+		return false;
+
+	return FFileHelper::SaveStringToFile(JsonString, *(GetItemDir(PublishedFileId) / TEXT("item.json")));
+}
+
+FWorkshopItemDetails FLocalWorkshopBackend::GetItemDetails(uint64 PublishedFileId, const FJsonObject& Item) const
+{
+	FWorkshopItemDetails Details;
+	Details.PublishedFileId = PublishedFileId;
+	Item.TryGetStringField(TEXT("title"), Details.Title);
+	Item.TryGetStringField(TEXT("description"), Details.Description);
+	Details.Tags = GetStringArray(Item, TEXT("tags"));
+
+	int32 Visibility = 0;
+	if (Item.TryGetNumberField(TEXT("visibility"), Visibility))
+		Details.Visibility = (EWorkshopVisibility)FMath::Clamp(Visibility, 0, (int32)EWorkshopVisibility::Unlisted);
+
+	return Details;
+}
+
+FWorkshopResult FLocalWorkshopBackend::ChangeItem(uint64 PublishedFileId, TFunctionRef<bool(FJsonObject& Item, FString& OutError)> Change) const
+{
+	TSharedPtr<FJsonObject> Item = LoadItem(PublishedFileId);
+	if (!Item.IsValid())
+		return MakeResult(false, FString::Printf(TEXT("There's no local item %llu."), PublishedFileId));
+
+	FString Error;
+	if (!Change(*Item, Error))
+		return MakeResult(false, Error);
+
+	if (!SaveItem(PublishedFileId, Item.ToSharedRef()))
+		return MakeResult(false, TEXT("Couldn't write the local item."));
+
+	return MakeResult(true, TEXT("Updated the local item."));
+}
+
+FWorkshopResult FLocalWorkshopBackend::MakeResult(bool bSuccess, const FString& Message)
+{
+	FWorkshopResult Result;
+	Result.bSuccess = bSuccess;
+	Result.Message = Message;
+	return Result;
+}
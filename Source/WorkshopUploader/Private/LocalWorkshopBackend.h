@@ -0,0 +1,55 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+class FJsonObject;
+
+/**
+ * A fake Workshop in Saved/WorkshopUploader/LocalWorkshop, for trying out publishing without Steam or touching real
+ * items. Every item is a folder with its fields in item.json and its uploaded content in Content, which is also what
+ * DownloadItem returns, so it can be edited by hand to see how the uploader copes with what it finds there
+ */
+class FLocalWorkshopBackend : public IWorkshopBackend
+{
+public:
+
+	/* What GetAppId reports, items remember the app they were created for */
+	static const uint32 LocalAppId = 1;
+
+	/* IWorkshopBackend implementation */
+	virtual bool IsAvailable() const override { return true; }
+	virtual bool TryInitialize() override { return true; }
+	virtual uint32 GetAppId() const override { return LocalAppId; }
+	virtual void Tick() override;
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override;
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override;
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override { return false; }
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override;
+
+	static FString GetRootDir();
+	static FString GetItemDir(uint64 PublishedFileId);
+
+private:
+
+	/* Results are handed out from Tick like the real backend's, never from inside the call */
+	TArray<TFunction<void()>> PendingCompletions;
+
+	TArray<uint64> FindItems() const;
+
+	TSharedPtr<FJsonObject> LoadItem(uint64 PublishedFileId) const;
+	bool SaveItem(uint64 PublishedFileId, const TSharedRef<FJsonObject>& Item) const;
+	FWorkshopItemDetails GetItemDetails(uint64 PublishedFileId, const FJsonObject& Item) const;
+
+	/* Loads the item, lets Change edit it and saves it again */
+	FWorkshopResult ChangeItem(uint64 PublishedFileId, TFunctionRef<bool(FJsonObject& Item, FString& OutError)> Change) const;
+
+	static FWorkshopResult MakeResult(bool bSuccess, const FString& Message);
+};
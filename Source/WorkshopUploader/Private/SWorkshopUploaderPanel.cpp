@@ -0,0 +1,1642 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "SWorkshopUploaderPanel.h"
+#include "WorkshopUploader.h"
+#include "WorkshopUploaderViewModel.h"
+#include "WorkshopModIndex.h"
+#include "WorkshopModDiscovery.h"
+#include "WorkshopPreviewImages.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
+#include "Misc/Paths.h"
+#include "Misc/MessageDialog.h"
+#include "Framework/Application/SlateApplication.h"
+
+#include "Widgets/SInvalidationPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Layout/SSeparator.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
+
+#define LOCTEXT_NAMESPACE "FWorkshopUploaderModule"
+
+namespace ModPickerColumns
+{
+	static const FName Mod(TEXT("Mod"));
+	static const FName Platforms(TEXT("Platforms"));
+	static const FName Size(TEXT("Size"));
+	static const FName Published(TEXT("Published"));
+}
+
+/* One packaged mod in the picker, with what's staged and when it was last published */
+class SWorkshopModPickerRow : public SMultiColumnTableRow<TSharedPtr<FWorkshopModEntry>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SWorkshopModPickerRow) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FWorkshopModEntry> InEntry)
+	{
+		Entry = InEntry;
+
+		SMultiColumnTableRow<TSharedPtr<FWorkshopModEntry>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FText Text;
+		FText ToolTip;
+
+		if (ColumnName == ModPickerColumns::Mod)
+		{
+			Text = FText::FromString(Entry->Package);
+			ToolTip = FText::FromString(FString::Join(Entry->Tags, TEXT(", ")));
+
+			if (!Entry->FriendlyName.IsEmpty())
+				ToolTip = FText::Format(LOCTEXT("ModPickerModTooltip", "{0}\n{1}"), FText::FromString(Entry->FriendlyName), ToolTip);
+		}
+		else if (ColumnName == ModPickerColumns::Platforms)
+		{
+			Text = FText::FromString(FString::Join(Entry->Platforms, TEXT(", ")));
+		}
+		else if (ColumnName == ModPickerColumns::Size)
+		{
+			Text = FText::AsMemory(Entry->StagedSize);
+		}
+		else if (ColumnName == ModPickerColumns::Published)
+		{
+			Text = Entry->LastPublished == FDateTime::MinValue() ? LOCTEXT("ModPickerNeverPublished", "Never") : FText::AsDateTime(Entry->LastPublished);
+		}
+
+		return SNew(STextBlock)
+			.Text(Text)
+			.ToolTipText(ToolTip);
+	}
+
+private:
+
+	TSharedPtr<FWorkshopModEntry> Entry;
+};
+
+void SWorkshopUploaderPanel::Construct(const FArguments& InArgs)
+{
+	ViewModel = InArgs._ViewModel;
+	check(ViewModel.IsValid());
+
+	// Define text styles
+	UploadProgressStyle = FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText");
+	UploadProgressStyle.SetColorAndOpacity(FSlateColor(FLinearColor::Yellow));
+
+	UploadSuccessStyle = FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText");
+	UploadSuccessStyle.SetColorAndOpacity(FSlateColor(FLinearColor::Green));
+
+	UploadFailureStyle = FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText");
+	UploadFailureStyle.SetColorAndOpacity(FSlateColor(FLinearColor::Red));
+
+	ChildSlot
+	[
+		SNew(SScrollBox)
+		+ SScrollBox::Slot()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SCheckBox)
+				.IsChecked(ViewModel->bVerifyAfterPublish ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState) { ViewModel->bVerifyAfterPublish = (NewState == ECheckBoxState::Checked); })
+				.ToolTipText(LOCTEXT("VerifyAfterPublishTooltip", "Downloads every item once it's published and checks each file against what was uploaded, the submission fails if anything differs"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("VerifyAfterPublish", "Verify Published Content"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				MakeLazyExpandableArea(LOCTEXT("ModDiscovery", "Mod Folders"), [this]() { return BuildDiscoveryForm(); })
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SInvalidationPanel)
+				[
+					BuildNewModForm()
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(NewModPublishButton, SButton)
+				.OnClicked(InArgs._OnPublishNewMod)
+				.Text(LOCTEXT("PublishToWorkshop", "Publish to Steam Workshop"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(NewModUploadStatusText, SMultiLineEditableText)
+				.Text(FText::FromString(""))
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 20.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSeparator)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SInvalidationPanel)
+				[
+					BuildUpdateModForm()
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(UpdateModPublishButton, SButton)
+				.OnClicked(InArgs._OnPublishUpdateMod)
+				.Text(LOCTEXT("PublishToWorkshop", "Publish to Steam Workshop"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(UpdateModUploadStatusText, SMultiLineEditableText)
+				.Text(FText::FromString(""))
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.OnClicked(InArgs._OnWatchUpdateMod)
+					.Text(LOCTEXT("WatchUpdateMod", "Watch and Publish on Change"))
+					.ToolTipText(LOCTEXT("WatchUpdateModTooltip", "Publishes the selected mod's staged build to this item as a content only update every time it's packaged again"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(StopWatchingButton, SButton)
+					.OnClicked(InArgs._OnStopWatching)
+					.Text(LOCTEXT("StopWatching", "Stop Watching"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(WatchStatusText, SMultiLineEditableText)
+				.Text(ViewModel->GetWatchStatus())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(AnalyzePatchButton, SButton)
+				.OnClicked(InArgs._OnAnalyzePatch)
+				.Text(LOCTEXT("AnalyzePatchSize", "Estimate Update Download Size"))
+				.ToolTipText(LOCTEXT("AnalyzePatchSizeTooltip", "Compares the staged build with what was last published to estimate how much subscribers will have to download"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(PatchReportText, SMultiLineEditableText)
+				.Text(ViewModel->GetPatchReport())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 20.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSeparator)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SInvalidationPanel)
+				[
+					BuildPipelineForm()
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(PackageAndPublishButton, SButton)
+					.OnClicked(InArgs._OnPackageAndPublish)
+					.Text(LOCTEXT("PackageAndPublish", "Package and Publish Selected"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(CancelPipelineButton, SButton)
+					.OnClicked(InArgs._OnCancelPipeline)
+					.Text(LOCTEXT("CancelPipeline", "Cancel"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(PipelineStatusText, SMultiLineEditableText)
+				.Text(ViewModel->GetPipelineStatus())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 10.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("SharedContent", "Shared Content (the ticked mods, or every packaged mod if none are ticked)"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(AnalyzeSharedContentButton, SButton)
+					.OnClicked(InArgs._OnAnalyzeSharedContent)
+					.Text(LOCTEXT("AnalyzeSharedContent", "Find Duplicated Content"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(SplitSharedContentButton, SButton)
+					.OnClicked(InArgs._OnSplitSharedContent)
+					.Text(LOCTEXT("SplitSharedContent", "Split Into Shared Item"))
+					.ToolTipText(LOCTEXT("SplitSharedContentTooltip", "Publishes the duplicated files as one item per platform, the mods drop their copies and depend on them the next time they're published"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(SharedContentReportText, SMultiLineEditableText)
+				.Text(ViewModel->GetSharedContentReport())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 10.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SInvalidationPanel)
+				[
+					BuildSizeBudgetForm()
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(AnalyzeSizesButton, SButton)
+				.OnClicked(InArgs._OnAnalyzeSizes)
+				.Text(LOCTEXT("AnalyzeSizes", "Analyze Staged Sizes"))
+				.ToolTipText(LOCTEXT("AnalyzeSizesTooltip", "Breaks each mod's staged build down by folder and file type, and compares it with its budget and what was last published"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(SizeReportText, SMultiLineEditableText)
+				.Text(ViewModel->GetSizeReport())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 20.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSeparator)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SInvalidationPanel)
+				[
+					BuildBulkEditForm(InArgs._OnLoadPublishedItems)
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(ApplyBulkEditButton, SButton)
+					.OnClicked(InArgs._OnApplyBulkEdit)
+					.Text(LOCTEXT("ApplyBulkEdit", "Apply to Listed Items"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(CancelBulkEditButton, SButton)
+					.OnClicked(InArgs._OnCancelBulkEdit)
+					.Text(LOCTEXT("CancelBulkEdit", "Cancel"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(BulkEditStatusText, SMultiLineEditableText)
+				.Text(ViewModel->GetBulkEditStatus())
+				.IsReadOnly(true)
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSpacer)
+				.Size(FVector2D(0.0f, 20.0f))
+			]
+		]
+	];
+
+	// Status is pushed to the two status widgets rather than polled, so nothing else has to repaint
+	ViewModel->OnStatusChanged.AddSP(this, &SWorkshopUploaderPanel::HandleStatusChanged);
+
+	HandleStatusChanged(false);
+	HandleStatusChanged(true);
+
+	ViewModel->OnPatchReportChanged.AddSP(this, &SWorkshopUploaderPanel::HandlePatchReportChanged);
+	HandlePatchReportChanged();
+
+	ViewModel->OnPipelineStatusChanged.AddSP(this, &SWorkshopUploaderPanel::HandlePipelineStatusChanged);
+	HandlePipelineStatusChanged();
+
+	ViewModel->OnSharedContentReportChanged.AddSP(this, &SWorkshopUploaderPanel::HandleSharedContentReportChanged);
+	HandleSharedContentReportChanged();
+
+	ViewModel->OnWatchStatusChanged.AddSP(this, &SWorkshopUploaderPanel::HandleWatchStatusChanged);
+	HandleWatchStatusChanged();
+
+	ViewModel->OnSizeReportChanged.AddSP(this, &SWorkshopUploaderPanel::HandleSizeReportChanged);
+	HandleSizeReportChanged();
+
+	ViewModel->OnPackagedModsChanged.AddSP(this, &SWorkshopUploaderPanel::HandlePackagedModsChanged);
+
+	ViewModel->OnBulkItemsChanged.AddSP(this, &SWorkshopUploaderPanel::HandleBulkItemsChanged);
+	ViewModel->OnBulkEditStatusChanged.AddSP(this, &SWorkshopUploaderPanel::HandleBulkEditStatusChanged);
+	HandleBulkEditStatusChanged();
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildDiscoveryForm()
+{
+	// Edited on a copy, nothing is rescanned until the changes are applied
+	TSharedRef<FWorkshopModDiscoverySettings> Settings = MakeShared<FWorkshopModDiscoverySettings>(FWorkshopModDiscovery::Get().GetSettings());
+
+	// The lambdas hold on to Settings, which keeps Patterns alive as long as the box is
+	auto MakePatternsBox = [Settings](const FText& Label, TArray<FString>& Patterns)
+	{
+		return SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(Label)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(SMultiLineEditableTextBox)
+			.Text(FText::FromString(FWorkshopModDiscoverySettings::PatternsToString(Patterns)))
+			.OnTextChanged_Lambda([Settings, &Patterns](const FText& Value) { Patterns = FWorkshopModDiscoverySettings::PatternsFromString(Value.ToString()); })
+		];
+	};
+
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakePatternsBox(LOCTEXT("DiscoveryRoots", "Folders searched for .uplugin files, one per line, relative to the project"), Settings->Roots)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakePatternsBox(LOCTEXT("DiscoveryInclude", "Include (wildcards matched against the .uplugin path inside its folder)"), Settings->Include)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakePatternsBox(LOCTEXT("DiscoveryExclude", "Exclude"), Settings->Exclude)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SButton)
+		.Text(LOCTEXT("ApplyDiscovery", "Apply and Rescan"))
+		.OnClicked_Lambda([this, Settings]()
+		{
+			// The summary is filled in again once the rescan is done
+			DiscoveryStatusText->SetText(LOCTEXT("Rescanning", "Rescanning..."));
+			ViewModel->ApplyDiscoverySettings(*Settings);
+
+			return FReply::Handled();
+		})
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SAssignNew(DiscoveryStatusText, STextBlock)
+		.Text(FText::FromString(FWorkshopModDiscovery::Get().Describe()))
+		.AutoWrapText(true)
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildSizeBudgetForm()
+{
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("SizeBudget", "Size Budget (the ticked mods, or every packaged mod if none are ticked), saved to DefaultGame.ini"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("DefaultSizeBudget", "Default Budget (MB, 0 for none) "))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(SEditableTextBox)
+			.Text(FText::AsNumber(ViewModel->GetSizeBudgets().DefaultBudgetMB, &FNumberFormattingOptions::DefaultNoGrouping()))
+			.OnTextCommitted_Lambda([this](const FText& Value, ETextCommit::Type CommitType)
+			{
+				ViewModel->GetSizeBudgets().DefaultBudgetMB = FMath::Max(0, FCString::Atoi(*Value.ToString()));
+				ViewModel->SaveSizeBudgets();
+			})
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PackageSizeBudgets", "Per Mod Budgets (Mod=MB, one per line)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SMultiLineEditableTextBox)
+		.Text(FText::FromString(ViewModel->GetSizeBudgets().PackageBudgetsToString()))
+		.OnTextCommitted_Lambda([this](const FText& Value, ETextCommit::Type CommitType)
+		{
+			ViewModel->GetSizeBudgets().PackageBudgetsFromString(Value.ToString());
+			ViewModel->SaveSizeBudgets();
+		})
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SCheckBox)
+		.IsChecked(ViewModel->GetSizeBudgets().bBlockOverBudget ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+		.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+		{
+			ViewModel->GetSizeBudgets().bBlockOverBudget = (NewState == ECheckBoxState::Checked);
+			ViewModel->SaveSizeBudgets();
+		})
+		.ToolTipText(LOCTEXT("BlockOverBudgetTooltip", "Submissions over their mod's budget, or bigger than what's left of the Steam quota, fail before uploading instead of only logging a warning"))
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("BlockOverBudget", "Block Uploads Over Budget"))
+		]
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildNewModForm()
+{
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UploadNewItem", "Upload New Workshop Item"))
+		.Font(FCoreStyle::GetDefaultFontStyle("Bold", 13))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("NewModTitle", "Title"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(false).Title)
+		.OnTextChanged_Lambda([this](const FText& Value) {OnTitleTextChanged(Value, false); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("NewModDescription", "Description"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(false).Description)
+		.OnTextChanged_Lambda([this](const FText& Value) {OnDescriptionTextChanged(Value, false); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakeLazyExpandableArea(LOCTEXT("NewModTags", "Tags"), [this]() { return BuildTagCheckboxes(false); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("Thumbnail", "Thumbnail (recompressed to fit under 1MB if needed)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		[
+			SAssignNew(NewModThumbnailTextBox, SEditableTextBox)
+			.Text(ViewModel->GetDraft(false).Thumbnail)
+			.OnTextChanged_Lambda([this](const FText& Value) {OnThumbnailTextChanged(Value, false); })
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("Browse", "Browse..."))
+			.OnClicked_Lambda([this]() { return OnBrowseClicked(NewModThumbnailTextBox); })
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	.Padding(0.0f, 10.0f, 0.0f, 0.0f)
+	[
+		MakeLazyExpandableArea(LOCTEXT("NewModGallery", "Gallery"), [this]() { return BuildGalleryEditor(false); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PackagedMod", "Packaged Mod"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		BuildPackagedModPicker(false)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	.Padding(0.0f, 10.0f, 0.0f, 0.0f)
+	[
+		BuildTargetAppsField(false)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PubliclyVisible", "Publicly Visible"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SCheckBox)
+		.IsChecked(ViewModel->GetDraft(false).bIsVisible ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+		.OnCheckStateChanged_Raw(this, &SWorkshopUploaderPanel::OnVisibilityChanged)
+		.ToolTipText(LOCTEXT("PubliclyVisibleTooltip", "Whether or not to publish the workshop item as visible, use Bulk Edit to change it later"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildUpdateModForm()
+{
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UpdateExistingItem", "Update Existing Workshop Item"))
+		.Font(FCoreStyle::GetDefaultFontStyle("Bold", 13))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("ItemIDToUpdate", "Workshop item ID to update"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(true).WorkshopId)
+		.HintText(FText::FromString("123456789"))
+		.OnTextChanged_Raw(this, &SWorkshopUploaderPanel::OnModIdTextChanged)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakeLazyExpandableArea(LOCTEXT("OptionalUpdateFields", "Optional Update Fields"), [this]() { return BuildOptionalUpdateFields(); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakeLazyExpandableArea(LOCTEXT("UpdateModTags", "Tags (leave blank to keep the current ones)"), [this]() { return BuildTagCheckboxes(true); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PackagedMod", "Packaged Mod"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		BuildPackagedModPicker(true)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	.Padding(0.0f, 10.0f, 0.0f, 0.0f)
+	[
+		BuildTargetAppsField(true)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UpdateModChangeNote", "Change Note"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(true).ChangeNote)
+		.OnTextChanged_Raw(this, &SWorkshopUploaderPanel::OnChangeNoteTextChanged)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildOptionalUpdateFields()
+{
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UpdateModTitle", "Title (Leave blank to keep the current one)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(true).Title)
+		.OnTextChanged_Lambda([this](const FText& Value) {OnTitleTextChanged(Value, true); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UpdateModDescription", "Description (Leave blank to keep the current one)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->GetDraft(true).Description)
+		.OnTextChanged_Lambda([this](const FText& Value) {OnDescriptionTextChanged(Value, true); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("UpdateModThumbnail", "Thumbnail (Leave blank to keep the current one)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		[
+			SAssignNew(UpdateModThumbnailTextBox, SEditableTextBox)
+			.Text(ViewModel->GetDraft(true).Thumbnail)
+			.OnTextChanged_Lambda([this](const FText& Value) {OnThumbnailTextChanged(Value, true); })
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("Browse", "Browse..."))
+			.OnClicked_Lambda([this]() { return OnBrowseClicked(UpdateModThumbnailTextBox); })
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	.Padding(0.0f, 10.0f, 0.0f, 0.0f)
+	[
+		MakeLazyExpandableArea(LOCTEXT("UpdateModGallery", "Gallery (Leave empty to keep the current one)"), [this]() { return BuildGalleryEditor(true); })
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildPipelineForm()
+{
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PackageAndPublishMods", "Package and Publish Mods"))
+		.Font(FCoreStyle::GetDefaultFontStyle("Bold", 13))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		MakeLazyExpandableArea(LOCTEXT("PipelineMods", "Mods"), [this]() { return BuildPipelineModCheckboxes(); })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("PipelineChangeNote", "Change Note (used for mods that are already on the Workshop)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->PipelineChangeNote)
+		.OnTextChanged_Lambda([this](const FText& Value) { ViewModel->PipelineChangeNote = Value; })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildBulkEditForm(FOnClicked OnLoadPublishedItems)
+{
+	// The options outlive the form, rebuilding it mustn't add them again
+	BulkVisibilityOptions.Reset();
+
+	for (const TCHAR* Option : { TEXT("Keep"), TEXT("Public"), TEXT("Friends Only"), TEXT("Private"), TEXT("Unlisted") })
+		BulkVisibilityOptions.Add(MakeShared<FString>(Option));
+
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("BulkEdit", "Bulk Edit Published Items"))
+		.Font(FCoreStyle::GetDefaultFontStyle("Bold", 13))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 20.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("BulkItems", "Items (one ID per line, anything after the ID is ignored)"))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.OnClicked(OnLoadPublishedItems)
+			.Text(LOCTEXT("LoadPublishedItems", "Load My Published Items"))
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SBox)
+		.MaxDesiredHeight(200.0f)
+		[
+			SAssignNew(BulkItemsTextBox, SMultiLineEditableTextBox)
+			.Text(ViewModel->GetBulkItems())
+			.OnTextChanged_Lambda([this](const FText& Value) { ViewModel->SetBulkItems(Value, false); })
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("BulkVisibility", "Visibility"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SComboBox<TSharedPtr<FString>>)
+		.OptionsSource(&BulkVisibilityOptions)
+		.OnGenerateWidget_Lambda([](TSharedPtr<FString> Item) { return SNew(STextBlock).Text(FText::FromString(*Item)); })
+		.OnSelectionChanged_Lambda([this](TSharedPtr<FString> NewSelection, ESelectInfo::Type)
+		{
+			ViewModel->BulkVisibilityIndex = FMath::Max(0, BulkVisibilityOptions.IndexOfByKey(NewSelection));
+		})
+		.InitiallySelectedItem(BulkVisibilityOptions[FMath::Clamp(ViewModel->BulkVisibilityIndex, 0, BulkVisibilityOptions.Num() - 1)])
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]() { return FText::FromString(*BulkVisibilityOptions[FMath::Clamp(ViewModel->BulkVisibilityIndex, 0, BulkVisibilityOptions.Num() - 1)]); })
+		]
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("BulkAddTags", "Add Tags (comma separated)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->BulkAddTags)
+		.OnTextChanged_Lambda([this](const FText& Value) { ViewModel->BulkAddTags = Value; })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("BulkRemoveTags", "Remove Tags (comma separated)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(ViewModel->BulkRemoveTags)
+		.OnTextChanged_Lambda([this](const FText& Value) { ViewModel->BulkRemoveTags = Value; })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("BulkDescriptionTemplate", "Description (leave blank to keep, {title}, {description} and {id} are filled in per item)"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SMultiLineEditableTextBox)
+		.Text(ViewModel->BulkDescriptionTemplate)
+		.OnTextChanged_Lambda([this](const FText& Value) { ViewModel->BulkDescriptionTemplate = Value; })
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SSpacer)
+		.Size(FVector2D(0.0f, 10.0f))
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildPipelineModCheckboxes()
+{
+	TSharedRef<SVerticalBox> ModsVerticalBox = SNew(SVerticalBox);
+
+	for (const FString& Mod : ViewModel->GetProjectMods())
+	{
+		ModsVerticalBox->AddSlot()
+		.AutoHeight()
+		.Padding(0, 2)
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this, Mod]()
+			{
+				return ViewModel->PipelineSelection.Contains(Mod) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this, Mod](ECheckBoxState NewState)
+			{
+				if (NewState == ECheckBoxState::Checked)
+					ViewModel->PipelineSelection.Add(Mod);
+				else
+					ViewModel->PipelineSelection.Remove(Mod);
+			})
+			.Content()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Mod))
+			]
+		];
+	}
+	return ModsVerticalBox;
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildTagCheckboxes(bool IsUpdateMod)
+{
+	TSharedRef<SVerticalBox> TagsVerticalBox = SNew(SVerticalBox);
+
+	for (const FString& Tag : ViewModel->GetTagSettings().Tags)
+	{
+		TagsVerticalBox->AddSlot()
+		.AutoHeight()
+		.Padding(0, 2)
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this, IsUpdateMod, Tag]()
+			{
+				return ViewModel->GetDraft(IsUpdateMod).Tags.Contains(Tag) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this, IsUpdateMod, Tag](ECheckBoxState NewState)
+			{
+				TArray<FString>& TagsArray = ViewModel->GetDraft(IsUpdateMod).Tags;
+
+				if (NewState == ECheckBoxState::Checked)
+				{
+					if (!TagsArray.Contains(Tag))
+						TagsArray.Add(Tag);
+				}
+				else
+				{
+					TagsArray.Remove(Tag);
+				}
+
+				ViewModel->MarkDraftsDirty();
+			})
+			.Content()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Tag))
+			]
+		];
+	}
+	return TagsVerticalBox;
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildPackagedModPicker(bool IsUpdateMod)
+{
+	return SAssignNew(GetModPicker(IsUpdateMod).ComboButton, SComboButton)
+		.OnGetMenuContent_Lambda([this, IsUpdateMod]() { return BuildModPickerMenu(IsUpdateMod); })
+		.ButtonContent()
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this, IsUpdateMod]()
+			{
+				const FString& Package = ViewModel->GetDraft(IsUpdateMod).Package;
+				return Package.IsEmpty() ? FText::FromString(TEXT("Select...")) : FText::FromString(Package);
+			})
+		];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildModPickerMenu(bool IsUpdateMod)
+{
+	FModPicker& Picker = GetModPicker(IsUpdateMod);
+
+	// Lists what's already known straight away, mods packaged since the list was last opened are added once the rescan is done
+	ViewModel->RefreshPackagedMods();
+	ViewModel->GetModIndex().Search(FString(), Picker.Results);
+
+	TSharedRef<SWidget> Menu = SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SAssignNew(Picker.SearchBox, SSearchBox)
+		.HintText(LOCTEXT("SearchMods", "Search names and tags"))
+		.OnTextChanged_Lambda([this, IsUpdateMod](const FText& Value)
+		{
+			FModPicker& ChangedPicker = GetModPicker(IsUpdateMod);
+
+			ViewModel->GetModIndex().Search(Value.ToString(), ChangedPicker.Results);
+			ChangedPicker.ListView->RequestListRefresh();
+		})
+		.OnTextCommitted_Lambda([this, IsUpdateMod](const FText& Value, ETextCommit::Type CommitType)
+		{
+			// Enter takes the best match
+			const FModPicker& CommittedPicker = GetModPicker(IsUpdateMod);
+
+			if (CommitType == ETextCommit::OnEnter && CommittedPicker.Results.Num() > 0)
+				OnModPicked(CommittedPicker.Results[0], IsUpdateMod);
+		})
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SBox)
+		.WidthOverride(600.0f)
+		.MaxDesiredHeight(400.0f)
+		[
+			SAssignNew(Picker.ListView, SListView<TSharedPtr<FWorkshopModEntry>>)
+			.ListItemsSource(&Picker.Results)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SWorkshopUploaderPanel::GenerateModPickerRow)
+			.OnSelectionChanged_Lambda([this, IsUpdateMod](TSharedPtr<FWorkshopModEntry> Entry, ESelectInfo::Type SelectInfo)
+			{
+				// Arrowing through the list only moves the highlight
+				if (Entry.IsValid() && SelectInfo != ESelectInfo::OnNavigation)
+					OnModPicked(Entry, IsUpdateMod);
+			})
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(ModPickerColumns::Mod)
+				.FillWidth(0.4f)
+				.DefaultLabel(LOCTEXT("ModPickerMod", "Mod"))
+				+ SHeaderRow::Column(ModPickerColumns::Platforms)
+				.FillWidth(0.25f)
+				.DefaultLabel(LOCTEXT("ModPickerPlatforms", "Platforms"))
+				+ SHeaderRow::Column(ModPickerColumns::Size)
+				.FillWidth(0.15f)
+				.DefaultLabel(LOCTEXT("ModPickerSize", "Size"))
+				+ SHeaderRow::Column(ModPickerColumns::Published)
+				.FillWidth(0.2f)
+				.DefaultLabel(LOCTEXT("ModPickerPublished", "Last Published"))
+			)
+		]
+	];
+
+	Picker.ComboButton->SetMenuContentWidgetToFocus(Picker.SearchBox);
+
+	return Menu;
+}
+
+TSharedRef<ITableRow> SWorkshopUploaderPanel::GenerateModPickerRow(TSharedPtr<FWorkshopModEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SWorkshopModPickerRow, OwnerTable, Entry);
+}
+
+void SWorkshopUploaderPanel::OnModPicked(TSharedPtr<FWorkshopModEntry> Entry, bool IsUpdateMod)
+{
+	ViewModel->SetDraftPackage(IsUpdateMod, Entry->Package);
+
+	GetModPicker(IsUpdateMod).ComboButton->SetIsOpen(false);
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildTargetAppsField(bool IsUpdateMod)
+{
+	TArray<FString> AppIds;
+	for (uint32 AppId : ViewModel->GetDraft(IsUpdateMod).TargetAppIds)
+		AppIds.Add(LexToString(AppId));
+
+	return SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("TargetApps", "Also Publish To Apps"))
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SEditableTextBox)
+		.Text(FText::FromString(FString::Join(AppIds, TEXT(", "))))
+		.HintText(LOCTEXT("TargetAppsHint", "App IDs separated by commas, such as a demo or playtest"))
+		.ToolTipText(LOCTEXT("TargetAppsTooltip", "Every app gets its own item with the same content, hashed and checked once and uploaded to all of them at the same time"))
+		.OnTextChanged_Lambda([this, IsUpdateMod](const FText& Value) { OnTargetAppsTextChanged(Value, IsUpdateMod); })
+	];
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::BuildGalleryEditor(bool IsUpdateMod)
+{
+	TSharedPtr<SVerticalBox>& GalleryRows = IsUpdateMod ? UpdateModGalleryRows : NewModGalleryRows;
+	TSharedPtr<SEditableTextBox>& VideoTextBox = IsUpdateMod ? UpdateModVideoTextBox : NewModVideoTextBox;
+
+	TSharedRef<SWidget> Editor = SNew(SVerticalBox)
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(LOCTEXT("GalleryHint", "Shown after the thumbnail in this order. Images are scaled down and recompressed to fit the Workshop's limits when publishing."))
+		.AutoWrapText(true)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	.Padding(0.0f, 4.0f)
+	[
+		SAssignNew(GalleryRows, SVerticalBox)
+	]
+	+ SVerticalBox::Slot()
+	.AutoHeight()
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("AddGalleryImages", "Add Images..."))
+			.OnClicked_Lambda([this, IsUpdateMod]() { return OnAddGalleryImagesClicked(IsUpdateMod); })
+		]
+		+ SHorizontalBox::Slot()
+		.Padding(8.0f, 0.0f, 0.0f, 0.0f)
+		[
+			SAssignNew(VideoTextBox, SEditableTextBox)
+			.HintText(LOCTEXT("GalleryVideoHint", "YouTube link"))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("AddGalleryVideo", "Add Video"))
+			.OnClicked_Lambda([this, IsUpdateMod]() { return OnAddGalleryVideoClicked(IsUpdateMod); })
+		]
+	];
+
+	RefreshGalleryRows(IsUpdateMod);
+
+	return Editor;
+}
+
+void SWorkshopUploaderPanel::RefreshGalleryRows(bool IsUpdateMod)
+{
+	TSharedPtr<SVerticalBox> GalleryRows = IsUpdateMod ? UpdateModGalleryRows : NewModGalleryRows;
+	if (!GalleryRows.IsValid())
+		return;
+
+	GalleryRows->ClearChildren();
+
+	const TArray<FString>& Gallery = ViewModel->GetDraft(IsUpdateMod).Gallery;
+
+	for (int32 Index = 0; Index < Gallery.Num(); ++Index)
+	{
+		GalleryRows->AddSlot()
+		.AutoHeight()
+		.Padding(0, 2)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%d. %s"), Index + 1, *Gallery[Index])))
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("MoveGalleryEntryUp", "Up"))
+				.IsEnabled(Index > 0)
+				.OnClicked_Lambda([this, IsUpdateMod, Index]() { return OnMoveGalleryEntryClicked(IsUpdateMod, Index, -1); })
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("MoveGalleryEntryDown", "Down"))
+				.IsEnabled(Index < Gallery.Num() - 1)
+				.OnClicked_Lambda([this, IsUpdateMod, Index]() { return OnMoveGalleryEntryClicked(IsUpdateMod, Index, 1); })
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("RemoveGalleryEntry", "Remove"))
+				.OnClicked_Lambda([this, IsUpdateMod, Index]() { return OnRemoveGalleryEntryClicked(IsUpdateMod, Index); })
+			]
+		];
+	}
+}
+
+TSharedRef<SWidget> SWorkshopUploaderPanel::MakeLazyExpandableArea(const FText& AreaTitle, TFunction<TSharedRef<SWidget>()> BuildBody)
+{
+	TSharedRef<SBox> BodyBox = SNew(SBox);
+	TSharedRef<bool> bBodyBuilt = MakeShared<bool>(false);
+
+	return SNew(SExpandableArea)
+		.AreaTitle(AreaTitle)
+		.InitiallyCollapsed(true)
+		.Padding(8.0f)
+		.OnAreaExpansionChanged_Lambda([BodyBox, bBodyBuilt, BuildBody](bool bIsExpanded)
+		{
+			if (bIsExpanded && !*bBodyBuilt)
+			{
+				*bBodyBuilt = true;
+				BodyBox->SetContent(BuildBody());
+			}
+		})
+		.BodyContent()
+		[
+			BodyBox
+		];
+}
+
+void SWorkshopUploaderPanel::HandleStatusChanged(bool IsUpdateMod)
+{
+	const FWorkshopUploadStatus& Status = ViewModel->GetStatus(IsUpdateMod);
+	TSharedPtr<SMultiLineEditableText> StatusText = IsUpdateMod ? UpdateModUploadStatusText : NewModUploadStatusText;
+
+	if (StatusText.IsValid())
+	{
+		StatusText->SetText(Status.Message);
+
+		switch (Status.State)
+		{
+			case EWorkshopUploadState::Succeeded:
+				StatusText->SetTextStyle(&UploadSuccessStyle);
+				break;
+			case EWorkshopUploadState::Failed:
+				StatusText->SetTextStyle(&UploadFailureStyle);
+				break;
+			default:
+				StatusText->SetTextStyle(&UploadProgressStyle);
+				break;
+		}
+	}
+
+	const bool bCanPublish = !ViewModel->IsPublishing();
+	NewModPublishButton->SetEnabled(bCanPublish);
+	UpdateModPublishButton->SetEnabled(bCanPublish);
+}
+
+void SWorkshopUploaderPanel::HandlePatchReportChanged()
+{
+	PatchReportText->SetText(ViewModel->GetPatchReport());
+	AnalyzePatchButton->SetEnabled(!ViewModel->IsAnalyzingPatch());
+}
+
+void SWorkshopUploaderPanel::HandlePipelineStatusChanged()
+{
+	PipelineStatusText->SetText(ViewModel->GetPipelineStatus());
+	CancelPipelineButton->SetEnabled(ViewModel->IsPipelineRunning());
+}
+
+void SWorkshopUploaderPanel::HandleSharedContentReportChanged()
+{
+	SharedContentReportText->SetText(ViewModel->GetSharedContentReport());
+
+	const bool bIdle = !ViewModel->IsProcessingSharedContent();
+	AnalyzeSharedContentButton->SetEnabled(bIdle);
+	SplitSharedContentButton->SetEnabled(bIdle);
+}
+
+void SWorkshopUploaderPanel::HandleSizeReportChanged()
+{
+	SizeReportText->SetText(ViewModel->GetSizeReport());
+	AnalyzeSizesButton->SetEnabled(!ViewModel->IsAnalyzingSizes());
+}
+
+void SWorkshopUploaderPanel::HandleWatchStatusChanged()
+{
+	WatchStatusText->SetText(ViewModel->GetWatchStatus());
+	StopWatchingButton->SetEnabled(ViewModel->IsWatching());
+}
+
+void SWorkshopUploaderPanel::HandlePackagedModsChanged()
+{
+	// Searched again in the new index, keeping whatever has been typed
+	for (const bool IsUpdateMod : { false, true })
+	{
+		FModPicker& Picker = GetModPicker(IsUpdateMod);
+		if (!Picker.ListView.IsValid())
+			continue;
+
+		ViewModel->GetModIndex().Search(Picker.SearchBox.IsValid() ? Picker.SearchBox->GetText().ToString() : FString(), Picker.Results);
+		Picker.ListView->RequestListRefresh();
+	}
+
+	if (DiscoveryStatusText.IsValid())
+		DiscoveryStatusText->SetText(FText::FromString(FWorkshopModDiscovery::Get().Describe()));
+}
+
+void SWorkshopUploaderPanel::HandleBulkItemsChanged()
+{
+	BulkItemsTextBox->SetText(ViewModel->GetBulkItems());
+}
+
+void SWorkshopUploaderPanel::HandleBulkEditStatusChanged()
+{
+	BulkEditStatusText->SetText(ViewModel->GetBulkEditStatus());
+
+	const bool bRunning = ViewModel->IsBulkEditing();
+	ApplyBulkEditButton->SetEnabled(!bRunning);
+	CancelBulkEditButton->SetEnabled(bRunning);
+}
+
+/* FReply events */
+
+TArray<FString> SWorkshopUploaderPanel::OpenImageDialog(bool bMultiple) const
+{
+	TArray<FString> OutFiles;
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+
+	if (DesktopPlatform)
+	{
+		void* ParentWindowHandle = nullptr;
+		const TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().FindBestParentWindowForDialogs(nullptr);
+
+		if (ParentWindow.IsValid() && ParentWindow->GetNativeWindow().IsValid())
+			ParentWindowHandle = ParentWindow->GetNativeWindow()->GetOSWindowHandle();
+
+		const FString FileTypes = TEXT("Image Files (*.png;*.jpg;*.bmp)|*.png;*.jpg;*.bmp|All Files (*.*)|*.*");
+		DesktopPlatform->OpenFileDialog(ParentWindowHandle, bMultiple ? TEXT("Select Images") : TEXT("Select an Image"), FPaths::ProjectContentDir(), TEXT(""), FileTypes,
+			bMultiple ? EFileDialogFlags::Multiple : EFileDialogFlags::None, OutFiles);
+	}
+
+	for (FString& File : OutFiles)
+		File = FPaths::ConvertRelativePathToFull(File);
+
+	return OutFiles;
+}
+
+FReply SWorkshopUploaderPanel::OnBrowseClicked(TSharedPtr<SEditableTextBox> TargetTextBox)
+{
+	const TArray<FString> Files = OpenImageDialog(false);
+
+	if (Files.Num() > 0)
+		TargetTextBox->SetText(FText::FromString(Files[0]));
+
+	return FReply::Handled();
+}
+
+FReply SWorkshopUploaderPanel::OnAddGalleryImagesClicked(bool IsUpdateMod)
+{
+	const TArray<FString> Files = OpenImageDialog(true);
+
+	if (Files.Num() > 0)
+	{
+		ViewModel->GetDraft(IsUpdateMod).Gallery.Append(Files);
+		ViewModel->MarkDraftsDirty();
+		RefreshGalleryRows(IsUpdateMod);
+	}
+
+	return FReply::Handled();
+}
+
+FReply SWorkshopUploaderPanel::OnAddGalleryVideoClicked(bool IsUpdateMod)
+{
+	TSharedPtr<SEditableTextBox> VideoTextBox = IsUpdateMod ? UpdateModVideoTextBox : NewModVideoTextBox;
+	const FString Link = VideoTextBox->GetText().ToString().TrimStartAndEnd();
+
+	if (FWorkshopPreviewImages::GetYouTubeVideoId(Link).IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("InvalidGalleryVideo", "Only YouTube links (youtube.com/watch?v=... or youtu.be/...) can be added as videos."));
+		return FReply::Handled();
+	}
+
+	ViewModel->GetDraft(IsUpdateMod).Gallery.Add(Link);
+	ViewModel->MarkDraftsDirty();
+	VideoTextBox->SetText(FText::GetEmpty());
+	RefreshGalleryRows(IsUpdateMod);
+
+	return FReply::Handled();
+}
+
+FReply SWorkshopUploaderPanel::OnMoveGalleryEntryClicked(bool IsUpdateMod, int32 Index, int32 Offset)
+{
+	TArray<FString>& Gallery = ViewModel->GetDraft(IsUpdateMod).Gallery;
+
+	if (Gallery.IsValidIndex(Index) && Gallery.IsValidIndex(Index + Offset))
+	{
+		Gallery.Swap(Index, Index + Offset);
+		ViewModel->MarkDraftsDirty();
+		RefreshGalleryRows(IsUpdateMod);
+	}
+
+	return FReply::Handled();
+}
+
+FReply SWorkshopUploaderPanel::OnRemoveGalleryEntryClicked(bool IsUpdateMod, int32 Index)
+{
+	TArray<FString>& Gallery = ViewModel->GetDraft(IsUpdateMod).Gallery;
+
+	if (Gallery.IsValidIndex(Index))
+	{
+		Gallery.RemoveAt(Index);
+		ViewModel->MarkDraftsDirty();
+		RefreshGalleryRows(IsUpdateMod);
+	}
+
+	return FReply::Handled();
+}
+
+/* OnChanged events, these only keep the FText and flag the drafts for saving */
+
+void SWorkshopUploaderPanel::OnTitleTextChanged(const FText& Value, bool IsUpdateMod)
+{
+	ViewModel->GetDraft(IsUpdateMod).Title = Value;
+	ViewModel->MarkDraftsDirty();
+}
+void SWorkshopUploaderPanel::OnDescriptionTextChanged(const FText& Value, bool IsUpdateMod)
+{
+	ViewModel->GetDraft(IsUpdateMod).Description = Value;
+	ViewModel->MarkDraftsDirty();
+}
+void SWorkshopUploaderPanel::OnThumbnailTextChanged(const FText& Value, bool IsUpdateMod)
+{
+	ViewModel->GetDraft(IsUpdateMod).Thumbnail = Value;
+	ViewModel->MarkDraftsDirty();
+}
+void SWorkshopUploaderPanel::OnModIdTextChanged(const FText& Value)
+{
+	ViewModel->GetDraft(true).WorkshopId = Value;
+	ViewModel->MarkDraftsDirty();
+}
+
+void SWorkshopUploaderPanel::OnChangeNoteTextChanged(const FText& Value)
+{
+	ViewModel->GetDraft(true).ChangeNote = Value;
+	ViewModel->MarkDraftsDirty();
+}
+
+void SWorkshopUploaderPanel::OnTargetAppsTextChanged(const FText& Value, bool IsUpdateMod)
+{
+	TArray<FString> Parts;
+	Value.ToString().ParseIntoArray(Parts, TEXT(","));
+
+	TArray<uint32>& TargetAppIds = ViewModel->GetDraft(IsUpdateMod).TargetAppIds;
+	TargetAppIds.Reset();
+
+	for (const FString& Part : Parts)
+	{
+		const uint32 AppId = (uint32)FCString::Strtoui64(*Part.TrimStartAndEnd(), nullptr, 10);
+		if (AppId != 0)
+			TargetAppIds.AddUnique(AppId);
+	}
+
+	ViewModel->MarkDraftsDirty();
+}
+
+void SWorkshopUploaderPanel::OnVisibilityChanged(ECheckBoxState NewState)
+{
+	ViewModel->GetDraft(false).bIsVisible = (NewState == ECheckBoxState::Checked);
+	ViewModel->MarkDraftsDirty();
+}
+
+#undef LOCTEXT_NAMESPACE
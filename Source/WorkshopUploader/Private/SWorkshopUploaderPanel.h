@@ -0,0 +1,171 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Styling/SlateTypes.h"
+#include "Framework/SlateDelegates.h"
+
+class FWorkshopUploaderViewModel;
+class SButton;
+class SEditableTextBox;
+class SMultiLineEditableText;
+class SMultiLineEditableTextBox;
+class STextBlock;
+class SVerticalBox;
+class SComboButton;
+class SSearchBox;
+class ITableRow;
+class STableViewBase;
+template<typename ItemType> class SListView;
+struct FWorkshopModEntry;
+
+/* Contents of the uploader tab, built once from the view model and kept alive between tab spawns */
+class SWorkshopUploaderPanel : public SCompoundWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SWorkshopUploaderPanel) {}
+		SLATE_ARGUMENT(TSharedPtr<FWorkshopUploaderViewModel>, ViewModel)
+		SLATE_EVENT(FOnClicked, OnPublishNewMod)
+		SLATE_EVENT(FOnClicked, OnPublishUpdateMod)
+		SLATE_EVENT(FOnClicked, OnAnalyzePatch)
+		SLATE_EVENT(FOnClicked, OnPackageAndPublish)
+		SLATE_EVENT(FOnClicked, OnCancelPipeline)
+		SLATE_EVENT(FOnClicked, OnAnalyzeSharedContent)
+		SLATE_EVENT(FOnClicked, OnSplitSharedContent)
+		SLATE_EVENT(FOnClicked, OnLoadPublishedItems)
+		SLATE_EVENT(FOnClicked, OnApplyBulkEdit)
+		SLATE_EVENT(FOnClicked, OnCancelBulkEdit)
+		SLATE_EVENT(FOnClicked, OnWatchUpdateMod)
+		SLATE_EVENT(FOnClicked, OnStopWatching)
+		SLATE_EVENT(FOnClicked, OnAnalyzeSizes)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+private:
+
+	TSharedPtr<FWorkshopUploaderViewModel> ViewModel;
+
+	/* Sections, the static parts of each form sit in an invalidation panel so only the status area repaints while publishing */
+	TSharedRef<SWidget> BuildNewModForm();
+	TSharedRef<SWidget> BuildUpdateModForm();
+	TSharedRef<SWidget> BuildOptionalUpdateFields();
+	TSharedRef<SWidget> BuildPipelineForm();
+	TSharedRef<SWidget> BuildPipelineModCheckboxes();
+	TSharedRef<SWidget> BuildBulkEditForm(FOnClicked OnLoadPublishedItems);
+	TSharedRef<SWidget> BuildSizeBudgetForm();
+	TSharedRef<SWidget> BuildDiscoveryForm();
+	TSharedRef<SWidget> BuildTagCheckboxes(bool IsUpdateMod);
+	TSharedRef<SWidget> BuildPackagedModPicker(bool IsUpdateMod);
+	TSharedRef<SWidget> BuildModPickerMenu(bool IsUpdateMod);
+	TSharedRef<SWidget> BuildGalleryEditor(bool IsUpdateMod);
+	TSharedRef<SWidget> BuildTargetAppsField(bool IsUpdateMod);
+
+	/* Rebuilds the gallery list after entries are added, moved or removed */
+	void RefreshGalleryRows(bool IsUpdateMod);
+
+	/* Expandable area whose body is only built the first time it's expanded */
+	TSharedRef<SWidget> MakeLazyExpandableArea(const FText& AreaTitle, TFunction<TSharedRef<SWidget>()> BuildBody);
+
+	void HandleStatusChanged(bool IsUpdateMod);
+	void HandlePatchReportChanged();
+	void HandlePipelineStatusChanged();
+	void HandleSharedContentReportChanged();
+	void HandleBulkItemsChanged();
+	void HandleBulkEditStatusChanged();
+	void HandleWatchStatusChanged();
+	void HandleSizeReportChanged();
+	void HandlePackagedModsChanged();
+
+	/* Upload Status */
+	TSharedPtr<SMultiLineEditableText> NewModUploadStatusText;
+	TSharedPtr<SMultiLineEditableText> UpdateModUploadStatusText;
+
+	/* Patch size estimate for the update form */
+	TSharedPtr<SButton> AnalyzePatchButton;
+	TSharedPtr<SMultiLineEditableText> PatchReportText;
+
+	/* Package pipeline */
+	TSharedPtr<SButton> PackageAndPublishButton;
+	TSharedPtr<SButton> CancelPipelineButton;
+	TSharedPtr<SMultiLineEditableText> PipelineStatusText;
+
+	/* Shared content */
+	TSharedPtr<SButton> AnalyzeSharedContentButton;
+	TSharedPtr<SButton> SplitSharedContentButton;
+	TSharedPtr<SMultiLineEditableText> SharedContentReportText;
+
+	/* Size budget */
+	TSharedPtr<SButton> AnalyzeSizesButton;
+	TSharedPtr<SMultiLineEditableText> SizeReportText;
+
+	/* Watch mode */
+	TSharedPtr<SButton> StopWatchingButton;
+	TSharedPtr<SMultiLineEditableText> WatchStatusText;
+
+	/* Bulk edit */
+	TSharedPtr<SMultiLineEditableTextBox> BulkItemsTextBox;
+	TArray<TSharedPtr<FString>> BulkVisibilityOptions;
+	TSharedPtr<SButton> ApplyBulkEditButton;
+	TSharedPtr<SButton> CancelBulkEditButton;
+	TSharedPtr<SMultiLineEditableText> BulkEditStatusText;
+
+	FTextBlockStyle UploadProgressStyle;
+	FTextBlockStyle UploadSuccessStyle;
+	FTextBlockStyle UploadFailureStyle;
+
+	/* Thumbnail Path */
+	TSharedPtr<SEditableTextBox> NewModThumbnailTextBox;
+	TSharedPtr<SEditableTextBox> UpdateModThumbnailTextBox;
+
+	/* Buttons */
+	TSharedPtr<SButton> NewModPublishButton;
+	TSharedPtr<SButton> UpdateModPublishButton;
+
+	/* Gallery, only created once its area is expanded */
+	TSharedPtr<SVerticalBox> NewModGalleryRows;
+	TSharedPtr<SVerticalBox> UpdateModGalleryRows;
+	TSharedPtr<SEditableTextBox> NewModVideoTextBox;
+	TSharedPtr<SEditableTextBox> UpdateModVideoTextBox;
+
+	/* Absolute paths of the picked images, empty if the dialog was cancelled */
+	TArray<FString> OpenImageDialog(bool bMultiple) const;
+
+	FReply OnBrowseClicked(TSharedPtr<SEditableTextBox> TargetTextBox);
+	FReply OnAddGalleryImagesClicked(bool IsUpdateMod);
+	FReply OnAddGalleryVideoClicked(bool IsUpdateMod);
+	FReply OnMoveGalleryEntryClicked(bool IsUpdateMod, int32 Index, int32 Offset);
+	FReply OnRemoveGalleryEntryClicked(bool IsUpdateMod, int32 Index);
+
+	/* Searchable packaged mod picker, only the rows in view are built */
+	struct FModPicker
+	{
+		TSharedPtr<SComboButton> ComboButton;
+		TSharedPtr<SSearchBox> SearchBox;
+		TSharedPtr<SListView<TSharedPtr<FWorkshopModEntry>>> ListView;
+		TArray<TSharedPtr<FWorkshopModEntry>> Results;
+	};
+	FModPicker NewModPicker;
+	FModPicker UpdateModPicker;
+
+	FModPicker& GetModPicker(bool IsUpdateMod) { return IsUpdateMod ? UpdateModPicker : NewModPicker; }
+
+	/* What the last rescan found, under the discovery settings */
+	TSharedPtr<STextBlock> DiscoveryStatusText;
+
+	TSharedRef<ITableRow> GenerateModPickerRow(TSharedPtr<FWorkshopModEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnModPicked(TSharedPtr<FWorkshopModEntry> Entry, bool IsUpdateMod);
+
+	/* Text field update events */
+	void OnTitleTextChanged(const FText& Value, bool IsUpdateMod = false);
+	void OnDescriptionTextChanged(const FText& Value, bool IsUpdateMod = false);
+	void OnThumbnailTextChanged(const FText& Value, bool IsUpdateMod = false);
+	void OnVisibilityChanged(ECheckBoxState NewState);
+	void OnTargetAppsTextChanged(const FText& Value, bool IsUpdateMod);
+	void OnModIdTextChanged(const FText& Value);
+	void OnChangeNoteTextChanged(const FText& Value);
+};
@@ -0,0 +1,628 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "SteamWorkshopBackend.h"
+
+#if WITH_STEAM_WORKSHOP
+
+#include "WorkshopUploader.h"
+#include <string>
+
+/* IWorkshopBackend implementation */
+
+bool FSteamWorkshopBackend::IsAvailable() const
+{
+	// The workshop uploader can't function without SteamUGC which requires steam to be running
+	return SteamUGC() != nullptr;
+}
+
+bool FSteamWorkshopBackend::TryInitialize()
+{
+	// Check if SteamUGC is null and if it is then steam api was most likely destroyed so attempt to reinitialise it
+	if (SteamUGC() == nullptr)
+	{
+		const bool bInitialized = SteamAPI_Init();
+
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Reinitialising SteamAPI %s"), bInitialized ? TEXT("succeeded") : TEXT("failed"));
+	}
+
+	return IsAvailable();
+}
+
+uint32 FSteamWorkshopBackend::GetAppId() const
+{
+	return SteamUtils() ? SteamUtils()->GetAppID() : 0;
+}
+
+void FSteamWorkshopBackend::Tick()
+{
+	SteamAPI_RunCallbacks();
+
+	PendingCalls.RemoveAll([](const TUniquePtr<FPendingCall>& Call) { return Call->bCompleted; });
+}
+
+void FSteamWorkshopBackend::CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete)
+{
+	SteamAPICall_t hSteamAPICall = SteamUGC()->CreateItem(ConsumerAppId, k_EWorkshopFileTypeCommunity);
+
+	// Copy everything out of the callback struct, Steam owns it and it's gone once we return
+	bool bTracked = TrackCall<CreateItemResult_t>(hSteamAPICall, [OnComplete](CreateItemResult_t* pCallback, bool bIOFailure)
+	{
+		FWorkshopResult Result;
+		Result.bIOFailure = bIOFailure;
+		Result.Code = bIOFailure ? k_EResultIOFailure : pCallback->m_eResult;
+		Result.bSuccess = !bIOFailure && pCallback->m_eResult == k_EResultOK;
+		Result.bThrottled = !bIOFailure && IsThrottledResult(pCallback->m_eResult);
+		Result.Message = GetCreateItemResultString(static_cast<EResult>(Result.Code));
+
+		OnComplete(Result, bIOFailure ? 0 : pCallback->m_nPublishedFileId, !bIOFailure && pCallback->m_bUserNeedsToAcceptWorkshopLegalAgreement);
+	});
+
+	if (!bTracked)
+	{
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetCreateItemResultString(k_EResultFail);
+
+		OnComplete(Result, 0, false);
+	}
+}
+
+void FSteamWorkshopBackend::SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete)
+{
+	UGCUpdateHandle_t handle = SteamUGC()->StartItemUpdate(Update.ConsumerAppId, Update.PublishedFileId);
+
+	// Steam hands back an invalid handle for an app it isn't running as or a file ID it doesn't know, nothing after this would take
+	if (handle == k_UGCUpdateHandleInvalid)
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("StartItemUpdate returned an invalid handle for item %llu in app %u"), Update.PublishedFileId, Update.ConsumerAppId);
+
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = FString::Printf(TEXT("Steam couldn't start an update for item %llu in app %u. Check the app ID and that the item exists and belongs to you."), Update.PublishedFileId, Update.ConsumerAppId);
+
+		OnComplete(Result, false);
+		return;
+	}
+
+	if (Update.Title.IsSet()) { SteamUGC()->SetItemTitle(handle, TCHAR_TO_UTF8(*Update.Title.GetValue())); }
+	if (Update.Description.IsSet()) { SteamUGC()->SetItemDescription(handle, TCHAR_TO_UTF8(*Update.Description.GetValue())); }
+	SteamUGC()->SetItemUpdateLanguage(handle, TCHAR_TO_UTF8(*Update.Language));
+	if (Update.Metadata.IsSet()) { SteamUGC()->SetItemMetadata(handle, TCHAR_TO_UTF8(*Update.Metadata.GetValue())); }
+	if (Update.Visibility.IsSet()) { SteamUGC()->SetItemVisibility(handle, static_cast<ERemoteStoragePublishedFileVisibility>(Update.Visibility.GetValue())); }
+
+	if (Update.Tags.IsSet())
+	{
+		// SetItemTags copies the strings, so these only need to live until it returns
+		TArray<std::string> ConvertedTags;
+		TArray<const char*> TagPointers;
+
+		for (const FString& Tag : Update.Tags.GetValue())
+			ConvertedTags.Add(TCHAR_TO_UTF8(*Tag));
+
+		for (const std::string& Tag : ConvertedTags)
+			TagPointers.Add(Tag.c_str());
+
+		SteamParamStringArray_t Tags;
+		Tags.m_ppStrings = TagPointers.GetData();
+		Tags.m_nNumStrings = TagPointers.Num();
+
+		SteamUGC()->SetItemTags(handle, &Tags);
+	}
+
+	// Replace rather than add to the values already on the item, Steam applies removals before additions
+	TSet<FString> KeyValueTagKeys;
+	for (const TPair<FString, FString>& KeyValueTag : Update.KeyValueTags)
+	{
+		if (!KeyValueTagKeys.Contains(KeyValueTag.Key))
+		{
+			KeyValueTagKeys.Add(KeyValueTag.Key);
+			SteamUGC()->RemoveItemKeyValueTags(handle, TCHAR_TO_UTF8(*KeyValueTag.Key));
+		}
+	}
+
+	for (const TPair<FString, FString>& KeyValueTag : Update.KeyValueTags)
+	{
+		std::string Key = TCHAR_TO_UTF8(*KeyValueTag.Key);
+		std::string Value = TCHAR_TO_UTF8(*KeyValueTag.Value);
+		SteamUGC()->AddItemKeyValueTag(handle, Key.c_str(), Value.c_str());
+	}
+
+	if (!Update.ContentFolder.IsEmpty())
+	{
+		std::string mod_directory = TCHAR_TO_UTF8(*Update.ContentFolder);
+		SteamUGC()->SetItemContent(handle, mod_directory.c_str());
+	}
+
+	if (!Update.PreviewFile.IsEmpty())
+	{
+		std::string preview_image = TCHAR_TO_UTF8(*Update.PreviewFile);
+		SteamUGC()->SetItemPreview(handle, preview_image.c_str());
+	}
+
+	for (const FWorkshopPreviewChange& Change : Update.PreviewChanges)
+	{
+		std::string Value = TCHAR_TO_UTF8(*Change.Preview.Value);
+		const bool bIsImage = Change.Preview.Type == EWorkshopPreviewType::Image;
+
+		switch (Change.Action)
+		{
+			case FWorkshopPreviewChange::EAction::Add:
+				bIsImage ? SteamUGC()->AddItemPreviewFile(handle, Value.c_str(), k_EItemPreviewType_Image) : SteamUGC()->AddItemPreviewVideo(handle, Value.c_str());
+				break;
+			case FWorkshopPreviewChange::EAction::Replace:
+				bIsImage ? SteamUGC()->UpdateItemPreviewFile(handle, Change.Index, Value.c_str()) : SteamUGC()->UpdateItemPreviewVideo(handle, Change.Index, Value.c_str());
+				break;
+			case FWorkshopPreviewChange::EAction::Remove:
+				SteamUGC()->RemoveItemPreview(handle, Change.Index);
+				break;
+		}
+	}
+
+	std::string pchChangeNote = TCHAR_TO_UTF8(*Update.ChangeNote);
+
+	// Text only updates (other languages) shouldn't each add an empty entry to the change notes
+	SteamAPICall_t submit_item_call = SteamUGC()->SubmitItemUpdate(handle, Update.ChangeNote.IsEmpty() ? nullptr : pchChangeNote.c_str());
+
+	bool bTracked = TrackCall<SubmitItemUpdateResult_t>(submit_item_call, [OnComplete](SubmitItemUpdateResult_t* pCallback, bool bIOFailure)
+	{
+		FWorkshopResult Result;
+		Result.bIOFailure = bIOFailure;
+		Result.Code = bIOFailure ? k_EResultIOFailure : pCallback->m_eResult;
+		Result.bSuccess = !bIOFailure && pCallback->m_eResult == k_EResultOK;
+		Result.bThrottled = !bIOFailure && IsThrottledResult(pCallback->m_eResult);
+		Result.Message = GetSubmitItemUpdateResultString(static_cast<EResult>(Result.Code));
+
+		OnComplete(Result, !bIOFailure && pCallback->m_bUserNeedsToAcceptWorkshopLegalAgreement);
+	});
+
+	if (!bTracked)
+	{
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetSubmitItemUpdateResultString(k_EResultFail);
+
+		OnComplete(Result, false);
+	}
+}
+
+void FSteamWorkshopBackend::AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	SteamAPICall_t hSteamAPICall = SteamUGC()->AddDependency(ParentPublishedFileId, ChildPublishedFileId);
+
+	bool bTracked = TrackCall<AddUGCDependencyResult_t>(hSteamAPICall, [OnComplete](AddUGCDependencyResult_t* pCallback, bool bIOFailure)
+	{
+		FWorkshopResult Result;
+		Result.bIOFailure = bIOFailure;
+		Result.Code = bIOFailure ? k_EResultIOFailure : pCallback->m_eResult;
+		Result.bSuccess = !bIOFailure && pCallback->m_eResult == k_EResultOK;
+		Result.bThrottled = !bIOFailure && IsThrottledResult(pCallback->m_eResult);
+		Result.Message = GetSteamResultString(static_cast<EResult>(Result.Code));
+
+		OnComplete(Result);
+	});
+
+	if (!bTracked)
+	{
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetSteamResultString(k_EResultFail);
+
+		OnComplete(Result);
+	}
+}
+
+void FSteamWorkshopBackend::RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	SteamAPICall_t hSteamAPICall = SteamUGC()->RemoveDependency(ParentPublishedFileId, ChildPublishedFileId);
+
+	bool bTracked = TrackCall<RemoveUGCDependencyResult_t>(hSteamAPICall, [OnComplete](RemoveUGCDependencyResult_t* pCallback, bool bIOFailure)
+	{
+		FWorkshopResult Result;
+		Result.bIOFailure = bIOFailure;
+		Result.Code = bIOFailure ? k_EResultIOFailure : pCallback->m_eResult;
+		Result.bSuccess = !bIOFailure && pCallback->m_eResult == k_EResultOK;
+		Result.bThrottled = !bIOFailure && IsThrottledResult(pCallback->m_eResult);
+		Result.Message = GetSteamResultString(static_cast<EResult>(Result.Code));
+
+		OnComplete(Result);
+	});
+
+	if (!bTracked)
+	{
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetSteamResultString(k_EResultFail);
+
+		OnComplete(Result);
+	}
+}
+
+void FSteamWorkshopBackend::QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	if (PublishedFileIds.Num() == 0)
+	{
+		FWorkshopResult Result;
+		Result.bSuccess = true;
+
+		OnComplete(Result, TArray<FWorkshopItemDetails>());
+		return;
+	}
+
+	// A details query returns at most one page, so larger batches go out as several queries at once
+	struct FDetailsQuery
+	{
+		TArray<FWorkshopItemDetails> Items;
+		FWorkshopResult Result;
+		int32 NumPending = 0;
+		FOnWorkshopItemsQueried OnComplete;
+	};
+
+	TSharedRef<FDetailsQuery> Query = MakeShared<FDetailsQuery>();
+	Query->Result.bSuccess = true;
+	Query->OnComplete = MoveTemp(OnComplete);
+	Query->NumPending = FMath::DivideAndRoundUp<int32>(PublishedFileIds.Num(), kNumUGCResultsPerPage);
+
+	for (int32 Start = 0; Start < PublishedFileIds.Num(); Start += kNumUGCResultsPerPage)
+	{
+		TArray<PublishedFileId_t> PageIds;
+		for (int32 Index = Start; Index < FMath::Min<int32>(Start + kNumUGCResultsPerPage, PublishedFileIds.Num()); ++Index)
+			PageIds.Add(PublishedFileIds[Index]);
+
+		UGCQueryHandle_t QueryHandle = SteamUGC()->CreateQueryUGCDetailsRequest(PageIds.GetData(), PageIds.Num());
+		SteamUGC()->SetReturnLongDescription(QueryHandle, true);
+
+		SendQuery(QueryHandle, [Query](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items, uint32 TotalMatchingResults)
+		{
+			if (!Result.bSuccess && Query->Result.bSuccess)
+				Query->Result = Result;
+
+			Query->Items.Append(Items);
+
+			if (--Query->NumPending == 0)
+				Query->OnComplete(Query->Result, Query->Items);
+		});
+	}
+}
+
+void FSteamWorkshopBackend::QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete)
+{
+	QueryPublishedPage(ConsumerAppId, 1, MakeShared<TArray<FWorkshopItemDetails>>(), MoveTemp(OnComplete));
+}
+
+void FSteamWorkshopBackend::QueryPublishedPage(uint32 ConsumerAppId, uint32 Page, TSharedRef<TArray<FWorkshopItemDetails>> Items, FOnWorkshopItemsQueried OnComplete)
+{
+	const AccountID_t AccountId = SteamUser() ? SteamUser()->GetSteamID().GetAccountID() : 0;
+
+	UGCQueryHandle_t QueryHandle = SteamUGC()->CreateQueryUserUGCRequest(AccountId, k_EUserUGCList_Published, k_EUGCMatchingUGCType_Items,
+		k_EUserUGCListSortOrder_CreationOrderDesc, ConsumerAppId, ConsumerAppId, Page);
+	SteamUGC()->SetReturnLongDescription(QueryHandle, true);
+
+	SendQuery(QueryHandle, [this, ConsumerAppId, Page, Items, OnComplete](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& PageItems, uint32 TotalMatchingResults)
+	{
+		Items->Append(PageItems);
+
+		if (Result.bSuccess && PageItems.Num() > 0 && static_cast<uint32>(Items->Num()) < TotalMatchingResults)
+		{
+			QueryPublishedPage(ConsumerAppId, Page + 1, Items, OnComplete);
+			return;
+		}
+
+		OnComplete(Result, *Items);
+	});
+}
+
+void FSteamWorkshopBackend::SendQuery(UGCQueryHandle_t QueryHandle, TFunction<void(const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items, uint32 TotalMatchingResults)> OnComplete)
+{
+	SteamAPICall_t hSteamAPICall = QueryHandle != k_UGCQueryHandleInvalid ? SteamUGC()->SendQueryUGCRequest(QueryHandle) : k_uAPICallInvalid;
+
+	bool bTracked = TrackCall<SteamUGCQueryCompleted_t>(hSteamAPICall, [QueryHandle, OnComplete](SteamUGCQueryCompleted_t* pCallback, bool bIOFailure)
+	{
+		FWorkshopResult Result;
+		Result.bIOFailure = bIOFailure;
+		Result.Code = bIOFailure ? k_EResultIOFailure : pCallback->m_eResult;
+		Result.bSuccess = !bIOFailure && pCallback->m_eResult == k_EResultOK;
+		Result.bThrottled = !bIOFailure && IsThrottledResult(pCallback->m_eResult);
+		Result.Message = GetSteamResultString(static_cast<EResult>(Result.Code));
+
+		TArray<FWorkshopItemDetails> Items;
+		uint32 TotalMatchingResults = 0;
+
+		if (!bIOFailure)
+		{
+			TotalMatchingResults = pCallback->m_unTotalMatchingResults;
+
+			for (uint32 Index = 0; Result.bSuccess && Index < pCallback->m_unNumResultsReturned; ++Index)
+			{
+				SteamUGCDetails_t Details;
+				if (!SteamUGC()->GetQueryUGCResult(pCallback->m_handle, Index, &Details) || Details.m_eResult != k_EResultOK)
+					continue;
+
+				FWorkshopItemDetails& Item = Items.AddDefaulted_GetRef();
+				Item.PublishedFileId = Details.m_nPublishedFileId;
+				Item.Title = UTF8_TO_TCHAR(Details.m_rgchTitle);
+				Item.Description = UTF8_TO_TCHAR(Details.m_rgchDescription);
+				Item.Visibility = static_cast<EWorkshopVisibility>(Details.m_eVisibility);
+
+				// Comma separated, and cut short if the item has a lot of them
+				FString(UTF8_TO_TCHAR(Details.m_rgchTags)).ParseIntoArray(Item.Tags, TEXT(","), true);
+			}
+		}
+
+		SteamUGC()->ReleaseQueryUGCRequest(QueryHandle);
+
+		OnComplete(Result, Items, TotalMatchingResults);
+	});
+
+	if (!bTracked)
+	{
+		if (QueryHandle != k_UGCQueryHandleInvalid)
+			SteamUGC()->ReleaseQueryUGCRequest(QueryHandle);
+
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetSteamResultString(k_EResultFail);
+
+		OnComplete(Result, TArray<FWorkshopItemDetails>(), 0);
+	}
+}
+
+void FSteamWorkshopBackend::DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete)
+{
+	TArray<FOnWorkshopItemDownloaded>& Waiting = PendingDownloads.FindOrAdd(PublishedFileId);
+	Waiting.Add(MoveTemp(OnComplete));
+
+	// Already downloading, the same result completes every caller
+	if (Waiting.Num() > 1)
+		return;
+
+	// High priority moves it to the front of Steam's download queue, an item that's already up to date still sends a result
+	if (!SteamUGC()->DownloadItem(PublishedFileId, true))
+	{
+		FWorkshopResult Result;
+		Result.Code = k_EResultFail;
+		Result.Message = GetSteamResultString(k_EResultFail);
+
+		TArray<FOnWorkshopItemDownloaded> Callbacks = PendingDownloads.FindAndRemoveChecked(PublishedFileId);
+		for (FOnWorkshopItemDownloaded& Callback : Callbacks)
+			Callback(Result, FString());
+	}
+}
+
+void FSteamWorkshopBackend::OnDownloadItemResult(DownloadItemResult_t* pCallback)
+{
+	TArray<FOnWorkshopItemDownloaded> Callbacks;
+	if (!PendingDownloads.RemoveAndCopyValue(pCallback->m_nPublishedFileId, Callbacks))
+		return;
+
+	FWorkshopResult Result;
+	Result.Code = pCallback->m_eResult;
+	Result.bSuccess = pCallback->m_eResult == k_EResultOK;
+	Result.bThrottled = IsThrottledResult(pCallback->m_eResult);
+	Result.Message = GetSteamResultString(pCallback->m_eResult);
+
+	FString InstallFolder;
+
+	if (Result.bSuccess)
+	{
+		uint64 SizeOnDisk = 0;
+		uint32 TimeStamp = 0;
+		char Folder[1024] = { 0 };
+
+		if (SteamUGC()->GetItemInstallInfo(pCallback->m_nPublishedFileId, &SizeOnDisk, Folder, sizeof(Folder), &TimeStamp))
+		{
+			InstallFolder = UTF8_TO_TCHAR(Folder);
+		}
+		else
+		{
+			Result.bSuccess = false;
+			Result.Message = TEXT("The item finished downloading but Steam doesn't know where it was installed.");
+		}
+	}
+
+	for (FOnWorkshopItemDownloaded& Callback : Callbacks)
+		Callback(Result, InstallFolder);
+}
+
+bool FSteamWorkshopBackend::GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const
+{
+	// The quota k_EResultLimitExceeded complains about when an upload doesn't fit
+	return SteamRemoteStorage() != nullptr && SteamRemoteStorage()->GetQuota(&OutTotalBytes, &OutAvailableBytes);
+}
+
+void FSteamWorkshopBackend::ShowLegalAgreement(uint64 PublishedFileId)
+{
+	FString FileUrl = FString::Printf(TEXT("%s%llu"), UTF8_TO_TCHAR(FWorkshopUploaderModule::CommunityFileUrl), PublishedFileId);
+	SteamFriends()->ActivateGameOverlayToWebPage(TCHAR_TO_UTF8(*FileUrl));
+}
+
+/* GetResultString functions */
+
+FString FSteamWorkshopBackend::GetCreateItemResultString(EResult result)
+{
+	switch (result)
+	{
+		case k_EResultOK:
+			return TEXT("k_EResultOK - The operation completed successfully.");
+		case k_EResultInsufficientPrivilege:
+			return TEXT("k_EResultInsufficientPrivilege - You are restricted from uploading due to a hub ban, account lock, or community ban. Contact Steam Support.");
+		case k_EResultBanned:
+			return TEXT("k_EResultBanned - You cannot upload to this hub due to an active VAC or Game ban.");
+		case k_EResultTimeout:
+			return TEXT("k_EResultTimeout - The operation timed out. Please retry the upload.");
+		case k_EResultNotLoggedOn:
+			return TEXT("k_EResultNotLoggedOn - You are not logged into Steam.");
+		case k_EResultServiceUnavailable:
+			return TEXT("k_EResultServiceUnavailable - The Steam Workshop server is currently unavailable. Try again later.");
+		case k_EResultInvalidParam:
+			return TEXT("k_EResultInvalidParam - One or more submission fields are invalid.");
+		case k_EResultAccessDenied:
+			return TEXT("k_EResultAccessDenied - Access denied when saving title and description.");
+		case k_EResultLimitExceeded:
+			return TEXT("k_EResultLimitExceeded - Steam Cloud quota exceeded. Remove items and try again.");
+		case k_EResultFileNotFound:
+			return TEXT("k_EResultFileNotFound - Uploaded file not found.");
+		case k_EResultDuplicateRequest:
+			return TEXT("k_EResultDuplicateRequest - The file was already uploaded successfully. Refresh to see the item.");
+		case k_EResultDuplicateName:
+			return TEXT("k_EResultDuplicateName - You already have a Workshop item with this name.");
+		case k_EResultServiceReadOnly:
+			return TEXT("k_EResultServiceReadOnly - You cannot upload due to a recent password/email change. This restriction usually expires in 5 days.");
+
+		default:
+			return FString::Printf(TEXT("%s - An unhandled error occurred."), *GetSteamResultString(result));
+	}
+}
+
+FString FSteamWorkshopBackend::GetSubmitItemUpdateResultString(EResult result)
+{
+	switch (result)
+	{
+		case k_EResultOK:
+			return TEXT("k_EResultOK - The operation completed successfully.");
+		case k_EResultFail:
+			return TEXT("k_EResultFail - Generic failure.");
+		case k_EResultInvalidParam:
+			return TEXT("k_EResultInvalidParam - Either the app ID is invalid or doesn't match the item's consumer app ID, or ISteamUGC is not enabled for the app ID on the Steam Workshop Configuration page. The preview file may also be smaller than 16 bytes.");
+		case k_EResultAccessDenied:
+			return TEXT("k_EResultAccessDenied - The user doesn't own a license for the provided app ID.");
+		case k_EResultFileNotFound:
+			return TEXT("k_EResultFileNotFound - Failed to get the workshop info or read the preview file. The provided content folder may also be invalid.");
+		case k_EResultLockingFailed:
+			return TEXT("k_EResultLockingFailed - Failed to acquire UGC lock.");
+		case k_EResultLimitExceeded:
+			return TEXT("k_EResultLimitExceeded - The preview image is too large (must be under 1 MB) or the user has exceeded their Steam Cloud quota.");
+
+		default:
+			return FString::Printf(TEXT("%s - An unhandled error occurred."), *GetSteamResultString(result));
+	}
+}
+
+FString FSteamWorkshopBackend::GetSteamResultString(EResult result)
+{
+	switch (result)
+	{
+		case k_EResultOK: return "k_EResultOK";
+		case k_EResultFail: return "k_EResultFail";
+		case k_EResultNoConnection: return "k_EResultNoConnection";
+		case k_EResultInvalidPassword: return "k_EResultInvalidPassword";
+		case k_EResultLoggedInElsewhere: return "k_EResultLoggedInElsewhere";
+		case k_EResultInvalidProtocolVer: return "k_EResultInvalidProtocolVer";
+		case k_EResultInvalidParam: return "k_EResultInvalidParam";
+		case k_EResultFileNotFound: return "k_EResultFileNotFound";
+		case k_EResultBusy: return "k_EResultBusy";
+		case k_EResultInvalidState: return "k_EResultInvalidState";
+		case k_EResultInvalidName: return "k_EResultInvalidName";
+		case k_EResultInvalidEmail: return "k_EResultInvalidEmail";
+		case k_EResultDuplicateName: return "k_EResultDuplicateName";
+		case k_EResultAccessDenied: return "k_EResultAccessDenied";
+		case k_EResultTimeout: return "k_EResultTimeout";
+		case k_EResultBanned: return "k_EResultBanned";
+		case k_EResultAccountNotFound: return "k_EResultAccountNotFound";
+		case k_EResultInvalidSteamID: return "k_EResultInvalidSteamID";
+		case k_EResultServiceUnavailable: return "k_EResultServiceUnavailable";
+		case k_EResultNotLoggedOn: return "k_EResultNotLoggedOn";
+		case k_EResultPending: return "k_EResultPending";
+		case k_EResultEncryptionFailure: return "k_EResultEncryptionFailure";
+		case k_EResultInsufficientPrivilege: return "k_EResultInsufficientPrivilege";
+		case k_EResultLimitExceeded: return "k_EResultLimitExceeded";
+		case k_EResultRevoked: return "k_EResultRevoked";
+		case k_EResultExpired: return "k_EResultExpired";
+		case k_EResultAlreadyRedeemed: return "k_EResultAlreadyRedeemed";
+		case k_EResultDuplicateRequest: return "k_EResultDuplicateRequest";
+		case k_EResultAlreadyOwned: return "k_EResultAlreadyOwned";
+		case k_EResultIPNotFound: return "k_EResultIPNotFound";
+		case k_EResultPersistFailed: return "k_EResultPersistFailed";
+		case k_EResultLockingFailed: return "k_EResultLockingFailed";
+		case k_EResultLogonSessionReplaced: return "k_EResultLogonSessionReplaced";
+		case k_EResultConnectFailed: return "k_EResultConnectFailed";
+		case k_EResultHandshakeFailed: return "k_EResultHandshakeFailed";
+		case k_EResultIOFailure: return "k_EResultIOFailure";
+		case k_EResultRemoteDisconnect: return "k_EResultRemoteDisconnect";
+		case k_EResultShoppingCartNotFound: return "k_EResultShoppingCartNotFound";
+		case k_EResultBlocked: return "k_EResultBlocked";
+		case k_EResultIgnored: return "k_EResultIgnored";
+		case k_EResultNoMatch: return "k_EResultNoMatch";
+		case k_EResultAccountDisabled: return "k_EResultAccountDisabled";
+		case k_EResultServiceReadOnly: return "k_EResultServiceReadOnly";
+		case k_EResultAccountNotFeatured: return "k_EResultAccountNotFeatured";
+		case k_EResultAdministratorOK: return "k_EResultAdministratorOK";
+		case k_EResultContentVersion: return "k_EResultContentVersion";
+		case k_EResultTryAnotherCM: return "k_EResultTryAnotherCM";
+		case k_EResultPasswordRequiredToKickSession: return "k_EResultPasswordRequiredToKickSession";
+		case k_EResultAlreadyLoggedInElsewhere: return "k_EResultAlreadyLoggedInElsewhere";
+		case k_EResultSuspended: return "k_EResultSuspended";
+		case k_EResultCancelled: return "k_EResultCancelled";
+		case k_EResultDataCorruption: return "k_EResultDataCorruption";
+		case k_EResultDiskFull: return "k_EResultDiskFull";
+		case k_EResultRemoteCallFailed: return "k_EResultRemoteCallFailed";
+		case k_EResultPasswordUnset: return "k_EResultPasswordUnset";
+		case k_EResultExternalAccountUnlinked: return "k_EResultExternalAccountUnlinked";
+		case k_EResultPSNTicketInvalid: return "k_EResultPSNTicketInvalid";
+		case k_EResultExternalAccountAlreadyLinked: return "k_EResultExternalAccountAlreadyLinked";
+		case k_EResultRemoteFileConflict: return "k_EResultRemoteFileConflict";
+		case k_EResultIllegalPassword: return "k_EResultIllegalPassword";
+		case k_EResultSameAsPreviousValue: return "k_EResultSameAsPreviousValue";
+		case k_EResultAccountLogonDenied: return "k_EResultAccountLogonDenied";
+		case k_EResultCannotUseOldPassword: return "k_EResultCannotUseOldPassword";
+		case k_EResultInvalidLoginAuthCode: return "k_EResultInvalidLoginAuthCode";
+		case k_EResultAccountLogonDeniedNoMail: return "k_EResultAccountLogonDeniedNoMail";
+		case k_EResultHardwareNotCapableOfIPT: return "k_EResultHardwareNotCapableOfIPT";
+		case k_EResultIPTInitError: return "k_EResultIPTInitError";
+		case k_EResultParentalControlRestricted: return "k_EResultParentalControlRestricted";
+		case k_EResultFacebookQueryError: return "k_EResultFacebookQueryError";
+		case k_EResultExpiredLoginAuthCode: return "k_EResultExpiredLoginAuthCode";
+		case k_EResultIPLoginRestrictionFailed: return "k_EResultIPLoginRestrictionFailed";
+		case k_EResultAccountLockedDown: return "k_EResultAccountLockedDown";
+		case k_EResultAccountLogonDeniedVerifiedEmailRequired: return "k_EResultAccountLogonDeniedVerifiedEmailRequired";
+		case k_EResultNoMatchingURL: return "k_EResultNoMatchingURL";
+		case k_EResultBadResponse: return "k_EResultBadResponse";
+		case k_EResultRequirePasswordReEntry: return "k_EResultRequirePasswordReEntry";
+		case k_EResultValueOutOfRange: return "k_EResultValueOutOfRange";
+		case k_EResultUnexpectedError: return "k_EResultUnexpectedError";
+		case k_EResultDisabled: return "k_EResultDisabled";
+		case k_EResultInvalidCEGSubmission: return "k_EResultInvalidCEGSubmission";
+		case k_EResultRestrictedDevice: return "k_EResultRestrictedDevice";
+		case k_EResultRegionLocked: return "k_EResultRegionLocked";
+		case k_EResultRateLimitExceeded: return "k_EResultRateLimitExceeded";
+		case k_EResultAccountLoginDeniedNeedTwoFactor: return "k_EResultAccountLoginDeniedNeedTwoFactor";
+		case k_EResultItemDeleted: return "k_EResultItemDeleted";
+		case k_EResultAccountLoginDeniedThrottle: return "k_EResultAccountLoginDeniedThrottle";
+		case k_EResultTwoFactorCodeMismatch: return "k_EResultTwoFactorCodeMismatch";
+		case k_EResultTwoFactorActivationCodeMismatch: return "k_EResultTwoFactorActivationCodeMismatch";
+		case k_EResultAccountAssociatedToMultiplePartners: return "k_EResultAccountAssociatedToMultiplePartners";
+		case k_EResultNotModified: return "k_EResultNotModified";
+		case k_EResultNoMobileDevice: return "k_EResultNoMobileDevice";
+		case k_EResultTimeNotSynced: return "k_EResultTimeNotSynced";
+		case k_EResultSmsCodeFailed: return "k_EResultSmsCodeFailed";
+		case k_EResultAccountLimitExceeded: return "k_EResultAccountLimitExceeded";
+		case k_EResultAccountActivityLimitExceeded: return "k_EResultAccountActivityLimitExceeded";
+		case k_EResultPhoneActivityLimitExceeded: return "k_EResultPhoneActivityLimitExceeded";
+		case k_EResultRefundToWallet: return "k_EResultRefundToWallet";
+		case k_EResultEmailSendFailure: return "k_EResultEmailSendFailure";
+		case k_EResultNotSettled: return "k_EResultNotSettled";
+		case k_EResultNeedCaptcha: return "k_EResultNeedCaptcha";
+		case k_EResultGSLTDenied: return "k_EResultGSLTDenied";
+		case k_EResultGSOwnerDenied: return "k_EResultGSOwnerDenied";
+		case k_EResultInvalidItemType: return "k_EResultInvalidItemType";
+		case k_EResultIPBanned: return "k_EResultIPBanned";
+		case k_EResultGSLTExpired: return "k_EResultGSLTExpired";
+		
+		default: return "Unknown Result";
+	}
+}
+
+bool FSteamWorkshopBackend::IsThrottledResult(EResult result)
+{
+	switch (result)
+	{
+		// k_EResultLimitExceeded isn't one, it's a full Steam Cloud quota or an oversized preview and fails the same way every time
+		case k_EResultBusy:
+		case k_EResultRateLimitExceeded:
+		case k_EResultServiceUnavailable:
+			return true;
+
+		default: return false;
+	}
+}
+
+#endif // WITH_STEAM_WORKSHOP
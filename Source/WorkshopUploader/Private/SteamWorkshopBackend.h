@@ -0,0 +1,120 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+#if WITH_STEAM_WORKSHOP
+
+#pragma region SteamInclude
+// @todo Steam: Steam headers trigger secure-C-runtime warnings in Visual C++. Rather than mess with _CRT_SECURE_NO_WARNINGS, we'll just
+//	disable the warnings locally. Remove when this is fixed in the SDK
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4996)
+// #TODO check back on this at some point
+#pragma warning(disable:4265) // SteamAPI CCallback< specifically, this warning is off by default but 4.17 turned it on....
+#endif
+
+#pragma push_macro("ARRAY_COUNT")
+#undef ARRAY_COUNT
+
+#if USING_CODE_ANALYSIS
+MSVC_PRAGMA(warning(push))
+MSVC_PRAGMA(warning(disable : ALL_CODE_ANALYSIS_WARNINGS))
+#endif	// USING_CODE_ANALYSIS
+
+#include <steam/steam_api.h>
+
+#if USING_CODE_ANALYSIS
+MSVC_PRAGMA(warning(pop))
+#endif	// USING_CODE_ANALYSIS
+
+#pragma pop_macro("ARRAY_COUNT")
+
+// @todo Steam: See above
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#pragma endregion SteamInclude
+
+class FSteamWorkshopBackend : public IWorkshopBackend
+{
+public:
+
+	/* IWorkshopBackend implementation */
+	virtual bool IsAvailable() const override;
+	virtual bool TryInitialize() override;
+	virtual uint32 GetAppId() const override;
+	virtual void Tick() override;
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override;
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override;
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override;
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override;
+
+	/* SteamAPI result strings */
+	static FString GetSteamResultString(EResult result);
+	static FString GetCreateItemResultString(EResult result);
+	static FString GetSubmitItemUpdateResultString(EResult result);
+
+	/* Results Steam sends back when it wants calls to slow down, the call can be made again later */
+	static bool IsThrottledResult(EResult result);
+
+private:
+
+	/* Sends a UGC query and reads every result out of it, the query handle is always released */
+	void SendQuery(UGCQueryHandle_t QueryHandle, TFunction<void(const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items, uint32 TotalMatchingResults)> OnComplete);
+
+	/* Pages through the user's published items until TotalMatchingResults have been collected */
+	void QueryPublishedPage(uint32 ConsumerAppId, uint32 Page, TSharedRef<TArray<FWorkshopItemDetails>> Items, FOnWorkshopItemsQueried OnComplete);
+
+	struct FPendingCall
+	{
+		virtual ~FPendingCall() {}
+		bool bCompleted = false;
+	};
+
+	/* Each call gets its own CCallResult so overlapping calls can't re-bind each other's results */
+	template<typename CallbackType>
+	struct TPendingCall : public FPendingCall
+	{
+		CCallResult<TPendingCall<CallbackType>, CallbackType> CallResult;
+		TFunction<void(CallbackType*, bool)> OnComplete;
+
+		void OnResult(CallbackType* pCallback, bool bIOFailure)
+		{
+			bCompleted = true;
+			OnComplete(pCallback, bIOFailure);
+		}
+	};
+
+	/* Binds a call handle to a completion function, returns false if the call couldn't be made */
+	template<typename CallbackType>
+	bool TrackCall(SteamAPICall_t hSteamAPICall, TFunction<void(CallbackType*, bool)>&& OnComplete)
+	{
+		if (hSteamAPICall == k_uAPICallInvalid)
+			return false;
+
+		TUniquePtr<TPendingCall<CallbackType>> Call = MakeUnique<TPendingCall<CallbackType>>();
+		Call->OnComplete = MoveTemp(OnComplete);
+		Call->CallResult.Set(hSteamAPICall, Call.Get(), &TPendingCall<CallbackType>::OnResult);
+
+		PendingCalls.Add(MoveTemp(Call));
+		return true;
+	}
+
+	/* Completed calls are only released from Tick, never from inside their own callback */
+	TArray<TUniquePtr<FPendingCall>> PendingCalls;
+
+	/* DownloadItem reports back through a broadcast callback rather than a call result, so downloads wait here by item */
+	TMap<PublishedFileId_t, TArray<FOnWorkshopItemDownloaded>> PendingDownloads;
+	STEAM_CALLBACK(FSteamWorkshopBackend, OnDownloadItemResult, DownloadItemResult_t);
+};
+
+#endif // WITH_STEAM_WORKSHOP
@@ -0,0 +1,534 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "WorkshopBackend.h"
+#include "WorkshopBackendTrace.h"
+#include "WorkshopCallScheduler.h"
+#include "WorkshopContentManifest.h"
+#include "WorkshopSharedContent.h"
+#include "LocalWorkshopBackend.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* Results come back from Tick, a call that's still outstanding after this long has been lost */
+static const double WorkshopTestTimeoutSeconds = 5.0;
+
+static bool TickUntil(IWorkshopBackend& Backend, TFunctionRef<bool()> IsDone)
+{
+	const double GiveUpTime = FPlatformTime::Seconds() + WorkshopTestTimeoutSeconds;
+
+	while (!IsDone() && FPlatformTime::Seconds() < GiveUpTime)
+		Backend.Tick();
+
+	return IsDone();
+}
+
+/* One of the traces in Resources/WorkshopTraces behind the scheduler, the way -WorkshopReplay sets it up, with every result handed out on the next tick */
+static TSharedRef<FWorkshopCallScheduler> MakeReplayScheduler(const FString& Trace)
+{
+	FWorkshopReplaySettings Settings;
+	Settings.Speed = 0.0f;
+
+	return MakeShared<FWorkshopCallScheduler>(MakeShared<FWorkshopReplayBackend>(FWorkshopReplayBackend::FindTrace(Trace), Settings));
+}
+
+static FWorkshopItemUpdate MakeContentUpdate(uint64 PublishedFileId, const FString& ContentFolder)
+{
+	FWorkshopItemUpdate Update;
+	Update.PublishedFileId = PublishedFileId;
+	Update.ContentFolder = ContentFolder;
+	Update.ChangeNote = TEXT("Updated.");
+	return Update;
+}
+
+/* Answers updates on the next tick, throttling as many as it's told to first. Everything else fails */
+class FThrottlingWorkshopBackend : public IWorkshopBackend
+{
+public:
+
+	/* Updates still to be throttled before they get through, below zero throttles every one */
+	int32 NumToThrottle = 0;
+
+	int32 NumUpdates = 0;
+
+	/* Called as each update arrives, before it's answered */
+	TFunction<void()> OnUpdate;
+
+	virtual bool IsAvailable() const override { return true; }
+	virtual bool TryInitialize() override { return true; }
+	virtual uint32 GetAppId() const override { return 480; }
+
+	virtual void Tick() override
+	{
+		TArray<TFunction<void()>> Answers = MoveTemp(PendingAnswers);
+
+		for (const TFunction<void()>& Answer : Answers)
+			Answer();
+	}
+
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult(), 0, false); });
+	}
+
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override
+	{
+		++NumUpdates;
+		if (OnUpdate)
+			OnUpdate();
+
+		FWorkshopResult Result;
+
+		if (NumToThrottle != 0)
+		{
+			NumToThrottle = FMath::Max(NumToThrottle - 1, -1);
+			Result.bThrottled = true;
+			Result.Code = 84;
+			Result.Message = TEXT("k_EResultRateLimitExceeded");
+		}
+		else
+		{
+			Result.bSuccess = true;
+			Result.Code = 1;
+		}
+
+		PendingAnswers.Add([OnComplete, Result]() { OnComplete(Result, false); });
+	}
+
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult()); });
+	}
+
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult()); });
+	}
+
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult(), TArray<FWorkshopItemDetails>()); });
+	}
+
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult(), TArray<FWorkshopItemDetails>()); });
+	}
+
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override
+	{
+		PendingAnswers.Add([OnComplete]() { OnComplete(FWorkshopResult(), FString()); });
+	}
+
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override { return false; }
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override {}
+
+private:
+
+	TArray<TFunction<void()>> PendingAnswers;
+};
+
+/* Submits the update and ticks until its result is back, false if it never came */
+static bool SubmitAndWait(IWorkshopBackend& Backend, const FWorkshopItemUpdate& Update, FWorkshopResult& OutResult)
+{
+	bool bDone = false;
+
+	Backend.SubmitItemUpdate(Update, [&bDone, &OutResult](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		OutResult = Result;
+		bDone = true;
+	});
+
+	return TickUntil(Backend, [&bDone]() { return bDone; });
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkshopReplaySuccessTest, "Plugins.WorkshopUploader.Replay.Success", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWorkshopReplaySuccessTest::RunTest(const FString& Parameters)
+{
+	TSharedRef<FWorkshopCallScheduler> Scheduler = MakeReplayScheduler(TEXT("Success"));
+	if (!TestTrue(TEXT("The Success trace loads"), Scheduler->IsAvailable()))
+		return false;
+
+	TestEqual(TEXT("App ID"), Scheduler->GetAppId(), 480u);
+
+	uint64 TotalBytes = 0, AvailableBytes = 0;
+	TestTrue(TEXT("Quota is recorded"), Scheduler->GetStorageQuota(TotalBytes, AvailableBytes));
+	TestEqual(TEXT("Available quota"), AvailableBytes, (uint64)968884224);
+
+	bool bCreated = false;
+	FWorkshopResult CreateResult;
+	uint64 NewItemId = 0;
+
+	Scheduler->CreateItem(480, [&](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+	{
+		CreateResult = Result;
+		NewItemId = PublishedFileId;
+		bCreated = true;
+	});
+
+	if (!TestTrue(TEXT("CreateItem completes"), TickUntil(*Scheduler, [&bCreated]() { return bCreated; })))
+		return false;
+
+	TestTrue(TEXT("CreateItem succeeds"), CreateResult.bSuccess);
+	TestEqual(TEXT("Created item"), NewItemId, (uint64)2913374501);
+
+	// Both uploads go out together and are answered in whichever order they finish
+	int32 NumSubmitted = 0;
+	int32 NumSucceeded = 0;
+
+	for (const uint64 PublishedFileId : { NewItemId, (uint64)2913374488 })
+	{
+		Scheduler->SubmitItemUpdate(MakeContentUpdate(PublishedFileId, FPaths::ProjectSavedDir()), [&NumSubmitted, &NumSucceeded](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			++NumSubmitted;
+			NumSucceeded += Result.bSuccess ? 1 : 0;
+		});
+	}
+
+	if (!TestTrue(TEXT("Both updates complete"), TickUntil(*Scheduler, [&NumSubmitted]() { return NumSubmitted == 2; })))
+		return false;
+
+	TestEqual(TEXT("Updates that succeed"), NumSucceeded, 2);
+
+	bool bQueried = false;
+	TArray<FWorkshopItemDetails> QueriedItems;
+
+	Scheduler->QueryItemDetails({ NewItemId, (uint64)2913374488 }, [&bQueried, &QueriedItems](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+	{
+		QueriedItems = Items;
+		bQueried = Result.bSuccess;
+	});
+
+	TestTrue(TEXT("QueryItemDetails succeeds"), TickUntil(*Scheduler, [&bQueried]() { return bQueried; }));
+
+	if (TestEqual(TEXT("Items queried"), QueriedItems.Num(), 2))
+	{
+		TestEqual(TEXT("First item"), QueriedItems[0].Title, FString(TEXT("Neon Rifles")));
+		TestEqual(TEXT("Second item"), QueriedItems[1].Title, FString(TEXT("Desert Outpost")));
+	}
+
+	const FWorkshopCallStats& SubmitStats = Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate);
+	TestEqual(TEXT("Updates sent"), SubmitStats.NumSent, 2);
+	TestEqual(TEXT("Updates throttled"), SubmitStats.NumThrottled, 0);
+	TestFalse(TEXT("Nothing is left queued"), Scheduler->IsBusy());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkshopReplayTimeoutTest, "Plugins.WorkshopUploader.Replay.Timeout", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWorkshopReplayTimeoutTest::RunTest(const FString& Parameters)
+{
+	TSharedRef<FWorkshopCallScheduler> Scheduler = MakeReplayScheduler(TEXT("Timeout"));
+	if (!TestTrue(TEXT("The Timeout trace loads"), Scheduler->IsAvailable()))
+		return false;
+
+	bool bCreated = false;
+	uint64 NewItemId = 0;
+
+	Scheduler->CreateItem(480, [&bCreated, &NewItemId](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+	{
+		NewItemId = Result.bSuccess ? PublishedFileId : 0;
+		bCreated = true;
+	});
+
+	if (!TestTrue(TEXT("CreateItem completes"), TickUntil(*Scheduler, [&bCreated]() { return bCreated; })))
+		return false;
+
+	TestEqual(TEXT("Created item"), NewItemId, (uint64)2913374523);
+
+	// The upload timed out, the retry lost its connection and recording stopped before the third attempt came back
+	const FWorkshopItemUpdate Update = MakeContentUpdate(NewItemId, FPaths::ProjectSavedDir());
+	FWorkshopResult Result;
+
+	if (TestTrue(TEXT("First attempt completes"), SubmitAndWait(*Scheduler, Update, Result)))
+	{
+		TestFalse(TEXT("First attempt fails"), Result.bSuccess);
+		TestFalse(TEXT("First attempt isn't an IO failure"), Result.bIOFailure);
+		TestEqual(TEXT("First attempt's result"), Result.Code, 16);
+	}
+
+	if (TestTrue(TEXT("Second attempt completes"), SubmitAndWait(*Scheduler, Update, Result)))
+	{
+		TestFalse(TEXT("Second attempt fails"), Result.bSuccess);
+		TestTrue(TEXT("Second attempt is an IO failure"), Result.bIOFailure);
+		TestEqual(TEXT("Second attempt's result"), Result.Code, 15);
+	}
+
+	if (TestTrue(TEXT("Third attempt completes"), SubmitAndWait(*Scheduler, Update, Result)))
+	{
+		TestFalse(TEXT("Third attempt fails"), Result.bSuccess);
+		TestTrue(TEXT("A call with no recorded result is an IO failure"), Result.bIOFailure);
+	}
+
+	// Timeouts aren't throttling, each attempt went out exactly once
+	const FWorkshopCallStats& SubmitStats = Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate);
+	TestEqual(TEXT("Updates sent"), SubmitStats.NumSent, 3);
+	TestEqual(TEXT("Updates throttled"), SubmitStats.NumThrottled, 0);
+	TestFalse(TEXT("Nothing is left queued"), Scheduler->IsBusy());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkshopReplayQuotaExceededTest, "Plugins.WorkshopUploader.Replay.QuotaExceeded", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWorkshopReplayQuotaExceededTest::RunTest(const FString& Parameters)
+{
+	TSharedRef<FWorkshopCallScheduler> Scheduler = MakeReplayScheduler(TEXT("QuotaExceeded"));
+	if (!TestTrue(TEXT("The QuotaExceeded trace loads"), Scheduler->IsAvailable()))
+		return false;
+
+	uint64 TotalBytes = 0, AvailableBytes = 0;
+	TestTrue(TEXT("Quota is recorded"), Scheduler->GetStorageQuota(TotalBytes, AvailableBytes));
+	TestEqual(TEXT("Available quota"), AvailableBytes, (uint64)2097152);
+
+	FWorkshopResult Result;
+
+	if (!TestTrue(TEXT("The update completes"), SubmitAndWait(*Scheduler, MakeContentUpdate(2913374488, FPaths::ProjectSavedDir()), Result)))
+		return false;
+
+	TestFalse(TEXT("The update fails"), Result.bSuccess);
+	TestFalse(TEXT("The update isn't throttled"), Result.bThrottled);
+	TestEqual(TEXT("The update's result"), Result.Code, 25);
+
+	// k_EResultLimitExceeded won't go away by waiting, so it's passed straight on instead of being retried
+	const FWorkshopCallStats& SubmitStats = Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate);
+	TestEqual(TEXT("Updates sent"), SubmitStats.NumSent, 1);
+	TestEqual(TEXT("Updates throttled"), SubmitStats.NumThrottled, 0);
+	TestFalse(TEXT("Nothing is left queued"), Scheduler->IsBusy());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkshopSchedulerThrottlingTest, "Plugins.WorkshopUploader.Scheduler.Throttling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWorkshopSchedulerThrottlingTest::RunTest(const FString& Parameters)
+{
+	// Fast enough that waiting for tokens doesn't slow the test down, with round numbers to back off from
+	FWorkshopCallSchedulerSettings Settings;
+	Settings.Limits[(int32)EWorkshopCallType::SubmitItemUpdate] = { 6000.0f, 1.0f, 600.0f };
+	Settings.MaxRetries = 3;
+	Settings.ThrottleBackoff = 0.5f;
+	Settings.RecoveryStep = 0.25f;
+
+	TSharedRef<FThrottlingWorkshopBackend> Throttling = MakeShared<FThrottlingWorkshopBackend>();
+	TSharedRef<FWorkshopCallScheduler> Scheduler = MakeShared<FWorkshopCallScheduler>(Throttling, Settings);
+
+	// The rate each attempt went out at
+	TArray<float> SentRates;
+	FWorkshopCallScheduler& SchedulerRef = *Scheduler;
+
+	Throttling->OnUpdate = [&SentRates, &SchedulerRef]()
+	{
+		SentRates.Add(SchedulerRef.GetStats(EWorkshopCallType::SubmitItemUpdate).CallsPerMinute);
+	};
+
+	Throttling->NumToThrottle = -1;
+	FWorkshopResult Result;
+
+	if (!TestTrue(TEXT("The throttled update completes"), SubmitAndWait(*Scheduler, MakeContentUpdate(2913374488, FPaths::ProjectSavedDir()), Result)))
+		return false;
+
+	TestTrue(TEXT("The update is passed on as throttled"), Result.bThrottled);
+	TestEqual(TEXT("Attempts"), Throttling->NumUpdates, Settings.MaxRetries + 1);
+
+	if (TestEqual(TEXT("Rates recorded"), SentRates.Num(), Settings.MaxRetries + 1))
+	{
+		TestEqual(TEXT("First attempt's rate"), SentRates[0], 6000.0f, 0.01f);
+		TestEqual(TEXT("Second attempt's rate"), SentRates[1], 3000.0f, 0.01f);
+		TestEqual(TEXT("Third attempt's rate"), SentRates[2], 1500.0f, 0.01f);
+		TestEqual(TEXT("Fourth attempt's rate"), SentRates[3], 750.0f, 0.01f);
+	}
+
+	TestEqual(TEXT("Backing off stops at the minimum"), Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate).CallsPerMinute, 600.0f, 0.01f);
+
+	// Every update that gets through wins back a quarter of the limit
+	Throttling->NumToThrottle = 0;
+	SentRates.Reset();
+
+	for (const float ExpectedRate : { 2100.0f, 3600.0f, 5100.0f, 6000.0f })
+	{
+		if (!TestTrue(TEXT("The update completes"), SubmitAndWait(*Scheduler, MakeContentUpdate(2913374488, FPaths::ProjectSavedDir()), Result)))
+			return false;
+
+		TestTrue(TEXT("The update succeeds"), Result.bSuccess);
+		TestEqual(TEXT("Rate after the update"), Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate).CallsPerMinute, ExpectedRate, 0.01f);
+	}
+
+	TestEqual(TEXT("Each update went out once"), SentRates.Num(), 4);
+
+	const FWorkshopCallStats& SubmitStats = Scheduler->GetStats(EWorkshopCallType::SubmitItemUpdate);
+	TestEqual(TEXT("Updates sent"), SubmitStats.NumSent, Settings.MaxRetries + 5);
+	TestEqual(TEXT("Updates throttled"), SubmitStats.NumThrottled, Settings.MaxRetries + 1);
+	TestFalse(TEXT("Nothing is left queued"), Scheduler->IsBusy());
+
+	Throttling->OnUpdate = nullptr;
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocalWorkshopBackendTest, "Plugins.WorkshopUploader.LocalWorkshop", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLocalWorkshopBackendTest::RunTest(const FString& Parameters)
+{
+	const FString ContentFolder = FPaths::ProjectIntermediateDir() / TEXT("WorkshopUploaderTests") / TEXT("Content");
+	const FString ContentFile = TEXT("Paks/TestMod.pak");
+	const FString ContentText = TEXT("Not really a pak.");
+
+	if (!TestTrue(TEXT("Test content is written"), FFileHelper::SaveStringToFile(ContentText, *(ContentFolder / ContentFile))))
+		return false;
+
+	TSharedRef<FWorkshopCallScheduler> Scheduler = MakeShared<FWorkshopCallScheduler>(MakeShared<FLocalWorkshopBackend>());
+
+	bool bCreated = false;
+	uint64 ItemId = 0;
+
+	Scheduler->CreateItem(FLocalWorkshopBackend::LocalAppId, [&bCreated, &ItemId](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+	{
+		ItemId = Result.bSuccess ? PublishedFileId : 0;
+		bCreated = true;
+	});
+
+	TestTrue(TEXT("CreateItem completes"), TickUntil(*Scheduler, [&bCreated]() { return bCreated; }));
+
+	if (TestNotEqual(TEXT("An item is created"), ItemId, (uint64)0))
+	{
+		FWorkshopItemUpdate Update = MakeContentUpdate(ItemId, ContentFolder);
+		Update.Title = TEXT("Test Mod");
+		Update.Tags = TArray<FString>({ TEXT("Mod") });
+
+		FWorkshopResult Result;
+		TestTrue(TEXT("The update completes"), SubmitAndWait(*Scheduler, Update, Result));
+		TestTrue(TEXT("The update succeeds"), Result.bSuccess);
+
+		bool bQueried = false;
+		TArray<FWorkshopItemDetails> QueriedItems;
+
+		Scheduler->QueryItemDetails({ ItemId }, [&bQueried, &QueriedItems](const FWorkshopResult& QueryResult, const TArray<FWorkshopItemDetails>& Items)
+		{
+			QueriedItems = Items;
+			bQueried = true;
+		});
+
+		TestTrue(TEXT("QueryItemDetails completes"), TickUntil(*Scheduler, [&bQueried]() { return bQueried; }));
+
+		if (TestEqual(TEXT("Items queried"), QueriedItems.Num(), 1))
+		{
+			TestEqual(TEXT("Title"), QueriedItems[0].Title, FString(TEXT("Test Mod")));
+			TestEqual(TEXT("Tags"), QueriedItems[0].Tags, TArray<FString>({ TEXT("Mod") }));
+		}
+
+		// What's downloaded is what verifying an upload compares against
+		bool bDownloaded = false;
+		FString InstallFolder;
+
+		Scheduler->DownloadItem(ItemId, [&bDownloaded, &InstallFolder](const FWorkshopResult& DownloadResult, const FString& Folder)
+		{
+			InstallFolder = DownloadResult.bSuccess ? Folder : FString();
+			bDownloaded = true;
+		});
+
+		TestTrue(TEXT("DownloadItem completes"), TickUntil(*Scheduler, [&bDownloaded]() { return bDownloaded; }));
+
+		FString DownloadedText;
+		TestTrue(TEXT("The uploaded file is downloaded"), !InstallFolder.IsEmpty() && FFileHelper::LoadFileToString(DownloadedText, *(InstallFolder / ContentFile)));
+		TestEqual(TEXT("Downloaded content"), DownloadedText, ContentText);
+
+		// Checked the way a published item is verified, by comparing the manifests of what was submitted and what came down
+		if (!InstallFolder.IsEmpty())
+		{
+			const FWorkshopContentManifest Expected = FWorkshopContentManifest::Build(ContentFolder);
+			TestEqual(TEXT("Files submitted"), Expected.Files.Num(), 1);
+
+			const FWorkshopManifestDiff Diff = FWorkshopManifestDiff::Compare(Expected, FWorkshopContentManifest::Build(InstallFolder));
+			TestTrue(FString::Printf(TEXT("The download matches what was submitted: %s"), *Diff.Describe()), Diff.IsEmpty());
+
+			// Same size, so only the hash gives it away
+			TestTrue(TEXT("The downloaded file is tampered with"), FFileHelper::SaveStringToFile(TEXT("Not really a paK."), *(InstallFolder / ContentFile)));
+
+			const FWorkshopManifestDiff TamperedDiff = FWorkshopManifestDiff::Compare(Expected, FWorkshopContentManifest::Build(InstallFolder));
+			TestEqual(TEXT("Files reported as changed"), TamperedDiff.Changed, TArray<FString>({ ContentFile }));
+			TestEqual(TEXT("Files reported as missing"), TamperedDiff.Missing.Num(), 0);
+			TestEqual(TEXT("Files reported as unexpected"), TamperedDiff.Unexpected.Num(), 0);
+		}
+
+		IFileManager::Get().DeleteDirectory(*FLocalWorkshopBackend::GetItemDir(ItemId), false, true);
+	}
+
+	IFileManager::Get().DeleteDirectory(*FPaths::GetPath(ContentFolder), false, true);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorkshopSharedContentAppCopiesTest, "Plugins.WorkshopUploader.SharedContent.AppCopies", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWorkshopSharedContentAppCopiesTest::RunTest(const FString& Parameters)
+{
+	const FString Package = TEXT("WorkshopUploaderTestMod");
+	const FString StagedBuildsDir = FPaths::ProjectIntermediateDir() / TEXT("WorkshopUploaderTests") / TEXT("StagedBuilds");
+	const FString SharedFile = TEXT("Paks/Shared.pak");
+	const FString OwnFile = TEXT("Paks/TestMod.pak");
+
+	if (!TestTrue(TEXT("Test content is written"), FFileHelper::SaveStringToFile(TEXT("Shared content."), *(StagedBuildsDir / SharedFile)) && FFileHelper::SaveStringToFile(TEXT("The mod's own content."), *(StagedBuildsDir / OwnFile))))
+		return false;
+
+	FWorkshopManifestFile SharedManifestFile;
+	TestTrue(TEXT("The shared file is hashed"), FWorkshopContentManifest::BuildFile(StagedBuildsDir / SharedFile, SharedManifestFile));
+
+	// A plan whose shared item has been published, for a mod that's also published to a second app
+	FWorkshopSharedItem Item;
+	Item.PublishedFileId = 2913374488;
+	Item.bPublished = true;
+
+	FWorkshopSharedFile File;
+	File.Path = SharedFile;
+	File.Hash = SharedManifestFile.Hash;
+	File.Size = SharedManifestFile.Size;
+	File.Packages = TArray<FString>({ Package, TEXT("OtherMod") });
+
+	FWorkshopSharedContentPlan Plan;
+	Plan.Items.Add(Item);
+	Plan.Packages.Add(Package);
+	Plan.Files.Add(File);
+
+	FWorkshopItemUpdate Update = MakeContentUpdate(2913374489, StagedBuildsDir);
+	Update.ConsumerAppId = 480;
+	Update.AdditionalAppIds.Add(481);
+
+	TestTrue(TEXT("The mod is staged without its shared files"), FWorkshopSharedContent::StageDependent(Plan, Package, StagedBuildsDir));
+
+	TArray<uint32> AppIds = Update.AdditionalAppIds;
+	AppIds.Insert(Update.ConsumerAppId, 0);
+
+	// The shared item is in the draft's own app, its copy in another app can't depend on it
+	for (uint32 AppId : AppIds)
+	{
+		const FString ContentDir = Plan.GetDependentContentDir(Package, StagedBuildsDir, AppId == Update.ConsumerAppId);
+		const bool bHasSharedFile = FPaths::FileExists(ContentDir / SharedFile);
+
+		TestTrue(FString::Printf(TEXT("App %u gets the mod's own files"), AppId), FPaths::FileExists(ContentDir / OwnFile));
+
+		if (AppId == Update.ConsumerAppId)
+			TestFalse(FString::Printf(TEXT("App %u depends on the shared item for the shared files"), AppId), bHasSharedFile);
+		else
+			TestTrue(FString::Printf(TEXT("App %u gets the shared files"), AppId), bHasSharedFile);
+	}
+
+	// Until the shared item has the files, every app gets the whole build
+	Plan.Items[0].bPublished = false;
+	TestEqual(TEXT("Content of a mod whose shared item isn't published"), Plan.GetDependentContentDir(Package, StagedBuildsDir, true), StagedBuildsDir);
+
+	IFileManager::Get().DeleteDirectory(*FWorkshopSharedContentPlan::GetStagingDir(Package), false, true);
+	IFileManager::Get().Delete(*FWorkshopContentManifest::GetCachedManifestPath(StagedBuildsDir));
+	IFileManager::Get().DeleteDirectory(*FPaths::GetPath(StagedBuildsDir), false, true);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,110 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopBackend.h"
+#include "SteamWorkshopBackend.h"
+#include "LocalWorkshopBackend.h"
+#include "WorkshopBackendTrace.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+/* Used where the Steam SDK isn't available, every call fails straight away */
+class FNullWorkshopBackend : public IWorkshopBackend
+{
+public:
+
+	virtual bool IsAvailable() const override { return false; }
+	virtual bool TryInitialize() override { return false; }
+	virtual uint32 GetAppId() const override { return 0; }
+	virtual void Tick() override {}
+
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult(), 0, false);
+	}
+
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult(), false);
+	}
+
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult());
+	}
+
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult());
+	}
+
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult(), TArray<FWorkshopItemDetails>());
+	}
+
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult(), TArray<FWorkshopItemDetails>());
+	}
+
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override
+	{
+		OnComplete(MakeUnavailableResult(), FString());
+	}
+
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override { return false; }
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override {}
+
+private:
+
+	static FWorkshopResult MakeUnavailableResult()
+	{
+		FWorkshopResult Result;
+		Result.Message = TEXT("The Steam Workshop isn't available on this platform.");
+		return Result;
+	}
+};
+
+static TSharedRef<IWorkshopBackend> CreatePlatformBackend()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString TracePath;
+	if (FParse::Value(CommandLine, TEXT("WorkshopReplay="), TracePath))
+	{
+		FWorkshopReplaySettings Settings;
+		FParse::Value(CommandLine, TEXT("WorkshopReplaySpeed="), Settings.Speed);
+		FParse::Value(CommandLine, TEXT("WorkshopReplayJitter="), Settings.JitterSeconds);
+		FParse::Value(CommandLine, TEXT("WorkshopReplaySeed="), Settings.Seed);
+
+		return MakeShared<FWorkshopReplayBackend>(FWorkshopReplayBackend::FindTrace(TracePath), Settings);
+	}
+
+	if (FParse::Param(CommandLine, TEXT("LocalWorkshop")))
+		return MakeShared<FLocalWorkshopBackend>();
+
+#if WITH_STEAM_WORKSHOP
+	return MakeShared<FSteamWorkshopBackend>();
+#else
+	return MakeShared<FNullWorkshopBackend>();
+#endif
+}
+
+TSharedRef<IWorkshopBackend> IWorkshopBackend::Create()
+{
+	TSharedRef<IWorkshopBackend> Backend = CreatePlatformBackend();
+
+	// -WorkshopRecord on its own picks a new file for every session
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString TracePath;
+	if (FParse::Value(CommandLine, TEXT("WorkshopRecord="), TracePath))
+		return MakeShared<FWorkshopRecordingBackend>(Backend, FPaths::ConvertRelativePathToFull(TracePath));
+
+	if (FParse::Param(CommandLine, TEXT("WorkshopRecord")))
+		return MakeShared<FWorkshopRecordingBackend>(Backend, FWorkshopRecordingBackend::GetDefaultTraceDir() / FDateTime::Now().ToString() + TEXT(".jsonl"));
+
+	return Backend;
+}
@@ -0,0 +1,173 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
+
+/* Result of an asynchronous Workshop call, Code is the backend's native result code (EResult for Steam) */
+struct FWorkshopResult
+{
+	bool bSuccess = false;
+	bool bIOFailure = false;
+	/* The call was turned down because too many are being made, nothing was changed and it can be retried */
+	bool bThrottled = false;
+	int32 Code = 0;
+	FString Message;
+
+	/* What went wrong after the call itself succeeded, such as the published content failing verification. Also in Message */
+	TArray<FString> Warnings;
+};
+
+/* Title and description in one extra language */
+struct FWorkshopLocalizedText
+{
+	TOptional<FString> Title;
+	TOptional<FString> Description;
+};
+
+/* Same values as ERemoteStoragePublishedFileVisibility */
+enum class EWorkshopVisibility : uint8
+{
+	Public,
+	FriendsOnly,
+	Private,
+	Unlisted,
+};
+
+enum class EWorkshopPreviewType : uint8
+{
+	Image,
+	YouTubeVideo,
+};
+
+/* One entry of an item's gallery */
+struct FWorkshopPreview
+{
+	EWorkshopPreviewType Type = EWorkshopPreviewType::Image;
+
+	/* Absolute path of the processed image, or the YouTube video ID */
+	FString Value;
+
+	/* What the preview was made from, SHA1 of the source image and how it was processed, or the video ID. Equal keys upload the same thing */
+	FString Key;
+
+	bool operator==(const FWorkshopPreview& Other) const { return Type == Other.Type && Key == Other.Key; }
+	bool operator!=(const FWorkshopPreview& Other) const { return !(*this == Other); }
+};
+
+/* Index is into the item's additional previews as they are before the update */
+struct FWorkshopPreviewChange
+{
+	enum class EAction : uint8
+	{
+		Add,
+		Replace,
+		Remove,
+	};
+
+	EAction Action = EAction::Add;
+	int32 Index = 0;
+	FWorkshopPreview Preview;
+};
+
+/* Everything a single StartItemUpdate/SubmitItemUpdate round trip can change, unset fields are left as they are on the Workshop */
+struct FWorkshopItemUpdate
+{
+	uint32 ConsumerAppId = 0;
+	uint64 PublishedFileId = 0;
+
+	TOptional<FString> Title;
+	TOptional<FString> Description;
+	FString Language = TEXT("english");
+	/* Extra languages by Steam API language code. Not sent by the backend, the uploader follows up with a text only update per language */
+	TMap<FString, FWorkshopLocalizedText> Localizations;
+	TOptional<FString> Metadata;
+	TOptional<EWorkshopVisibility> Visibility;
+	TOptional<TArray<FString>> Tags;
+	/* Replace any values the item already has for the same keys, a key can be given more than once */
+	TArray<TPair<FString, FString>> KeyValueTags;
+
+	/* Absolute paths, leave empty to keep the current content/preview */
+	FString ContentFolder;
+	FString PreviewFile;
+
+	/* Screenshots and videos after the main preview, in order. Not sent by the backend, the uploader turns it into PreviewChanges against what it last published */
+	TOptional<TArray<FWorkshopPreview>> Gallery;
+	/* Applied in order */
+	TArray<FWorkshopPreviewChange> PreviewChanges;
+
+	/* Left empty, nothing is added to the item's change history */
+	FString ChangeNote;
+
+	/* Not sent by the backend, the uploader submits the same update to the item's copy in each of these apps as well */
+	TArray<uint32> AdditionalAppIds;
+};
+
+/* What a query returns about a published item */
+struct FWorkshopItemDetails
+{
+	uint64 PublishedFileId = 0;
+	FString Title;
+	FString Description;
+	TArray<FString> Tags;
+	EWorkshopVisibility Visibility = EWorkshopVisibility::Public;
+};
+
+typedef TFunction<void(const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)> FOnWorkshopItemCreated;
+typedef TFunction<void(const FWorkshopResult& Result, bool bNeedsLegalAgreement)> FOnWorkshopItemSubmitted;
+typedef TFunction<void(const FWorkshopResult& Result)> FOnWorkshopCallComplete;
+typedef TFunction<void(const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)> FOnWorkshopItemsQueried;
+typedef TFunction<void(const FWorkshopResult& Result, const FString& InstallFolder)> FOnWorkshopItemDownloaded;
+
+/**
+ * Everything the uploader needs from the Workshop. Keeps the Steam SDK out of the rest of the module,
+ * completion callbacks are always called on the game thread from Tick()
+ */
+class IWorkshopBackend
+{
+public:
+
+	virtual ~IWorkshopBackend() {}
+
+	/**
+	 * Creates the backend for this platform, a backend that is never available where the Steam SDK isn't. -LocalWorkshop uses
+	 * a fake Workshop on disk instead, -WorkshopReplay=Trace plays a recorded trace back and -WorkshopRecord records whichever is used
+	 */
+	static TSharedRef<IWorkshopBackend> Create();
+
+	/* Whether the Workshop can currently be used */
+	virtual bool IsAvailable() const = 0;
+
+	/* Attempts to (re)initialise the backend, for example if Steam was started after the editor */
+	virtual bool TryInitialize() = 0;
+
+	/* App ID of the running Steam session */
+	virtual uint32 GetAppId() const = 0;
+
+	/* Pumps pending call results */
+	virtual void Tick() = 0;
+
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) = 0;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) = 0;
+
+	/* Makes subscribing to the parent item also subscribe to the child */
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) = 0;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) = 0;
+
+	/* Current details of the given items, items that don't exist are left out */
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) = 0;
+
+	/* Every item the logged in user has published for the app, newest first */
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) = 0;
+
+	/* Downloads the item's current content as subscribers would get it, InstallFolder is where it ended up */
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) = 0;
+
+	/* Cloud storage quota of the logged in user, false if the backend doesn't have one */
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const = 0;
+
+	/* Shows the item's page so the user can accept the Workshop legal agreement */
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) = 0;
+};
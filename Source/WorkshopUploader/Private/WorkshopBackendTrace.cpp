@@ -0,0 +1,613 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopBackendTrace.h"
+#include "WorkshopUploader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Interfaces/IPluginManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+static TSharedRef<FJsonObject> ResultToJson(const FWorkshopResult& Result)
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetBoolField(TEXT("success"), Result.bSuccess);
+	Object->SetBoolField(TEXT("ioFailure"), Result.bIOFailure);
+	Object->SetBoolField(TEXT("throttled"), Result.bThrottled);
+	Object->SetNumberField(TEXT("code"), Result.Code);
+	Object->SetStringField(TEXT("message"), Result.Message);
+	return Object;
+}
+
+static FWorkshopResult ResultFromJson(const FJsonObject& Object)
+{
+	FWorkshopResult Result;
+	Object.TryGetBoolField(TEXT("success"), Result.bSuccess);
+	Object.TryGetBoolField(TEXT("ioFailure"), Result.bIOFailure);
+	Object.TryGetBoolField(TEXT("throttled"), Result.bThrottled);
+	Object.TryGetNumberField(TEXT("code"), Result.Code);
+	Object.TryGetStringField(TEXT("message"), Result.Message);
+	return Result;
+}
+
+/* 64-bit IDs are written as strings, JSON numbers are doubles */
+static uint64 GetId(const FJsonObject& Object, const FString& Field)
+{
+	FString IdString;
+	uint64 Id = 0;
+
+	if (Object.TryGetStringField(Field, IdString))
+		LexFromString(Id, *IdString);
+
+	return Id;
+}
+
+static void SetIds(FJsonObject& Object, const FString& Field, const TArray<uint64>& Ids)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (uint64 Id : Ids)
+		Values.Add(MakeShared<FJsonValueString>(LexToString(Id)));
+
+	Object.SetArrayField(Field, Values);
+}
+
+static TSharedRef<FJsonObject> ItemToJson(const FWorkshopItemDetails& Item)
+{
+	TArray<TSharedPtr<FJsonValue>> Tags;
+	for (const FString& Tag : Item.Tags)
+		Tags.Add(MakeShared<FJsonValueString>(Tag));
+
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("publishedFileId"), LexToString(Item.PublishedFileId));
+	Object->SetStringField(TEXT("title"), Item.Title);
+	Object->SetStringField(TEXT("description"), Item.Description);
+	Object->SetArrayField(TEXT("tags"), Tags);
+	Object->SetNumberField(TEXT("visibility"), (int32)Item.Visibility);
+	return Object;
+}
+
+static FWorkshopItemDetails ItemFromJson(const FJsonObject& Object)
+{
+	FWorkshopItemDetails Item;
+	Item.PublishedFileId = GetId(Object, TEXT("publishedFileId"));
+	Object.TryGetStringField(TEXT("title"), Item.Title);
+	Object.TryGetStringField(TEXT("description"), Item.Description);
+	Object.TryGetStringArrayField(TEXT("tags"), Item.Tags);
+
+	int32 Visibility = 0;
+	if (Object.TryGetNumberField(TEXT("visibility"), Visibility))
+		Item.Visibility = (EWorkshopVisibility)FMath::Clamp(Visibility, 0, (int32)EWorkshopVisibility::Unlisted);
+
+	return Item;
+}
+
+static TSharedRef<FJsonObject> ItemsToJson(const TArray<FWorkshopItemDetails>& Items)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (const FWorkshopItemDetails& Item : Items)
+		Values.Add(MakeShared<FJsonValueObject>(ItemToJson(Item)));
+
+	TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+	Event->SetArrayField(TEXT("items"), Values);
+	return Event;
+}
+
+static TArray<FWorkshopItemDetails> ItemsFromJson(const FJsonObject& Event)
+{
+	TArray<FWorkshopItemDetails> Items;
+
+	const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+	if (!Event.TryGetArrayField(TEXT("items"), Values))
+		return Items;
+
+	for (const TSharedPtr<FJsonValue>& Value : *Values)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (Value->TryGetObject(Object))
+			Items.Add(ItemFromJson(**Object));
+	}
+
+	return Items;
+}
+
+FWorkshopRecordingBackend::FWorkshopRecordingBackend(TSharedRef<IWorkshopBackend> InBackend, const FString& InTracePath)
+	: Backend(InBackend)
+	, TracePath(InTracePath)
+	, StartTime(FPlatformTime::Seconds())
+{
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*TracePath, FILEWRITE_AllowRead));
+
+	if (Writer.IsValid())
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Recording Workshop calls to %s"), *TracePath);
+	else
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't create the Workshop trace %s, calls won't be recorded"), *TracePath);
+
+	TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+	Event->SetNumberField(TEXT("appId"), Backend->GetAppId());
+	Event->SetBoolField(TEXT("available"), Backend->IsAvailable());
+	WriteEvent(TEXT("session"), Event);
+}
+
+FWorkshopRecordingBackend::~FWorkshopRecordingBackend()
+{
+	if (Writer.IsValid())
+		Writer->Close();
+}
+
+FString FWorkshopRecordingBackend::GetDefaultTraceDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Traces");
+}
+
+bool FWorkshopRecordingBackend::TryInitialize()
+{
+	const bool bWasAvailable = Backend->IsAvailable();
+	const bool bAvailable = Backend->TryInitialize();
+
+	// The app ID is only known once Steam is up, replays take it from the last session event
+	if (bAvailable && !bWasAvailable)
+	{
+		TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+		Event->SetNumberField(TEXT("appId"), Backend->GetAppId());
+		Event->SetBoolField(TEXT("available"), true);
+		WriteEvent(TEXT("session"), Event);
+	}
+
+	return bAvailable;
+}
+
+void FWorkshopRecordingBackend::CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetNumberField(TEXT("appId"), ConsumerAppId);
+	const int32 CallId = WriteCall(TEXT("CreateItem"), Args);
+
+	Backend->CreateItem(ConsumerAppId, [this, CallId, OnComplete](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+	{
+		TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+		Event->SetStringField(TEXT("publishedFileId"), LexToString(PublishedFileId));
+		Event->SetBoolField(TEXT("needsLegalAgreement"), bNeedsLegalAgreement);
+		WriteResult(CallId, TEXT("CreateItem"), Result, Event);
+
+		OnComplete(Result, PublishedFileId, bNeedsLegalAgreement);
+	});
+}
+
+void FWorkshopRecordingBackend::SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete)
+{
+	// Which fields were sent rather than their values, enough to tell updates apart when reading a trace
+	TArray<TSharedPtr<FJsonValue>> Fields;
+	auto AddField = [&Fields](bool bSet, const TCHAR* Field)
+	{
+		if (bSet)
+			Fields.Add(MakeShared<FJsonValueString>(Field));
+	};
+
+	AddField(Update.Title.IsSet(), TEXT("title"));
+	AddField(Update.Description.IsSet(), TEXT("description"));
+	AddField(Update.Metadata.IsSet(), TEXT("metadata"));
+	AddField(Update.Visibility.IsSet(), TEXT("visibility"));
+	AddField(Update.Tags.IsSet(), TEXT("tags"));
+	AddField(Update.KeyValueTags.Num() > 0, TEXT("keyValueTags"));
+	AddField(!Update.ContentFolder.IsEmpty(), TEXT("content"));
+	AddField(!Update.PreviewFile.IsEmpty(), TEXT("preview"));
+	AddField(Update.PreviewChanges.Num() > 0, TEXT("previews"));
+
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetNumberField(TEXT("appId"), Update.ConsumerAppId);
+	Args->SetStringField(TEXT("publishedFileId"), LexToString(Update.PublishedFileId));
+	Args->SetStringField(TEXT("language"), Update.Language);
+	Args->SetArrayField(TEXT("fields"), Fields);
+	Args->SetStringField(TEXT("contentFolder"), Update.ContentFolder);
+	Args->SetStringField(TEXT("changeNote"), Update.ChangeNote);
+	const int32 CallId = WriteCall(TEXT("SubmitItemUpdate"), Args);
+
+	Backend->SubmitItemUpdate(Update, [this, CallId, OnComplete](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+		Event->SetBoolField(TEXT("needsLegalAgreement"), bNeedsLegalAgreement);
+		WriteResult(CallId, TEXT("SubmitItemUpdate"), Result, Event);
+
+		OnComplete(Result, bNeedsLegalAgreement);
+	});
+}
+
+void FWorkshopRecordingBackend::AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetStringField(TEXT("parent"), LexToString(ParentPublishedFileId));
+	Args->SetStringField(TEXT("child"), LexToString(ChildPublishedFileId));
+	const int32 CallId = WriteCall(TEXT("AddDependency"), Args);
+
+	Backend->AddDependency(ParentPublishedFileId, ChildPublishedFileId, [this, CallId, OnComplete](const FWorkshopResult& Result)
+	{
+		WriteResult(CallId, TEXT("AddDependency"), Result, MakeShared<FJsonObject>());
+		OnComplete(Result);
+	});
+}
+
+void FWorkshopRecordingBackend::RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetStringField(TEXT("parent"), LexToString(ParentPublishedFileId));
+	Args->SetStringField(TEXT("child"), LexToString(ChildPublishedFileId));
+	const int32 CallId = WriteCall(TEXT("RemoveDependency"), Args);
+
+	Backend->RemoveDependency(ParentPublishedFileId, ChildPublishedFileId, [this, CallId, OnComplete](const FWorkshopResult& Result)
+	{
+		WriteResult(CallId, TEXT("RemoveDependency"), Result, MakeShared<FJsonObject>());
+		OnComplete(Result);
+	});
+}
+
+void FWorkshopRecordingBackend::QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	SetIds(*Args, TEXT("publishedFileIds"), PublishedFileIds);
+	const int32 CallId = WriteCall(TEXT("QueryItemDetails"), Args);
+
+	Backend->QueryItemDetails(PublishedFileIds, [this, CallId, OnComplete](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+	{
+		WriteResult(CallId, TEXT("QueryItemDetails"), Result, ItemsToJson(Items));
+		OnComplete(Result, Items);
+	});
+}
+
+void FWorkshopRecordingBackend::QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetNumberField(TEXT("appId"), ConsumerAppId);
+	const int32 CallId = WriteCall(TEXT("QueryPublishedItems"), Args);
+
+	Backend->QueryPublishedItems(ConsumerAppId, [this, CallId, OnComplete](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+	{
+		WriteResult(CallId, TEXT("QueryPublishedItems"), Result, ItemsToJson(Items));
+		OnComplete(Result, Items);
+	});
+}
+
+void FWorkshopRecordingBackend::DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete)
+{
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetStringField(TEXT("publishedFileId"), LexToString(PublishedFileId));
+	const int32 CallId = WriteCall(TEXT("DownloadItem"), Args);
+
+	Backend->DownloadItem(PublishedFileId, [this, CallId, OnComplete](const FWorkshopResult& Result, const FString& InstallFolder)
+	{
+		TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+		Event->SetStringField(TEXT("installFolder"), InstallFolder);
+		WriteResult(CallId, TEXT("DownloadItem"), Result, Event);
+
+		OnComplete(Result, InstallFolder);
+	});
+}
+
+bool FWorkshopRecordingBackend::GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const
+{
+	const bool bHasQuota = Backend->GetStorageQuota(OutTotalBytes, OutAvailableBytes);
+
+	// Answered straight away, so it is one event rather than a call and a result
+	TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+	Event->SetNumberField(TEXT("id"), NextCallId++);
+	Event->SetStringField(TEXT("call"), TEXT("GetStorageQuota"));
+	Event->SetBoolField(TEXT("hasQuota"), bHasQuota);
+	Event->SetStringField(TEXT("totalBytes"), LexToString(bHasQuota ? OutTotalBytes : 0));
+	Event->SetStringField(TEXT("availableBytes"), LexToString(bHasQuota ? OutAvailableBytes : 0));
+	WriteEvent(TEXT("quota"), Event);
+
+	return bHasQuota;
+}
+
+int32 FWorkshopRecordingBackend::WriteCall(const TCHAR* Call, const TSharedRef<FJsonObject>& Event) const
+{
+	const int32 CallId = NextCallId++;
+
+	Event->SetNumberField(TEXT("id"), CallId);
+	Event->SetStringField(TEXT("call"), Call);
+	WriteEvent(TEXT("call"), Event);
+
+	return CallId;
+}
+
+void FWorkshopRecordingBackend::WriteResult(int32 CallId, const TCHAR* Call, const FWorkshopResult& Result, const TSharedRef<FJsonObject>& Event) const
+{
+	Event->SetNumberField(TEXT("id"), CallId);
+	Event->SetStringField(TEXT("call"), Call);
+	Event->SetObjectField(TEXT("result"), ResultToJson(Result));
+	WriteEvent(TEXT("result"), Event);
+}
+
+void FWorkshopRecordingBackend::WriteEvent(const TCHAR* Kind, const TSharedRef<FJsonObject>& Event) const
+{
+	if (!Writer.IsValid())
+		return;
+
+	Event->SetNumberField(TEXT("time"), FPlatformTime::Seconds() - StartTime);
+	Event->SetStringField(TEXT("event"), Kind);
+
+	// One line per event, so a trace can be read a line at a time and cut short anywhere
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+
+	if (!FJsonSerializer::Serialize(Event, JsonWriter))
+		return;
+
+	Line += TEXT("\n");
+
+	FTCHARToUTF8 Utf8Line(*Line);
+	Writer->Serialize((void*)Utf8Line.Get(), Utf8Line.Length());
+	Writer->Flush();
+}
+
+FWorkshopReplayBackend::FWorkshopReplayBackend(const FString& InTracePath, const FWorkshopReplaySettings& InSettings)
+	: TracePath(InTracePath)
+	, Settings(InSettings)
+	, Random(InSettings.Seed)
+	, StartTime(FPlatformTime::Seconds())
+{
+	bLoaded = Load();
+
+	if (bLoaded)
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Replaying Workshop calls from %s at %gx speed, %g seconds of jitter, seed %d"), *TracePath, Settings.Speed, Settings.JitterSeconds, Settings.Seed);
+	else
+		UE_LOG(LogWorkshopUploader, Error, TEXT("Couldn't load the Workshop trace %s, the Workshop won't be available"), *TracePath);
+}
+
+FWorkshopReplayBackend::~FWorkshopReplayBackend()
+{
+	if (!bLoaded)
+		return;
+
+	// Wall clock time against what the same calls took when they were recorded, for timing the pipeline offline
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Replayed %d Workshop calls (%d not in the trace) in %.1f seconds, they took %.1f seconds when recorded"),
+		NumReplayed, NumUnmatched, FPlatformTime::Seconds() - StartTime, RecordedSeconds);
+}
+
+FString FWorkshopReplayBackend::FindTrace(const FString& NameOrPath)
+{
+	if (FPaths::FileExists(NameOrPath))
+		return NameOrPath;
+
+	const FString FileName = FPaths::GetExtension(NameOrPath).IsEmpty() ? NameOrPath + TEXT(".jsonl") : NameOrPath;
+
+	const FString SavedTrace = FWorkshopRecordingBackend::GetDefaultTraceDir() / FileName;
+	if (FPaths::FileExists(SavedTrace))
+		return SavedTrace;
+
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("WorkshopUploader"));
+	if (Plugin.IsValid())
+		return Plugin->GetBaseDir() / TEXT("Resources") / TEXT("WorkshopTraces") / FileName;
+
+	return NameOrPath;
+}
+
+void FWorkshopReplayBackend::Tick()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Results can make more calls, those are scheduled after this tick's
+	TArray<FPendingResult> DueResults;
+
+	for (int32 Index = PendingResults.Num() - 1; Index >= 0; --Index)
+	{
+		if (PendingResults[Index].DueTime <= Now)
+		{
+			DueResults.Add(MoveTemp(PendingResults[Index]));
+			PendingResults.RemoveAt(Index);
+		}
+	}
+
+	DueResults.Sort([](const FPendingResult& A, const FPendingResult& B)
+	{
+		return A.DueTime != B.DueTime ? A.DueTime < B.DueTime : A.Sequence < B.Sequence;
+	});
+
+	for (FPendingResult& DueResult : DueResults)
+		DueResult.Deliver();
+}
+
+void FWorkshopReplayBackend::CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete)
+{
+	Replay(TEXT("CreateItem"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		bool bNeedsLegalAgreement = false;
+		Event.TryGetBoolField(TEXT("needsLegalAgreement"), bNeedsLegalAgreement);
+
+		OnComplete(Result, GetId(Event, TEXT("publishedFileId")), bNeedsLegalAgreement);
+	});
+}
+
+void FWorkshopReplayBackend::SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete)
+{
+	Replay(TEXT("SubmitItemUpdate"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		bool bNeedsLegalAgreement = false;
+		Event.TryGetBoolField(TEXT("needsLegalAgreement"), bNeedsLegalAgreement);
+
+		OnComplete(Result, bNeedsLegalAgreement);
+	});
+}
+
+void FWorkshopReplayBackend::AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	Replay(TEXT("AddDependency"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		OnComplete(Result);
+	});
+}
+
+void FWorkshopReplayBackend::RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	Replay(TEXT("RemoveDependency"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		OnComplete(Result);
+	});
+}
+
+void FWorkshopReplayBackend::QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	Replay(TEXT("QueryItemDetails"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		OnComplete(Result, ItemsFromJson(Event));
+	});
+}
+
+void FWorkshopReplayBackend::QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete)
+{
+	Replay(TEXT("QueryPublishedItems"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		OnComplete(Result, ItemsFromJson(Event));
+	});
+}
+
+void FWorkshopReplayBackend::DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete)
+{
+	Replay(TEXT("DownloadItem"), [OnComplete](const FWorkshopResult& Result, const FJsonObject& Event)
+	{
+		FString InstallFolder;
+		Event.TryGetStringField(TEXT("installFolder"), InstallFolder);
+
+		OnComplete(Result, InstallFolder);
+	});
+}
+
+bool FWorkshopReplayBackend::GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const
+{
+	if (Quotas.Num() == 0)
+		return false;
+
+	// Quotas are handed out in the order they were recorded, the last one is kept once they run out
+	const TPair<uint64, uint64>& Quota = Quotas[FMath::Min(NextQuota++, Quotas.Num() - 1)];
+	OutTotalBytes = Quota.Key;
+	OutAvailableBytes = Quota.Value;
+	return true;
+}
+
+bool FWorkshopReplayBackend::Load()
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *TracePath))
+		return false;
+
+	// Call ID to the call it started, until its result turns up
+	TMap<int32, TPair<FString, double>> OpenCalls;
+	TMap<int32, int32> OpenCallIndices;
+	double LastTime = 0.0;
+
+	for (const FString& Line : Lines)
+	{
+		if (Line.TrimStartAndEnd().IsEmpty())
+			continue;
+
+		TSharedPtr<FJsonObject> Event;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+
+		if (!FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Skipping a line of %s that isn't JSON: %s"), *TracePath, *Line);
+			continue;
+		}
+
+		FString Kind;
+		FString Call;
+		double Time = 0.0;
+		int32 CallId = 0;
+		Event->TryGetStringField(TEXT("event"), Kind);
+		Event->TryGetStringField(TEXT("call"), Call);
+		Event->TryGetNumberField(TEXT("time"), Time);
+		Event->TryGetNumberField(TEXT("id"), CallId);
+
+		LastTime = FMath::Max(LastTime, Time);
+
+		if (Kind == TEXT("session"))
+		{
+			Event->TryGetNumberField(TEXT("appId"), AppId);
+		}
+		else if (Kind == TEXT("quota"))
+		{
+			bool bHasQuota = false;
+			if (Event->TryGetBoolField(TEXT("hasQuota"), bHasQuota) && bHasQuota)
+				Quotas.Add(TPair<uint64, uint64>(GetId(*Event, TEXT("totalBytes")), GetId(*Event, TEXT("availableBytes"))));
+		}
+		else if (Kind == TEXT("call"))
+		{
+			TArray<FRecordedCall>& Recorded = Calls.FindOrAdd(Call);
+			OpenCallIndices.Add(CallId, Recorded.Num());
+			OpenCalls.Add(CallId, TPair<FString, double>(Call, Time));
+			Recorded.AddDefaulted();
+		}
+		else if (Kind == TEXT("result"))
+		{
+			const TPair<FString, double>* OpenCall = OpenCalls.Find(CallId);
+			if (OpenCall == nullptr)
+				continue;
+
+			FRecordedCall& Recorded = Calls.FindChecked(OpenCall->Key)[OpenCallIndices.FindChecked(CallId)];
+			Recorded.Latency = FMath::Max(0.0, Time - OpenCall->Value);
+			Recorded.Result = Event;
+
+			OpenCalls.Remove(CallId);
+		}
+	}
+
+	// Recording stopped before these came back, they fail once the rest of the trace has played
+	for (const TPair<int32, TPair<FString, double>>& OpenCall : OpenCalls)
+		Calls.FindChecked(OpenCall.Value.Key)[OpenCallIndices.FindChecked(OpenCall.Key)].Latency = LastTime - OpenCall.Value.Value;
+
+	return true;
+}
+
+void FWorkshopReplayBackend::Replay(const FString& Call, FOnReplayed OnReplayed)
+{
+	TArray<FRecordedCall>* Recorded = Calls.Find(Call);
+	int32& NextCall = NextCalls.FindOrAdd(Call);
+
+	double Latency = 0.0;
+	TSharedPtr<FJsonObject> Event;
+
+	if (Recorded != nullptr && Recorded->IsValidIndex(NextCall))
+	{
+		const FRecordedCall& RecordedCall = (*Recorded)[NextCall++];
+		Latency = RecordedCall.Latency;
+		Event = RecordedCall.Result;
+
+		++NumReplayed;
+		RecordedSeconds += Latency;
+	}
+	else
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("%s has no more %s calls, failing this one"), *TracePath, *Call);
+		++NumUnmatched;
+	}
+
+	FWorkshopResult Result;
+	const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+
+	if (Event.IsValid() && Event->TryGetObjectField(TEXT("result"), ResultObject))
+	{
+		Result = ResultFromJson(**ResultObject);
+	}
+	else
+	{
+		Result.bIOFailure = true;
+		Result.Message = FString::Printf(TEXT("The Workshop trace has no result for this %s call."), *Call);
+		Event = MakeShared<FJsonObject>();
+	}
+
+	// Jitter only ever delays, a result can't come back before its call was made
+	double Delay = Settings.Speed > 0.0f ? Latency / Settings.Speed : 0.0;
+	if (Settings.JitterSeconds > 0.0f)
+		Delay += Random.FRandRange(0.0f, Settings.JitterSeconds);
+
+	FPendingResult& Pending = PendingResults.AddDefaulted_GetRef();
+	Pending.DueTime = FPlatformTime::Seconds() + Delay;
+	Pending.Sequence = NextSequence++;
+	Pending.Deliver = [OnReplayed, Result, Event]()
+	{
+		OnReplayed(Result, *Event);
+	};
+}
@@ -0,0 +1,143 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+#include "Math/RandomStream.h"
+
+class FJsonObject;
+
+/**
+ * Writes every call made to the wrapped backend and every result it returns to a trace, one JSON object per line
+ * with the seconds since recording started. Lines are flushed as they are written, so a trace survives the editor
+ * crashing half way through a publish. -WorkshopRecord wraps whichever backend is used in one of these
+ */
+class FWorkshopRecordingBackend : public IWorkshopBackend
+{
+public:
+
+	FWorkshopRecordingBackend(TSharedRef<IWorkshopBackend> InBackend, const FString& InTracePath);
+	virtual ~FWorkshopRecordingBackend();
+
+	/* Saved/WorkshopUploader/Traces, where traces go when no path is given */
+	static FString GetDefaultTraceDir();
+
+	/* IWorkshopBackend implementation */
+	virtual bool IsAvailable() const override { return Backend->IsAvailable(); }
+	virtual bool TryInitialize() override;
+	virtual uint32 GetAppId() const override { return Backend->GetAppId(); }
+	virtual void Tick() override { Backend->Tick(); }
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override;
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override;
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override;
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override { Backend->ShowLegalAgreement(PublishedFileId); }
+
+private:
+
+	TSharedRef<IWorkshopBackend> Backend;
+
+	FString TracePath;
+	TUniquePtr<FArchive> Writer;
+	double StartTime = 0.0;
+	mutable int32 NextCallId = 1;
+
+	/* Writes the call and returns the ID its result is written with */
+	int32 WriteCall(const TCHAR* Call, const TSharedRef<FJsonObject>& Event) const;
+	void WriteResult(int32 CallId, const TCHAR* Call, const FWorkshopResult& Result, const TSharedRef<FJsonObject>& Event) const;
+	void WriteEvent(const TCHAR* Kind, const TSharedRef<FJsonObject>& Event) const;
+};
+
+struct FWorkshopReplaySettings
+{
+	/* Recorded latencies are divided by this, 0 hands every result out on the next tick */
+	float Speed = 1.0f;
+
+	/* Up to this many seconds are added to each result at random, so results that came back close together can swap places */
+	float JitterSeconds = 0.0f;
+
+	/* The same seed and calls always give the same jitter */
+	int32 Seed = 0;
+};
+
+/**
+ * Plays a recorded trace back instead of talking to Steam. Each call is answered with the result recorded for the
+ * next call of the same kind, after the latency it had when it was recorded, so the whole module can be driven
+ * through a publish offline and on machines without Steam. Calls the trace has run out of fail with an IO failure
+ */
+class FWorkshopReplayBackend : public IWorkshopBackend
+{
+public:
+
+	FWorkshopReplayBackend(const FString& InTracePath, const FWorkshopReplaySettings& InSettings);
+	virtual ~FWorkshopReplayBackend();
+
+	/* A bare name is looked for in Saved/WorkshopUploader/Traces and then in the traces that ship with the plugin, Resources/WorkshopTraces */
+	static FString FindTrace(const FString& NameOrPath);
+
+	/* IWorkshopBackend implementation */
+	virtual bool IsAvailable() const override { return bLoaded; }
+	virtual bool TryInitialize() override { return bLoaded; }
+	virtual uint32 GetAppId() const override { return AppId; }
+	virtual void Tick() override;
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override;
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override;
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override;
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override {}
+
+private:
+
+	/* Called with the recorded result and the result event's other fields */
+	typedef TFunction<void(const FWorkshopResult& Result, const FJsonObject& Event)> FOnReplayed;
+
+	struct FRecordedCall
+	{
+		double Latency = 0.0;
+
+		/* Null if recording stopped before the result came back */
+		TSharedPtr<FJsonObject> Result;
+	};
+
+	struct FPendingResult
+	{
+		double DueTime = 0.0;
+		int32 Sequence = 0;
+		TFunction<void()> Deliver;
+	};
+
+	FString TracePath;
+	FWorkshopReplaySettings Settings;
+	bool bLoaded = false;
+	uint32 AppId = 0;
+
+	/* By call name, in the order they were made */
+	TMap<FString, TArray<FRecordedCall>> Calls;
+	TMap<FString, int32> NextCalls;
+
+	TArray<TPair<uint64, uint64>> Quotas;
+	mutable int32 NextQuota = 0;
+
+	FRandomStream Random;
+	TArray<FPendingResult> PendingResults;
+	int32 NextSequence = 0;
+
+	int32 NumReplayed = 0;
+	int32 NumUnmatched = 0;
+	double StartTime = 0.0;
+	double RecordedSeconds = 0.0;
+
+	bool Load();
+
+	/* Takes the next recorded call with this name and schedules its result */
+	void Replay(const FString& Call, FOnReplayed OnReplayed);
+};
@@ -0,0 +1,29 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopBackgroundTasks.h"
+#include "Async/Async.h"
+
+void FWorkshopBackgroundTasks::Run(TFunction<void()> Work, TFunction<void()> OnComplete)
+{
+	FPendingTask& Task = PendingTasks.AddDefaulted_GetRef();
+	Task.Future = Async(EAsyncExecution::ThreadPool, MoveTemp(Work));
+	Task.OnComplete = MoveTemp(OnComplete);
+}
+
+void FWorkshopBackgroundTasks::Tick()
+{
+	// Completion callbacks can queue more work, so collect the finished tasks first
+	TArray<TFunction<void()>> CompletedTasks;
+
+	for (int32 TaskIndex = PendingTasks.Num() - 1; TaskIndex >= 0; --TaskIndex)
+	{
+		if (PendingTasks[TaskIndex].Future.IsReady())
+		{
+			CompletedTasks.Insert(MoveTemp(PendingTasks[TaskIndex].OnComplete), 0);
+			PendingTasks.RemoveAt(TaskIndex);
+		}
+	}
+
+	for (TFunction<void()>& OnComplete : CompletedTasks)
+		OnComplete();
+}
@@ -0,0 +1,33 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Async/Future.h"
+
+/**
+ * Work that reads or writes files runs on the thread pool and finishes back on the game thread. The uploader owns one
+ * of these and ticks it, and everything that needs the thread pool shares it, so there's only one list of tasks to poll
+ */
+class FWorkshopBackgroundTasks
+{
+public:
+
+	/* Runs Work on the thread pool, OnComplete is called from Tick once it's done. Work mustn't touch anything only the game thread uses */
+	void Run(TFunction<void()> Work, TFunction<void()> OnComplete);
+
+	/* Calls the completions of the work that's finished, in the order it was started */
+	void Tick();
+
+	bool IsRunning() const { return PendingTasks.Num() > 0; }
+
+private:
+
+	struct FPendingTask
+	{
+		TFuture<void> Future;
+		TFunction<void()> OnComplete;
+	};
+	TArray<FPendingTask> PendingTasks;
+};
@@ -0,0 +1,216 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopBulkEditor.h"
+#include "WorkshopUploader.h"
+
+static const TCHAR* GetItemStateName(EWorkshopBulkItemState State)
+{
+	switch (State)
+	{
+		case EWorkshopBulkItemState::Pending: return TEXT("Pending");
+		case EWorkshopBulkItemState::Submitting: return TEXT("Submitting");
+		case EWorkshopBulkItemState::Succeeded: return TEXT("Updated");
+		case EWorkshopBulkItemState::Unchanged: return TEXT("Unchanged");
+		case EWorkshopBulkItemState::Failed: return TEXT("Failed");
+		case EWorkshopBulkItemState::Cancelled: return TEXT("Cancelled");
+	}
+
+	return TEXT("");
+}
+
+FWorkshopBulkEditor::FWorkshopBulkEditor(TSharedRef<IWorkshopBackend> InBackend)
+	: Backend(InBackend)
+{
+}
+
+bool FWorkshopBulkEditor::Start(uint32 InConsumerAppId, const TArray<uint64>& PublishedFileIds, const FWorkshopBulkEdit& InEdit)
+{
+	if (IsRunning())
+		return false;
+
+	ConsumerAppId = InConsumerAppId;
+	Edit = InEdit;
+	Details.Reset();
+	Results.Reset();
+	NextIndex = 0;
+
+	for (uint64 PublishedFileId : PublishedFileIds)
+	{
+		if (!Results.ContainsByPredicate([PublishedFileId](const FWorkshopBulkItemResult& Result) { return Result.PublishedFileId == PublishedFileId; }))
+			Results.AddDefaulted_GetRef().PublishedFileId = PublishedFileId;
+	}
+
+	if (!Edit.NeedsItemDetails())
+	{
+		SubmitMore();
+		OnResultsChanged.Broadcast();
+		return true;
+	}
+
+	// One batched query up front instead of a lookup per item
+	bQuerying = true;
+	OnResultsChanged.Broadcast();
+
+	Backend->QueryItemDetails(PublishedFileIds, [this](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+	{
+		bQuerying = false;
+
+		for (const FWorkshopItemDetails& Item : Items)
+			Details.Add(Item.PublishedFileId, Item);
+
+		for (FWorkshopBulkItemResult& ItemResult : Results)
+		{
+			if (const FWorkshopItemDetails* ItemDetails = Details.Find(ItemResult.PublishedFileId))
+			{
+				ItemResult.Title = ItemDetails->Title;
+			}
+			else if (ItemResult.State == EWorkshopBulkItemState::Pending)
+			{
+				ItemResult.State = EWorkshopBulkItemState::Failed;
+				ItemResult.Message = Result.bSuccess ? TEXT("Not found") : FString::Printf(TEXT("Couldn't query the item: %s"), *Result.Message);
+			}
+		}
+
+		SubmitMore();
+		OnResultsChanged.Broadcast();
+	});
+
+	return true;
+}
+
+void FWorkshopBulkEditor::Cancel()
+{
+	for (int32 Index = NextIndex; Index < Results.Num(); ++Index)
+	{
+		if (Results[Index].State == EWorkshopBulkItemState::Pending)
+			Results[Index].State = EWorkshopBulkItemState::Cancelled;
+	}
+
+	NextIndex = Results.Num();
+	OnResultsChanged.Broadcast();
+}
+
+void FWorkshopBulkEditor::SubmitMore()
+{
+	if (bQuerying)
+		return;
+
+	while (NextIndex < Results.Num() && NumInFlight < FMath::Max(1, MaxConcurrentUpdates))
+	{
+		// Claimed before submitting, a call that fails straight away comes back in here
+		const int32 ResultIndex = NextIndex++;
+		FWorkshopBulkItemResult& ItemResult = Results[ResultIndex];
+
+		if (ItemResult.State != EWorkshopBulkItemState::Pending)
+			continue;
+
+		FWorkshopItemUpdate Update;
+		if (!MakeUpdate(ResultIndex, Update))
+		{
+			ItemResult.State = EWorkshopBulkItemState::Unchanged;
+			continue;
+		}
+
+		ItemResult.State = EWorkshopBulkItemState::Submitting;
+		++NumInFlight;
+
+		Backend->SubmitItemUpdate(Update, [this, ResultIndex](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			--NumInFlight;
+
+			FWorkshopBulkItemResult& Finished = Results[ResultIndex];
+			Finished.State = Result.bSuccess ? EWorkshopBulkItemState::Succeeded : EWorkshopBulkItemState::Failed;
+
+			if (!Result.bSuccess)
+			{
+				Finished.Message = Result.Message;
+				UE_LOG(LogWorkshopUploader, Warning, TEXT("Bulk edit of item %llu failed: %s"), Finished.PublishedFileId, *Result.Message);
+			}
+
+			SubmitMore();
+			OnResultsChanged.Broadcast();
+		});
+	}
+}
+
+bool FWorkshopBulkEditor::MakeUpdate(int32 ResultIndex, FWorkshopItemUpdate& OutUpdate) const
+{
+	const uint64 PublishedFileId = Results[ResultIndex].PublishedFileId;
+	const FWorkshopItemDetails* ItemDetails = Details.Find(PublishedFileId);
+
+	OutUpdate.ConsumerAppId = ConsumerAppId;
+	OutUpdate.PublishedFileId = PublishedFileId;
+
+	bool bChanged = false;
+
+	if (Edit.Visibility.IsSet() && (!ItemDetails || ItemDetails->Visibility != Edit.Visibility.GetValue()))
+	{
+		OutUpdate.Visibility = Edit.Visibility;
+		bChanged = true;
+	}
+
+	if (!ItemDetails)
+		return bChanged;
+
+	if (Edit.AddTags.Num() > 0 || Edit.RemoveTags.Num() > 0)
+	{
+		// Steam replaces the whole tag list, so the new one is built from the current one
+		TArray<FString> Tags = ItemDetails->Tags;
+
+		for (const FString& Tag : Edit.RemoveTags)
+			Tags.Remove(Tag);
+
+		for (const FString& Tag : Edit.AddTags)
+			Tags.AddUnique(Tag);
+
+		if (Tags != ItemDetails->Tags)
+		{
+			OutUpdate.Tags = Tags;
+			bChanged = true;
+		}
+	}
+
+	if (!Edit.DescriptionTemplate.IsEmpty())
+	{
+		FStringFormatNamedArguments Arguments;
+		Arguments.Add(TEXT("title"), ItemDetails->Title);
+		Arguments.Add(TEXT("description"), ItemDetails->Description);
+		Arguments.Add(TEXT("id"), LexToString(PublishedFileId));
+
+		const FString Description = FString::Format(*Edit.DescriptionTemplate, Arguments);
+
+		if (Description != ItemDetails->Description)
+		{
+			OutUpdate.Description = Description;
+			bChanged = true;
+		}
+	}
+
+	return bChanged;
+}
+
+FString FWorkshopBulkEditor::Describe() const
+{
+	if (bQuerying)
+		return FString::Printf(TEXT("Looking up %d items..."), Results.Num());
+
+	TMap<EWorkshopBulkItemState, int32> Counts;
+	for (const FWorkshopBulkItemResult& Result : Results)
+		Counts.FindOrAdd(Result.State)++;
+
+	FString Description = FString::Printf(TEXT("%d items: %d updated, %d unchanged, %d failed, %d to go\n"), Results.Num(),
+		Counts.FindRef(EWorkshopBulkItemState::Succeeded), Counts.FindRef(EWorkshopBulkItemState::Unchanged), Counts.FindRef(EWorkshopBulkItemState::Failed),
+		Counts.FindRef(EWorkshopBulkItemState::Pending) + Counts.FindRef(EWorkshopBulkItemState::Submitting));
+
+	for (const FWorkshopBulkItemResult& Result : Results)
+	{
+		Description += FString::Printf(TEXT("%llu  %-10s  %s"), Result.PublishedFileId, GetItemStateName(Result.State), *Result.Title);
+
+		if (!Result.Message.IsEmpty())
+			Description += FString::Printf(TEXT(" - %s"), *Result.Message);
+
+		Description += TEXT("\n");
+	}
+
+	return Description;
+}
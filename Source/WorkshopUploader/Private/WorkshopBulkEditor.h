@@ -0,0 +1,88 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+/* A metadata only change applied to every item of a bulk edit, unset parts are left alone */
+struct FWorkshopBulkEdit
+{
+	TOptional<EWorkshopVisibility> Visibility;
+	TArray<FString> AddTags;
+	TArray<FString> RemoveTags;
+
+	/* {title}, {description} and {id} are filled in from each item, empty keeps the descriptions as they are */
+	FString DescriptionTemplate;
+
+	bool IsEmpty() const { return !Visibility.IsSet() && AddTags.Num() == 0 && RemoveTags.Num() == 0 && DescriptionTemplate.IsEmpty(); }
+
+	/* Tags and descriptions are worked out from what each item has now */
+	bool NeedsItemDetails() const { return AddTags.Num() > 0 || RemoveTags.Num() > 0 || !DescriptionTemplate.IsEmpty(); }
+};
+
+enum class EWorkshopBulkItemState : uint8
+{
+	Pending,
+	Submitting,
+	Succeeded,
+	Unchanged,
+	Failed,
+	Cancelled,
+};
+
+struct FWorkshopBulkItemResult
+{
+	uint64 PublishedFileId = 0;
+	FString Title;
+	EWorkshopBulkItemState State = EWorkshopBulkItemState::Pending;
+	FString Message;
+};
+
+/**
+ * Applies one metadata change to many published items. No content is sent, so each item is a single quick
+ * update, and several of them are in flight at once
+ */
+class FWorkshopBulkEditor
+{
+public:
+
+	explicit FWorkshopBulkEditor(TSharedRef<IWorkshopBackend> InBackend);
+
+	/* Updates Steam works through side by side */
+	int32 MaxConcurrentUpdates = 16;
+
+	/* Returns false if an edit is already running */
+	bool Start(uint32 ConsumerAppId, const TArray<uint64>& PublishedFileIds, const FWorkshopBulkEdit& Edit);
+
+	/* Items that haven't been submitted yet are dropped, ones in flight still finish */
+	void Cancel();
+
+	bool IsRunning() const { return bQuerying || NumInFlight > 0 || NextIndex < Results.Num(); }
+	const TArray<FWorkshopBulkItemResult>& GetResults() const { return Results; }
+
+	/* Summary line followed by one line per item */
+	FString Describe() const;
+
+	DECLARE_MULTICAST_DELEGATE(FOnResultsChanged);
+	FOnResultsChanged OnResultsChanged;
+
+private:
+
+	TSharedRef<IWorkshopBackend> Backend;
+
+	uint32 ConsumerAppId = 0;
+	FWorkshopBulkEdit Edit;
+	TArray<FWorkshopBulkItemResult> Results;
+	TMap<uint64, FWorkshopItemDetails> Details;
+
+	bool bQuerying = false;
+	int32 NextIndex = 0;
+	int32 NumInFlight = 0;
+
+	/* Starts updates until MaxConcurrentUpdates are in flight */
+	void SubmitMore();
+
+	/* The update for one item, false if it would change nothing */
+	bool MakeUpdate(int32 ResultIndex, FWorkshopItemUpdate& OutUpdate) const;
+};
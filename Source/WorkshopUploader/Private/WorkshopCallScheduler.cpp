@@ -0,0 +1,302 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopCallScheduler.h"
+#include "WorkshopUploader.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+
+static const TCHAR* SchedulerConfigSection = TEXT("WorkshopUploader");
+
+/* Prefix of each call type's keys in the config, CreateItemCallsPerMinute etc. */
+static const TCHAR* GetCallTypeConfigName(EWorkshopCallType Type)
+{
+	switch (Type)
+	{
+		case EWorkshopCallType::CreateItem: return TEXT("CreateItem");
+		case EWorkshopCallType::SubmitItemUpdate: return TEXT("SubmitItemUpdate");
+		case EWorkshopCallType::Query: return TEXT("Query");
+		case EWorkshopCallType::Dependency: return TEXT("Dependency");
+		case EWorkshopCallType::Download: return TEXT("Download");
+		default: return TEXT("");
+	}
+}
+
+static const TCHAR* GetCallTypeName(EWorkshopCallType Type)
+{
+	switch (Type)
+	{
+		case EWorkshopCallType::CreateItem: return TEXT("Create item");
+		case EWorkshopCallType::SubmitItemUpdate: return TEXT("Submit update");
+		case EWorkshopCallType::Query: return TEXT("Query");
+		case EWorkshopCallType::Dependency: return TEXT("Dependency");
+		case EWorkshopCallType::Download: return TEXT("Download");
+		default: return TEXT("");
+	}
+}
+
+FWorkshopCallSchedulerSettings FWorkshopCallSchedulerSettings::Load()
+{
+	FWorkshopCallSchedulerSettings Settings;
+
+	for (int32 Type = 0; Type < (int32)EWorkshopCallType::Num; ++Type)
+	{
+		const FString Name = GetCallTypeConfigName((EWorkshopCallType)Type);
+		FWorkshopRateLimit& Limit = Settings.Limits[Type];
+
+		GConfig->GetFloat(SchedulerConfigSection, *(Name + TEXT("CallsPerMinute")), Limit.CallsPerMinute, GGameIni);
+		GConfig->GetFloat(SchedulerConfigSection, *(Name + TEXT("CallBurst")), Limit.Burst, GGameIni);
+		GConfig->GetFloat(SchedulerConfigSection, *(Name + TEXT("MinCallsPerMinute")), Limit.MinCallsPerMinute, GGameIni);
+
+		// A limit of nothing would leave calls queued forever
+		Limit.CallsPerMinute = FMath::Max(Limit.CallsPerMinute, 0.1f);
+		Limit.Burst = FMath::Max(Limit.Burst, 1.0f);
+		Limit.MinCallsPerMinute = FMath::Clamp(Limit.MinCallsPerMinute, 0.1f, Limit.CallsPerMinute);
+	}
+
+	GConfig->GetInt(SchedulerConfigSection, TEXT("MaxCallRetries"), Settings.MaxRetries, GGameIni);
+	GConfig->GetFloat(SchedulerConfigSection, TEXT("CallThrottleBackoff"), Settings.ThrottleBackoff, GGameIni);
+	GConfig->GetFloat(SchedulerConfigSection, TEXT("CallRecoveryStep"), Settings.RecoveryStep, GGameIni);
+
+	Settings.MaxRetries = FMath::Max(Settings.MaxRetries, 0);
+	Settings.ThrottleBackoff = FMath::Clamp(Settings.ThrottleBackoff, 0.01f, 1.0f);
+	Settings.RecoveryStep = FMath::Clamp(Settings.RecoveryStep, 0.0f, 1.0f);
+
+	return Settings;
+}
+
+FWorkshopCallScheduler::FWorkshopCallScheduler(TSharedRef<IWorkshopBackend> InBackend, const FWorkshopCallSchedulerSettings& InSettings)
+	: Settings(InSettings)
+	, Backend(InBackend)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (int32 Type = 0; Type < (int32)EWorkshopCallType::Num; ++Type)
+	{
+		Buckets[Type].Tokens = Settings.Limits[Type].Burst;
+		Buckets[Type].CallsPerSecond = Settings.Limits[Type].CallsPerMinute / 60.0;
+		Buckets[Type].LastRefillTime = Now;
+	}
+}
+
+bool FWorkshopCallScheduler::IsBusy() const
+{
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.Stats.QueueDepth > 0 || Bucket.Stats.NumInFlight > 0)
+			return true;
+	}
+
+	return false;
+}
+
+FString FWorkshopCallScheduler::Describe() const
+{
+	FString Description;
+
+	for (int32 Type = 0; Type < (int32)EWorkshopCallType::Num; ++Type)
+	{
+		const FWorkshopCallStats& Stats = Buckets[Type].Stats;
+		if (Stats.NumSent == 0 && Stats.QueueDepth == 0)
+			continue;
+
+		Description += FString::Printf(TEXT("%s: %d queued, %d in flight, %.1f/min (limit %.1f), waited %.1fs on average (%.1fs max), throttled %d times\n"),
+			GetCallTypeName((EWorkshopCallType)Type), Stats.QueueDepth, Stats.NumInFlight, Stats.CallsPerMinute, Settings.Limits[Type].CallsPerMinute,
+			Stats.AverageWaitSeconds, Stats.MaxWaitSeconds, Stats.NumThrottled);
+	}
+
+	return Description;
+}
+
+void FWorkshopCallScheduler::Tick()
+{
+	Backend->Tick();
+
+	for (int32 Type = 0; Type < (int32)EWorkshopCallType::Num; ++Type)
+		SendQueuedCalls((EWorkshopCallType)Type);
+}
+
+void FWorkshopCallScheduler::CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete)
+{
+	Schedule(EWorkshopCallType::CreateItem, [this, ConsumerAppId, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->CreateItem(ConsumerAppId, [OnResult, OnComplete](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+		{
+			if (OnResult(Result))
+				OnComplete(Result, PublishedFileId, bNeedsLegalAgreement);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete)
+{
+	Schedule(EWorkshopCallType::SubmitItemUpdate, [this, Update, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->SubmitItemUpdate(Update, [OnResult, OnComplete](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			if (OnResult(Result))
+				OnComplete(Result, bNeedsLegalAgreement);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	Schedule(EWorkshopCallType::Dependency, [this, ParentPublishedFileId, ChildPublishedFileId, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->AddDependency(ParentPublishedFileId, ChildPublishedFileId, [OnResult, OnComplete](const FWorkshopResult& Result)
+		{
+			if (OnResult(Result))
+				OnComplete(Result);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete)
+{
+	Schedule(EWorkshopCallType::Dependency, [this, ParentPublishedFileId, ChildPublishedFileId, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->RemoveDependency(ParentPublishedFileId, ChildPublishedFileId, [OnResult, OnComplete](const FWorkshopResult& Result)
+		{
+			if (OnResult(Result))
+				OnComplete(Result);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	Schedule(EWorkshopCallType::Query, [this, PublishedFileIds, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->QueryItemDetails(PublishedFileIds, [OnResult, OnComplete](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+		{
+			if (OnResult(Result))
+				OnComplete(Result, Items);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete)
+{
+	Schedule(EWorkshopCallType::Query, [this, ConsumerAppId, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->QueryPublishedItems(ConsumerAppId, [OnResult, OnComplete](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+		{
+			if (OnResult(Result))
+				OnComplete(Result, Items);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete)
+{
+	Schedule(EWorkshopCallType::Download, [this, PublishedFileId, OnComplete](FOnCallResult OnResult)
+	{
+		Backend->DownloadItem(PublishedFileId, [OnResult, OnComplete](const FWorkshopResult& Result, const FString& InstallFolder)
+		{
+			if (OnResult(Result))
+				OnComplete(Result, InstallFolder);
+		});
+	});
+}
+
+void FWorkshopCallScheduler::Schedule(EWorkshopCallType Type, TFunction<void(FOnCallResult OnResult)> Send)
+{
+	TSharedRef<FQueuedCall> Call = MakeShared<FQueuedCall>();
+	Call->Type = Type;
+	Call->Send = MoveTemp(Send);
+	Call->QueuedTime = FPlatformTime::Seconds();
+
+	FBucket& Bucket = Buckets[(int32)Type];
+	Bucket.Queue.Add(Call);
+	Bucket.Stats.QueueDepth = Bucket.Queue.Num();
+
+	// Only wait for the next tick if the bucket is empty
+	SendQueuedCalls(Type);
+}
+
+void FWorkshopCallScheduler::SendQueuedCalls(EWorkshopCallType Type)
+{
+	FBucket& Bucket = Buckets[(int32)Type];
+	const FWorkshopRateLimit& Limit = Settings.Limits[(int32)Type];
+
+	// Settings can be changed at any time, so the adapted rate is kept inside whatever they are now
+	Bucket.CallsPerSecond = FMath::Clamp<double>(Bucket.CallsPerSecond, Limit.MinCallsPerMinute / 60.0, FMath::Max(Limit.MinCallsPerMinute, Limit.CallsPerMinute) / 60.0);
+	Bucket.Stats.CallsPerMinute = Bucket.CallsPerSecond * 60.0;
+
+	const double Now = FPlatformTime::Seconds();
+	Bucket.Tokens = FMath::Min<double>(FMath::Max(1.0f, Limit.Burst), Bucket.Tokens + (Now - Bucket.LastRefillTime) * Bucket.CallsPerSecond);
+	Bucket.LastRefillTime = Now;
+
+	// Sending can complete straight away and schedule more calls, so the queue is re-checked every time
+	while (Bucket.Queue.Num() > 0 && Bucket.Tokens >= 1.0)
+	{
+		TSharedRef<FQueuedCall> Call = Bucket.Queue[0];
+		Bucket.Queue.RemoveAt(0);
+		Bucket.Tokens -= 1.0;
+
+		SendCall(Call);
+	}
+}
+
+void FWorkshopCallScheduler::SendCall(const TSharedRef<FQueuedCall>& Call)
+{
+	FBucket& Bucket = Buckets[(int32)Call->Type];
+	Call->SentTime = FPlatformTime::Seconds();
+
+	if (Call->NumAttempts++ == 0)
+	{
+		const double WaitSeconds = Call->SentTime - Call->QueuedTime;
+
+		++Bucket.NumWaited;
+		Bucket.TotalWaitSeconds += WaitSeconds;
+		Bucket.Stats.AverageWaitSeconds = Bucket.TotalWaitSeconds / Bucket.NumWaited;
+		Bucket.Stats.MaxWaitSeconds = FMath::Max(Bucket.Stats.MaxWaitSeconds, WaitSeconds);
+	}
+
+	Bucket.Stats.QueueDepth = Bucket.Queue.Num();
+	++Bucket.Stats.NumInFlight;
+	++Bucket.Stats.NumSent;
+
+	Call->Send([this, Call](const FWorkshopResult& Result) { return HandleResult(Call, Result); });
+}
+
+bool FWorkshopCallScheduler::HandleResult(const TSharedRef<FQueuedCall>& Call, const FWorkshopResult& Result)
+{
+	FBucket& Bucket = Buckets[(int32)Call->Type];
+	const FWorkshopRateLimit& Limit = Settings.Limits[(int32)Call->Type];
+
+	--Bucket.Stats.NumInFlight;
+
+	if (!Result.bThrottled)
+	{
+		if (Result.bSuccess)
+			Bucket.CallsPerSecond = FMath::Min<double>(Limit.CallsPerMinute / 60.0, Bucket.CallsPerSecond + Limit.CallsPerMinute / 60.0 * Settings.RecoveryStep);
+
+		Bucket.Stats.CallsPerMinute = Bucket.CallsPerSecond * 60.0;
+		return true;
+	}
+
+	++Bucket.Stats.NumThrottled;
+
+	if (Call->SentTime >= Bucket.LastThrottleTime)
+	{
+		Bucket.CallsPerSecond = FMath::Max<double>(Limit.MinCallsPerMinute / 60.0, Bucket.CallsPerSecond * Settings.ThrottleBackoff);
+		Bucket.Stats.CallsPerMinute = Bucket.CallsPerSecond * 60.0;
+		Bucket.LastThrottleTime = FPlatformTime::Seconds();
+
+		// Whatever burst was saved up is what got throttled
+		Bucket.Tokens = 0.0;
+
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("%s calls are being throttled (%s), slowing down to %.1f per minute"),
+			GetCallTypeName(Call->Type), *Result.Message, Bucket.Stats.CallsPerMinute);
+	}
+
+	if (Call->NumAttempts > Settings.MaxRetries)
+		return true;
+
+	// Throttled calls go back to the front, they've already waited their turn
+	Bucket.Queue.Insert(Call, 0);
+	Bucket.Stats.QueueDepth = Bucket.Queue.Num();
+
+	return false;
+}
@@ -0,0 +1,148 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+/* Calls that share a rate limit */
+enum class EWorkshopCallType : uint8
+{
+	CreateItem,
+	SubmitItemUpdate,
+	Query,
+	Dependency,
+	Download,
+
+	Num,
+};
+
+/* Token bucket for one call type */
+struct FWorkshopRateLimit
+{
+	/* Highest rate calls are sent at */
+	float CallsPerMinute = 60.0f;
+
+	/* Calls that can go out back to back after a quiet spell */
+	float Burst = 4.0f;
+
+	/* Throttling never slows calls down below this */
+	float MinCallsPerMinute = 2.0f;
+};
+
+struct FWorkshopCallSchedulerSettings
+{
+	/* By EWorkshopCallType. Creating items is the most limited call, queries are cheap */
+	FWorkshopRateLimit Limits[(int32)EWorkshopCallType::Num] =
+	{
+		{ 20.0f, 2.0f, 1.0f },
+		{ 60.0f, 4.0f, 2.0f },
+		{ 120.0f, 8.0f, 4.0f },
+		{ 60.0f, 4.0f, 2.0f },
+		{ 30.0f, 2.0f, 1.0f },
+	};
+
+	/* A throttled call is queued again this many times before its result is passed on */
+	int32 MaxRetries = 5;
+
+	/* The rate is multiplied by this when a call is throttled... */
+	float ThrottleBackoff = 0.5f;
+
+	/* ...and grows back by this fraction of the limit for every call that gets through */
+	float RecoveryStep = 0.05f;
+
+	/* Defaults overridden by the WorkshopUploader section of the game config */
+	static FWorkshopCallSchedulerSettings Load();
+};
+
+struct FWorkshopCallStats
+{
+	int32 QueueDepth = 0;
+	int32 NumInFlight = 0;
+	int32 NumSent = 0;
+	int32 NumThrottled = 0;
+
+	/* Rate calls are currently sent at, at most the configured limit */
+	float CallsPerMinute = 0.0f;
+
+	/* Time calls spent in the queue before they were first sent */
+	double AverageWaitSeconds = 0.0;
+	double MaxWaitSeconds = 0.0;
+};
+
+/**
+ * Sends every call to the wrapped backend through a token bucket per call type, so bulk edits and pipelines can
+ * queue as much as they like without Steam turning calls down. When Steam does throttle a call the rate is halved
+ * and the call retried, then crept back up with every call that gets through (AIMD), which settles just under
+ * whatever rate Steam currently accepts instead of alternating bursts and failures
+ */
+class FWorkshopCallScheduler : public IWorkshopBackend
+{
+public:
+
+	explicit FWorkshopCallScheduler(TSharedRef<IWorkshopBackend> InBackend, const FWorkshopCallSchedulerSettings& InSettings = FWorkshopCallSchedulerSettings());
+
+	FWorkshopCallSchedulerSettings Settings;
+
+	const FWorkshopCallStats& GetStats(EWorkshopCallType Type) const { return Buckets[(int32)Type].Stats; }
+
+	/* Whether any call is waiting for a token or on its way */
+	bool IsBusy() const;
+
+	/* One line per call type that has been used, empty if none have */
+	FString Describe() const;
+
+	/* IWorkshopBackend implementation */
+	virtual bool IsAvailable() const override { return Backend->IsAvailable(); }
+	virtual bool TryInitialize() override { return Backend->TryInitialize(); }
+	virtual uint32 GetAppId() const override { return Backend->GetAppId(); }
+	virtual void Tick() override;
+	virtual void CreateItem(uint32 ConsumerAppId, FOnWorkshopItemCreated OnComplete) override;
+	virtual void SubmitItemUpdate(const FWorkshopItemUpdate& Update, FOnWorkshopItemSubmitted OnComplete) override;
+	virtual void AddDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void RemoveDependency(uint64 ParentPublishedFileId, uint64 ChildPublishedFileId, FOnWorkshopCallComplete OnComplete) override;
+	virtual void QueryItemDetails(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void QueryPublishedItems(uint32 ConsumerAppId, FOnWorkshopItemsQueried OnComplete) override;
+	virtual void DownloadItem(uint64 PublishedFileId, FOnWorkshopItemDownloaded OnComplete) override;
+	virtual bool GetStorageQuota(uint64& OutTotalBytes, uint64& OutAvailableBytes) const override { return Backend->GetStorageQuota(OutTotalBytes, OutAvailableBytes); }
+	virtual void ShowLegalAgreement(uint64 PublishedFileId) override { Backend->ShowLegalAgreement(PublishedFileId); }
+
+private:
+
+	/* Called with each result the backend returns, false means the call was queued again and the result should be dropped */
+	typedef TFunction<bool(const FWorkshopResult& Result)> FOnCallResult;
+
+	struct FQueuedCall
+	{
+		EWorkshopCallType Type = EWorkshopCallType::Query;
+		TFunction<void(FOnCallResult OnResult)> Send;
+		double QueuedTime = 0.0;
+		double SentTime = 0.0;
+		int32 NumAttempts = 0;
+	};
+
+	struct FBucket
+	{
+		TArray<TSharedRef<FQueuedCall>> Queue;
+		double Tokens = 0.0;
+		double LastRefillTime = 0.0;
+		double CallsPerSecond = 0.0;
+
+		/* Calls sent before the last slow down don't slow it down again, they were sent at the old rate */
+		double LastThrottleTime = 0.0;
+
+		int32 NumWaited = 0;
+		double TotalWaitSeconds = 0.0;
+		FWorkshopCallStats Stats;
+	};
+
+	TSharedRef<IWorkshopBackend> Backend;
+
+	FBucket Buckets[(int32)EWorkshopCallType::Num];
+
+	void Schedule(EWorkshopCallType Type, TFunction<void(FOnCallResult OnResult)> Send);
+	/* Refills the type's bucket and sends queued calls while it has tokens */
+	void SendQueuedCalls(EWorkshopCallType Type);
+	void SendCall(const TSharedRef<FQueuedCall>& Call);
+	bool HandleResult(const TSharedRef<FQueuedCall>& Call, const FWorkshopResult& Result);
+};
@@ -0,0 +1,417 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopContentManifest.h"
+#include "WorkshopUploader.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+/* Bump when the saved layout or chunking parameters change, older manifests are then ignored */
+static const int32 ManifestFileVersion = 2;
+
+/* Chunk sizes are in the same ballpark as Steam's so the estimates are comparable */
+static const uint32 MinChunkSize = 256 * 1024;
+static const uint32 MaxChunkSize = 4 * 1024 * 1024;
+static const uint32 NormalChunkSize = 1024 * 1024;
+
+/* Normalised chunking (FastCDC), harder to cut before the normal size and easier after it. Top bits of the gear hash depend on the last 64 bytes */
+static const uint64 MaskSmall = ~0ull << (64 - 22);
+static const uint64 MaskLarge = ~0ull << (64 - 18);
+
+static const int32 ReadBufferSize = 4 * 1024 * 1024;
+
+/* Rolling hash table, filled from a fixed seed so every run chunks identically */
+struct FGearTable
+{
+	uint64 Values[256];
+
+	FGearTable()
+	{
+		uint64 State = 0x5757524B53484F50ull;
+
+		for (int32 i = 0; i < 256; ++i)
+		{
+			// splitmix64
+			uint64 Z = (State += 0x9E3779B97F4A7C15ull);
+			Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+			Values[i] = Z ^ (Z >> 31);
+		}
+	}
+};
+
+static const FGearTable& GetGearTable()
+{
+	static const FGearTable GearTable;
+	return GearTable;
+}
+
+int64 FWorkshopContentManifest::GetTotalSize() const
+{
+	int64 TotalSize = 0;
+
+	for (const FWorkshopManifestFile& File : Files)
+		TotalSize += File.Size;
+
+	return TotalSize;
+}
+
+FString FWorkshopContentManifest::GetContentHash() const
+{
+	// Files are sorted by path when the manifest is built, so this doesn't depend on the order they were found in
+	FSHA1 ContentHash;
+
+	for (const FWorkshopManifestFile& File : Files)
+	{
+		const FTCHARToUTF8 Path(*File.Path);
+		const FTCHARToUTF8 Hash(*File.Hash);
+
+		ContentHash.Update(reinterpret_cast<const uint8*>(Path.Get()), Path.Length());
+		ContentHash.Update(reinterpret_cast<const uint8*>(Hash.Get()), Hash.Length());
+	}
+
+	ContentHash.Final();
+
+	FSHAHash Digest;
+	ContentHash.GetHash(Digest.Hash);
+
+	return Digest.ToString();
+}
+
+bool FWorkshopContentManifest::BuildFile(const FString& FullPath, FWorkshopManifestFile& OutFile)
+{
+	TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FullPath));
+
+	if (!FileHandle.IsValid())
+		return false;
+
+	const uint64* Gear = GetGearTable().Values;
+
+	OutFile.Size = FileHandle->Size();
+	OutFile.ModifiedTime = IFileManager::Get().GetTimeStamp(*FullPath);
+	OutFile.Chunks.Reset();
+
+	FSHA1 FileHash;
+
+	TArray<uint8> ReadBuffer;
+	ReadBuffer.SetNumUninitialized(ReadBufferSize);
+
+	// Chunks can span reads, so the bytes of the current chunk are collected until it's cut
+	TArray<uint8> ChunkBuffer;
+	ChunkBuffer.Reserve(MaxChunkSize);
+
+	uint64 RollingHash = 0;
+	uint32 ChunkSize = 0;
+
+	auto CutChunk = [&OutFile, &ChunkBuffer, &RollingHash, &ChunkSize]()
+	{
+		FWorkshopChunk Chunk;
+		Chunk.Hash = CityHash64(reinterpret_cast<const char*>(ChunkBuffer.GetData()), ChunkBuffer.Num());
+		Chunk.Size = ChunkBuffer.Num();
+		OutFile.Chunks.Add(Chunk);
+
+		ChunkBuffer.Reset();
+		RollingHash = 0;
+		ChunkSize = 0;
+	};
+
+	int64 Remaining = OutFile.Size;
+
+	while (Remaining > 0)
+	{
+		const int32 BytesToRead = static_cast<int32>(FMath::Min<int64>(Remaining, ReadBufferSize));
+
+		if (!FileHandle->Read(ReadBuffer.GetData(), BytesToRead))
+			return false;
+
+		FileHash.Update(ReadBuffer.GetData(), BytesToRead);
+		Remaining -= BytesToRead;
+
+		int32 RangeStart = 0;
+
+		for (int32 i = 0; i < BytesToRead; ++i)
+		{
+			// Nothing can be cut before the minimum size, so don't bother rolling the hash until then
+			if (++ChunkSize < MinChunkSize)
+				continue;
+
+			RollingHash = (RollingHash << 1) + Gear[ReadBuffer[i]];
+
+			const uint64 Mask = ChunkSize < NormalChunkSize ? MaskSmall : MaskLarge;
+
+			if ((RollingHash & Mask) == 0 || ChunkSize >= MaxChunkSize)
+			{
+				ChunkBuffer.Append(ReadBuffer.GetData() + RangeStart, i + 1 - RangeStart);
+				RangeStart = i + 1;
+
+				CutChunk();
+			}
+		}
+
+		ChunkBuffer.Append(ReadBuffer.GetData() + RangeStart, BytesToRead - RangeStart);
+	}
+
+	if (ChunkBuffer.Num() > 0)
+		CutChunk();
+
+	FileHash.Final();
+
+	FSHAHash Digest;
+	FileHash.GetHash(Digest.Hash);
+	OutFile.Hash = Digest.ToString();
+
+	return true;
+}
+
+FWorkshopContentManifest FWorkshopContentManifest::Build(const FString& ContentFolder, const FWorkshopContentManifest* Cached)
+{
+	FWorkshopContentManifest Manifest;
+	Manifest.CreatedTime = FDateTime::UtcNow();
+
+	TArray<FString> FoundFiles;
+	IFileManager::Get().FindFilesRecursive(FoundFiles, *ContentFolder, TEXT("*"), true, false);
+	FoundFiles.Sort();
+
+	TMap<FString, const FWorkshopManifestFile*> CachedFiles;
+	if (Cached)
+	{
+		for (const FWorkshopManifestFile& File : Cached->Files)
+			CachedFiles.Add(File.Path, &File);
+	}
+
+	Manifest.Files.SetNum(FoundFiles.Num());
+	TArray<bool> FileSucceeded;
+	FileSucceeded.SetNumZeroed(FoundFiles.Num());
+
+	ParallelFor(FoundFiles.Num(), [&Manifest, &FoundFiles, &FileSucceeded, &ContentFolder, &CachedFiles](int32 Index)
+	{
+		FWorkshopManifestFile& File = Manifest.Files[Index];
+
+		File.Path = FoundFiles[Index];
+		FPaths::MakePathRelativeTo(File.Path, *(ContentFolder / TEXT("")));
+
+		if (const FWorkshopManifestFile* const* CachedFile = CachedFiles.Find(File.Path))
+		{
+			if ((*CachedFile)->Size == IFileManager::Get().FileSize(*FoundFiles[Index]) && (*CachedFile)->ModifiedTime == IFileManager::Get().GetTimeStamp(*FoundFiles[Index]))
+			{
+				File = **CachedFile;
+				FileSucceeded[Index] = true;
+				return;
+			}
+		}
+
+		FileSucceeded[Index] = BuildFile(FoundFiles[Index], File);
+	});
+
+	for (int32 Index = FoundFiles.Num() - 1; Index >= 0; --Index)
+	{
+		if (!FileSucceeded[Index])
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't read %s while building the content manifest"), *FoundFiles[Index]);
+			Manifest.Files.RemoveAt(Index);
+		}
+	}
+
+	return Manifest;
+}
+
+FWorkshopContentManifest FWorkshopContentManifest::BuildCached(const FString& ContentFolder, const FString& CachePath)
+{
+	FWorkshopContentManifest Cached;
+	const bool bHasCache = Load(CachePath, Cached);
+
+	FWorkshopContentManifest Manifest = Build(ContentFolder, bHasCache ? &Cached : nullptr);
+	Manifest.Save(CachePath);
+
+	return Manifest;
+}
+
+bool FWorkshopContentManifest::Save(const FString& Filename) const
+{
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("version"), ManifestFileVersion);
+	RootObject->SetStringField(TEXT("publishedFileId"), FString::Printf(TEXT("%llu"), PublishedFileId));
+	RootObject->SetStringField(TEXT("created"), CreatedTime.ToIso8601());
+
+	TArray<TSharedPtr<FJsonValue>> FileValues;
+
+	for (const FWorkshopManifestFile& File : Files)
+	{
+		TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+		FileObject->SetStringField(TEXT("path"), File.Path);
+		FileObject->SetStringField(TEXT("size"), LexToString(File.Size));
+		// Stored as ticks, ISO 8601 drops the sub-millisecond part and cached entries would never match again
+		FileObject->SetStringField(TEXT("modified"), LexToString(File.ModifiedTime.GetTicks()));
+		FileObject->SetStringField(TEXT("hash"), File.Hash);
+
+		// Chunks are stored as "hash:size" strings, 64 bit hashes don't survive being stored as JSON numbers
+		TArray<TSharedPtr<FJsonValue>> ChunkValues;
+		ChunkValues.Reserve(File.Chunks.Num());
+
+		for (const FWorkshopChunk& Chunk : File.Chunks)
+			ChunkValues.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("%016llx:%u"), Chunk.Hash, Chunk.Size)));
+
+		FileObject->SetArrayField(TEXT("chunks"), ChunkValues);
+		FileValues.Add(MakeShared<FJsonValueObject>(FileObject));
+	}
+
+	RootObject->SetArrayField(TEXT("files"), FileValues);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+
+	if (!FJsonSerializer::Serialize(RootObject, Writer))
+		return false;
+
+	// Written next to the real file and moved over it, so a reader on another thread never sees half a manifest
+	const FString TempFilename = FString::Printf(TEXT("%s.%s.tmp"), *Filename, *FGuid::NewGuid().ToString());
+	if (!FFileHelper::SaveStringToFile(JsonString, *TempFilename))
+		return false;
+
+	return IFileManager::Get().Move(*Filename, *TempFilename, true);
+}
+
+bool FWorkshopContentManifest::Load(const FString& Filename, FWorkshopContentManifest& OutManifest)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *Filename))
+		return false;
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		return false;
+
+	int32 Version = 0;
+	if (!RootObject->TryGetNumberField(TEXT("version"), Version) || Version != ManifestFileVersion)
+		return false;
+
+	OutManifest = FWorkshopContentManifest();
+	OutManifest.PublishedFileId = FCString::Strtoui64(*RootObject->GetStringField(TEXT("publishedFileId")), nullptr, 10);
+	FDateTime::ParseIso8601(*RootObject->GetStringField(TEXT("created")), OutManifest.CreatedTime);
+
+	const TArray<TSharedPtr<FJsonValue>>* FileValues = nullptr;
+	if (!RootObject->TryGetArrayField(TEXT("files"), FileValues))
+		return false;
+
+	for (const TSharedPtr<FJsonValue>& FileValue : *FileValues)
+	{
+		const TSharedPtr<FJsonObject>& FileObject = FileValue->AsObject();
+		if (!FileObject.IsValid())
+			continue;
+
+		FWorkshopManifestFile& File = OutManifest.Files.AddDefaulted_GetRef();
+		File.Path = FileObject->GetStringField(TEXT("path"));
+		LexFromString(File.Size, *FileObject->GetStringField(TEXT("size")));
+		int64 ModifiedTicks = 0;
+		LexFromString(ModifiedTicks, *FileObject->GetStringField(TEXT("modified")));
+		File.ModifiedTime = FDateTime(ModifiedTicks);
+		File.Hash = FileObject->GetStringField(TEXT("hash"));
+
+		const TArray<TSharedPtr<FJsonValue>>* ChunkValues = nullptr;
+		if (FileObject->TryGetArrayField(TEXT("chunks"), ChunkValues))
+		{
+			File.Chunks.Reserve(ChunkValues->Num());
+
+			for (const TSharedPtr<FJsonValue>& ChunkValue : *ChunkValues)
+			{
+				FString HashString, SizeString;
+				if (!ChunkValue->AsString().Split(TEXT(":"), &HashString, &SizeString))
+					continue;
+
+				FWorkshopChunk Chunk;
+				Chunk.Hash = FCString::Strtoui64(*HashString, nullptr, 16);
+				Chunk.Size = FCString::Atoi(*SizeString);
+				File.Chunks.Add(Chunk);
+			}
+		}
+	}
+
+	return true;
+}
+
+FString FWorkshopContentManifest::GetManifestPath(uint64 PublishedFileId)
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Manifests") / FString::Printf(TEXT("%llu.json"), PublishedFileId);
+}
+
+FString FWorkshopContentManifest::GetSourceManifestPath(uint64 PublishedFileId)
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Manifests") / FString::Printf(TEXT("%llu.source.json"), PublishedFileId);
+}
+
+bool FWorkshopContentManifest::LoadSource(uint64 PublishedFileId, FWorkshopContentManifest& OutManifest)
+{
+	return Load(GetSourceManifestPath(PublishedFileId), OutManifest) || Load(GetManifestPath(PublishedFileId), OutManifest);
+}
+
+FString FWorkshopContentManifest::GetStagedManifestPath(const FString& Package)
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Manifests") / TEXT("Staged") / (Package + TEXT(".json"));
+}
+
+FString FWorkshopContentManifest::GetCachedManifestPath(const FString& ContentFolder)
+{
+	const FTCHARToUTF8 NormalizedFolder(*FPaths::ConvertRelativePathToFull(ContentFolder));
+	const uint64 FolderHash = CityHash64(NormalizedFolder.Get(), NormalizedFolder.Length());
+
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Manifests") / TEXT("Cache") / FString::Printf(TEXT("%016llx.json"), FolderHash);
+}
+
+FString FWorkshopManifestDiff::Describe(int32 MaxFiles) const
+{
+	FString Description;
+	int32 NumFiles = 0;
+
+	auto AddFiles = [&Description, &NumFiles, MaxFiles](const TArray<FString>& Paths, const TCHAR* What)
+	{
+		for (const FString& Path : Paths)
+		{
+			if (NumFiles++ < MaxFiles)
+				Description += FString::Printf(TEXT("%s: %s\n"), What, *Path);
+		}
+	};
+
+	AddFiles(Missing, TEXT("Missing"));
+	AddFiles(Unexpected, TEXT("Unexpected"));
+	AddFiles(Changed, TEXT("Different"));
+
+	if (NumFiles > MaxFiles)
+		Description += FString::Printf(TEXT("...and %d more\n"), NumFiles - MaxFiles);
+
+	return Description;
+}
+
+FWorkshopManifestDiff FWorkshopManifestDiff::Compare(const FWorkshopContentManifest& Expected, const FWorkshopContentManifest& Actual)
+{
+	FWorkshopManifestDiff Diff;
+
+	TMap<FString, const FWorkshopManifestFile*> ActualFiles;
+	for (const FWorkshopManifestFile& File : Actual.Files)
+		ActualFiles.Add(File.Path, &File);
+
+	for (const FWorkshopManifestFile& File : Expected.Files)
+	{
+		const FWorkshopManifestFile* ActualFile = nullptr;
+
+		if (!ActualFiles.RemoveAndCopyValue(File.Path, ActualFile))
+			Diff.Missing.Add(File.Path);
+		else if (ActualFile->Size != File.Size || ActualFile->Hash != File.Hash)
+			Diff.Changed.Add(File.Path);
+	}
+
+	ActualFiles.GenerateKeyArray(Diff.Unexpected);
+	Diff.Unexpected.Sort();
+
+	return Diff;
+}
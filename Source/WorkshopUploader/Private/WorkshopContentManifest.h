@@ -0,0 +1,85 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* One content defined chunk of a file */
+struct FWorkshopChunk
+{
+	uint64 Hash = 0;
+	uint32 Size = 0;
+};
+
+struct FWorkshopManifestFile
+{
+	/* Relative to the content folder, always with forward slashes */
+	FString Path;
+	int64 Size = 0;
+	FDateTime ModifiedTime;
+
+	/* SHA1 of the whole file */
+	FString Hash;
+
+	TArray<FWorkshopChunk> Chunks;
+};
+
+/**
+ * What was in a content folder when it was published. Files are split with content defined chunking so the
+ * chunks of an unchanged region line up even when bytes were inserted or removed before it, which is close to how
+ * Steam works out which parts of an update subscribers actually need to download
+ */
+struct FWorkshopContentManifest
+{
+	uint64 PublishedFileId = 0;
+	FDateTime CreatedTime;
+	TArray<FWorkshopManifestFile> Files;
+
+	int64 GetTotalSize() const;
+
+	/* SHA1 over every file's path and hash, identical content gives the same hash wherever it was built */
+	FString GetContentHash() const;
+
+	/* Hashes every file under ContentFolder, files are processed in parallel. Files whose size and timestamp match Cached aren't read again */
+	static FWorkshopContentManifest Build(const FString& ContentFolder, const FWorkshopContentManifest* Cached = nullptr);
+
+	/* Build() using and then updating the manifest cached at CachePath */
+	static FWorkshopContentManifest BuildCached(const FString& ContentFolder, const FString& CachePath);
+
+	/* Chunks and hashes a single file, returns false if it couldn't be read */
+	static bool BuildFile(const FString& FullPath, FWorkshopManifestFile& OutFile);
+
+	bool Save(const FString& Filename) const;
+	static bool Load(const FString& Filename, FWorkshopContentManifest& OutManifest);
+
+	/* Where the manifest of the last successful publish of an item is kept */
+	static FString GetManifestPath(uint64 PublishedFileId);
+
+	/* Where the manifest of the staged build an item was last published from is kept. It differs from what was uploaded when the content was repacked or had shared files split out */
+	static FString GetSourceManifestPath(uint64 PublishedFileId);
+
+	/* The source manifest, or the uploaded one for items published before source manifests were kept */
+	static bool LoadSource(uint64 PublishedFileId, FWorkshopContentManifest& OutManifest);
+
+	/* Where the hashes of a mod's staged content are cached between runs */
+	static FString GetStagedManifestPath(const FString& Package);
+
+	/* Same for any other folder that gets uploaded, keyed by its path */
+	static FString GetCachedManifestPath(const FString& ContentFolder);
+};
+
+/* Files that differ between what was published and what a download of it contains */
+struct FWorkshopManifestDiff
+{
+	TArray<FString> Missing;
+	TArray<FString> Unexpected;
+	TArray<FString> Changed;
+
+	bool IsEmpty() const { return Missing.Num() == 0 && Unexpected.Num() == 0 && Changed.Num() == 0; }
+
+	/* One line per file, at most MaxFiles of them */
+	FString Describe(int32 MaxFiles = 20) const;
+
+	/* Files are matched by path and compared by size and hash */
+	static FWorkshopManifestDiff Compare(const FWorkshopContentManifest& Expected, const FWorkshopContentManifest& Actual);
+};
@@ -0,0 +1,374 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopItemDraft.h"
+#include "WorkshopUploader.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+/* Bump when the saved layout changes in a way older fields can't be read from */
+static const int32 DraftsFileVersion = 1;
+
+uint64 FWorkshopItemDraft::GetWorkshopId() const
+{
+	return FCString::Strtoui64(*WorkshopId.ToString(), nullptr, 10);
+}
+
+FString FWorkshopItemDraft::GetMissingFields(bool IsUpdateMod) const
+{
+	FString MissingFields;
+
+	if (IsUpdateMod)
+	{
+		if (GetWorkshopId() == 0)
+			MissingFields += TEXT("Mod Id, ");
+		if (Package.IsEmpty())
+			MissingFields += TEXT("Packaged Mod, ");
+		if (ChangeNote.IsEmpty())
+			MissingFields += TEXT("Change Note, ");
+	}
+	else
+	{
+		if (Title.IsEmpty())
+			MissingFields += TEXT("Title, ");
+		if (Description.IsEmpty())
+			MissingFields += TEXT("Description, ");
+		if (Tags.Num() == 0)
+			MissingFields += TEXT("Tags, ");
+		if (Thumbnail.IsEmpty())
+			MissingFields += TEXT("Thumbnail, ");
+		if (Package.IsEmpty())
+			MissingFields += TEXT("Packaged Mod, ");
+	}
+
+	// Don't leave an extra comma/space at the end
+	MissingFields.TrimEndInline();
+	MissingFields.RemoveFromEnd(TEXT(","), ESearchCase::IgnoreCase);
+
+	return MissingFields;
+}
+
+TSharedRef<FJsonObject> FWorkshopItemDraft::ToJson() const
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+
+	JsonObject->SetStringField(TEXT("title"), Title.ToString());
+	JsonObject->SetStringField(TEXT("description"), Description.ToString());
+	JsonObject->SetStringField(TEXT("thumbnail"), Thumbnail.ToString());
+	JsonObject->SetStringField(TEXT("changeNote"), ChangeNote.ToString());
+	JsonObject->SetStringField(TEXT("workshopId"), WorkshopId.ToString());
+	JsonObject->SetStringField(TEXT("package"), Package);
+	JsonObject->SetBoolField(TEXT("visible"), bIsVisible);
+
+	TArray<TSharedPtr<FJsonValue>> TagValues;
+	for (const FString& Tag : Tags)
+		TagValues.Add(MakeShared<FJsonValueString>(Tag));
+	JsonObject->SetArrayField(TEXT("tags"), TagValues);
+
+	TArray<TSharedPtr<FJsonValue>> GalleryValues;
+	for (const FString& Entry : Gallery)
+		GalleryValues.Add(MakeShared<FJsonValueString>(Entry));
+	JsonObject->SetArrayField(TEXT("gallery"), GalleryValues);
+
+	TArray<TSharedPtr<FJsonValue>> AppValues;
+	for (uint32 AppId : TargetAppIds)
+		AppValues.Add(MakeShared<FJsonValueNumber>(AppId));
+	JsonObject->SetArrayField(TEXT("targetAppIds"), AppValues);
+
+	return JsonObject;
+}
+
+FWorkshopItemDraft FWorkshopItemDraft::FromJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+	FWorkshopItemDraft Draft;
+
+	Draft.Title = FText::FromString(JsonObject->GetStringField(TEXT("title")));
+	Draft.Description = FText::FromString(JsonObject->GetStringField(TEXT("description")));
+	Draft.Thumbnail = FText::FromString(JsonObject->GetStringField(TEXT("thumbnail")));
+	Draft.ChangeNote = FText::FromString(JsonObject->GetStringField(TEXT("changeNote")));
+	Draft.WorkshopId = FText::FromString(JsonObject->GetStringField(TEXT("workshopId")));
+	Draft.Package = JsonObject->GetStringField(TEXT("package"));
+	JsonObject->TryGetBoolField(TEXT("visible"), Draft.bIsVisible);
+
+	const TArray<TSharedPtr<FJsonValue>>* TagValues = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("tags"), TagValues))
+	{
+		for (const TSharedPtr<FJsonValue>& TagValue : *TagValues)
+			Draft.Tags.AddUnique(TagValue->AsString());
+	}
+
+	JsonObject->TryGetStringArrayField(TEXT("gallery"), Draft.Gallery);
+
+	const TArray<TSharedPtr<FJsonValue>>* AppValues = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("targetAppIds"), AppValues))
+	{
+		for (const TSharedPtr<FJsonValue>& AppValue : *AppValues)
+			Draft.TargetAppIds.AddUnique((uint32)AppValue->AsNumber());
+	}
+
+	return Draft;
+}
+
+FWorkshopItemDraft& FWorkshopDraftStore::FindOrAdd(const FString& Key, const FWorkshopItemDraft& Default)
+{
+	if (FWorkshopItemDraft* Draft = Drafts.Find(Key))
+		return *Draft;
+
+	return Drafts.Add(Key, Default);
+}
+
+void FWorkshopDraftStore::Remove(const FString& Key)
+{
+	if (Drafts.Remove(Key) > 0)
+		MarkDirty();
+}
+
+uint64 FWorkshopDraftStore::FindPlatformItem(uint64 PrimaryItemId, const FString& Platform) const
+{
+	const TMap<FString, uint64>* Items = PlatformItems.Find(PrimaryItemId);
+
+	return Items ? Items->FindRef(Platform) : 0;
+}
+
+void FWorkshopDraftStore::SetPlatformItem(uint64 PrimaryItemId, const FString& Platform, uint64 PlatformItemId)
+{
+	PlatformItems.FindOrAdd(PrimaryItemId).Add(Platform, PlatformItemId);
+	MarkDirty();
+}
+
+uint64 FWorkshopDraftStore::FindAppItem(uint64 PrimaryItemId, uint32 AppId) const
+{
+	const TMap<uint32, uint64>* Items = AppItems.Find(PrimaryItemId);
+
+	return Items ? Items->FindRef(AppId) : 0;
+}
+
+void FWorkshopDraftStore::SetAppItem(uint64 PrimaryItemId, uint32 AppId, uint64 AppItemId)
+{
+	AppItems.FindOrAdd(PrimaryItemId).Add(AppId, AppItemId);
+	MarkDirty();
+}
+
+TArray<uint32> FWorkshopDraftStore::GetAppsWithItem(uint64 PrimaryItemId) const
+{
+	TArray<uint32> AppIds;
+
+	if (const TMap<uint32, uint64>* Items = AppItems.Find(PrimaryItemId))
+		Items->GetKeys(AppIds);
+
+	return AppIds;
+}
+
+void FWorkshopDraftStore::SetItemDependencies(uint64 PublishedFileId, const TArray<uint64>& Dependencies)
+{
+	ItemDependencies.Add(PublishedFileId, Dependencies);
+	MarkDirty();
+}
+
+void FWorkshopDraftStore::SetPublishedGallery(uint64 PublishedFileId, const TArray<FWorkshopPreview>& Gallery)
+{
+	PublishedGalleries.Add(PublishedFileId, Gallery);
+	MarkDirty();
+}
+
+uint64 FWorkshopDraftStore::FindWorkshopIdForPackage(const FString& Package) const
+{
+	for (const TPair<FString, FWorkshopItemDraft>& Entry : Drafts)
+	{
+		if (Entry.Value.Package == Package && Entry.Value.GetWorkshopId() != 0)
+			return Entry.Value.GetWorkshopId();
+	}
+
+	return 0;
+}
+
+void FWorkshopDraftStore::Tick(float DeltaTime)
+{
+	if (!bDirty)
+		return;
+
+	TimeSinceDirty += DeltaTime;
+
+	if (TimeSinceDirty >= SaveDelay)
+		Save();
+}
+
+FString FWorkshopDraftStore::GetDraftsFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Drafts.json");
+}
+
+bool FWorkshopDraftStore::Load()
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetDraftsFilePath()))
+		return false;
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't parse %s, starting with empty drafts"), *GetDraftsFilePath());
+		return false;
+	}
+
+	int32 Version = 0;
+	if (!RootObject->TryGetNumberField(TEXT("version"), Version) || Version > DraftsFileVersion)
+		return false;
+
+	const TSharedPtr<FJsonObject>* DraftsObject = nullptr;
+	if (RootObject->TryGetObjectField(TEXT("drafts"), DraftsObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*DraftsObject)->Values)
+		{
+			const TSharedPtr<FJsonObject>* DraftObject = nullptr;
+			if (Entry.Value->TryGetObject(DraftObject))
+				Drafts.Add(Entry.Key, FWorkshopItemDraft::FromJson(DraftObject->ToSharedRef()));
+		}
+	}
+
+	// IDs are stored as strings, 64 bit values don't survive being stored as JSON numbers
+	const TSharedPtr<FJsonObject>* PlatformItemsObject = nullptr;
+	if (RootObject->TryGetObjectField(TEXT("platformItems"), PlatformItemsObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*PlatformItemsObject)->Values)
+		{
+			const TSharedPtr<FJsonObject>* ItemsObject = nullptr;
+			if (!Entry.Value->TryGetObject(ItemsObject))
+				continue;
+
+			TMap<FString, uint64>& Items = PlatformItems.FindOrAdd(FCString::Strtoui64(*Entry.Key, nullptr, 10));
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Item : (*ItemsObject)->Values)
+				Items.Add(Item.Key, FCString::Strtoui64(*Item.Value->AsString(), nullptr, 10));
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* AppItemsObject = nullptr;
+	if (RootObject->TryGetObjectField(TEXT("appItems"), AppItemsObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*AppItemsObject)->Values)
+		{
+			const TSharedPtr<FJsonObject>* ItemsObject = nullptr;
+			if (!Entry.Value->TryGetObject(ItemsObject))
+				continue;
+
+			TMap<uint32, uint64>& Items = AppItems.FindOrAdd(FCString::Strtoui64(*Entry.Key, nullptr, 10));
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Item : (*ItemsObject)->Values)
+				Items.Add(FCString::Atoi64(*Item.Key), FCString::Strtoui64(*Item.Value->AsString(), nullptr, 10));
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* DependenciesObject = nullptr;
+	if (RootObject->TryGetObjectField(TEXT("itemDependencies"), DependenciesObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*DependenciesObject)->Values)
+		{
+			TArray<uint64>& Dependencies = ItemDependencies.FindOrAdd(FCString::Strtoui64(*Entry.Key, nullptr, 10));
+
+			for (const TSharedPtr<FJsonValue>& Dependency : Entry.Value->AsArray())
+				Dependencies.Add(FCString::Strtoui64(*Dependency->AsString(), nullptr, 10));
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* GalleriesObject = nullptr;
+	if (RootObject->TryGetObjectField(TEXT("publishedGalleries"), GalleriesObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*GalleriesObject)->Values)
+		{
+			TArray<FWorkshopPreview>& Gallery = PublishedGalleries.FindOrAdd(FCString::Strtoui64(*Entry.Key, nullptr, 10));
+
+			for (const TSharedPtr<FJsonValue>& PreviewValue : Entry.Value->AsArray())
+			{
+				const TSharedPtr<FJsonObject>& PreviewObject = PreviewValue->AsObject();
+				if (!PreviewObject.IsValid())
+					continue;
+
+				FWorkshopPreview& Preview = Gallery.AddDefaulted_GetRef();
+				Preview.Type = PreviewObject->GetStringField(TEXT("type")) == TEXT("video") ? EWorkshopPreviewType::YouTubeVideo : EWorkshopPreviewType::Image;
+				Preview.Key = PreviewObject->GetStringField(TEXT("key"));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FWorkshopDraftStore::Save()
+{
+	bDirty = false;
+
+	TSharedRef<FJsonObject> DraftsObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, FWorkshopItemDraft>& Entry : Drafts)
+		DraftsObject->SetObjectField(Entry.Key, Entry.Value.ToJson());
+
+	TSharedRef<FJsonObject> PlatformItemsObject = MakeShared<FJsonObject>();
+	for (const TPair<uint64, TMap<FString, uint64>>& Entry : PlatformItems)
+	{
+		TSharedRef<FJsonObject> ItemsObject = MakeShared<FJsonObject>();
+		for (const TPair<FString, uint64>& Item : Entry.Value)
+			ItemsObject->SetStringField(Item.Key, LexToString(Item.Value));
+
+		PlatformItemsObject->SetObjectField(LexToString(Entry.Key), ItemsObject);
+	}
+
+	TSharedRef<FJsonObject> AppItemsObject = MakeShared<FJsonObject>();
+	for (const TPair<uint64, TMap<uint32, uint64>>& Entry : AppItems)
+	{
+		TSharedRef<FJsonObject> ItemsObject = MakeShared<FJsonObject>();
+		for (const TPair<uint32, uint64>& Item : Entry.Value)
+			ItemsObject->SetStringField(LexToString(Item.Key), LexToString(Item.Value));
+
+		AppItemsObject->SetObjectField(LexToString(Entry.Key), ItemsObject);
+	}
+
+	TSharedRef<FJsonObject> DependenciesObject = MakeShared<FJsonObject>();
+	for (const TPair<uint64, TArray<uint64>>& Entry : ItemDependencies)
+	{
+		TArray<TSharedPtr<FJsonValue>> DependencyValues;
+		for (uint64 Dependency : Entry.Value)
+			DependencyValues.Add(MakeShared<FJsonValueString>(LexToString(Dependency)));
+
+		DependenciesObject->SetArrayField(LexToString(Entry.Key), DependencyValues);
+	}
+
+	// Only what's needed to tell whether a preview changed, the processed files themselves can be regenerated
+	TSharedRef<FJsonObject> GalleriesObject = MakeShared<FJsonObject>();
+	for (const TPair<uint64, TArray<FWorkshopPreview>>& Entry : PublishedGalleries)
+	{
+		TArray<TSharedPtr<FJsonValue>> PreviewValues;
+		for (const FWorkshopPreview& Preview : Entry.Value)
+		{
+			TSharedRef<FJsonObject> PreviewObject = MakeShared<FJsonObject>();
+			PreviewObject->SetStringField(TEXT("type"), Preview.Type == EWorkshopPreviewType::YouTubeVideo ? TEXT("video") : TEXT("image"));
+			PreviewObject->SetStringField(TEXT("key"), Preview.Key);
+			PreviewValues.Add(MakeShared<FJsonValueObject>(PreviewObject));
+		}
+
+		GalleriesObject->SetArrayField(LexToString(Entry.Key), PreviewValues);
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("version"), DraftsFileVersion);
+	RootObject->SetObjectField(TEXT("drafts"), DraftsObject);
+	RootObject->SetObjectField(TEXT("platformItems"), PlatformItemsObject);
+	RootObject->SetObjectField(TEXT("appItems"), AppItemsObject);
+	RootObject->SetObjectField(TEXT("itemDependencies"), DependenciesObject);
+	RootObject->SetObjectField(TEXT("publishedGalleries"), GalleriesObject);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+	if (!FJsonSerializer::Serialize(RootObject, Writer) || !FFileHelper::SaveStringToFile(JsonString, *GetDraftsFilePath()))
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't save drafts to %s"), *GetDraftsFilePath());
+		return false;
+	}
+
+	return true;
+}
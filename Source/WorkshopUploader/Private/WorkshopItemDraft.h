@@ -0,0 +1,96 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+class FJsonObject;
+
+/**
+ * What a user has typed in for one Workshop item. Widgets write their FText straight in (no string copy per keystroke),
+ * strings are only materialised when the draft is validated, submitted or saved
+ */
+struct FWorkshopItemDraft
+{
+	FText Title;
+	FText Description;
+	FText Thumbnail;
+	FText ChangeNote;
+	FText WorkshopId;
+	TArray<FString> Tags;
+	/* Image paths and YouTube links shown after the thumbnail, in order */
+	TArray<FString> Gallery;
+	FString Package;
+	bool bIsVisible = false;
+
+	/* Other apps (a demo, a playtest...) that get their own item with the same content, the editor's own app is always published to */
+	TArray<uint32> TargetAppIds;
+
+	/* Parsed Workshop item ID, 0 if none has been entered */
+	uint64 GetWorkshopId() const;
+
+	/* Comma separated names of the fields that still need filling in, empty if the draft can be published */
+	FString GetMissingFields(bool IsUpdateMod) const;
+
+	TSharedRef<FJsonObject> ToJson() const;
+	static FWorkshopItemDraft FromJson(const TSharedRef<FJsonObject>& JsonObject);
+};
+
+/* Named drafts saved under Saved/WorkshopUploader so half filled items survive editor restarts */
+class FWorkshopDraftStore
+{
+public:
+
+	/* Returns the draft with this key, adding Default under that key if there isn't one yet */
+	FWorkshopItemDraft& FindOrAdd(const FString& Key, const FWorkshopItemDraft& Default = FWorkshopItemDraft());
+	void Remove(const FString& Key);
+
+	const TMap<FString, FWorkshopItemDraft>& GetDrafts() const { return Drafts; }
+
+	/* Items holding the other platforms' builds of a multi-platform item, 0 if there isn't one for Platform yet */
+	uint64 FindPlatformItem(uint64 PrimaryItemId, const FString& Platform) const;
+	void SetPlatformItem(uint64 PrimaryItemId, const FString& Platform, uint64 PlatformItemId);
+
+	/* The same for the copies of an item published to other apps, 0 if there isn't one in AppId yet */
+	uint64 FindAppItem(uint64 PrimaryItemId, uint32 AppId) const;
+	void SetAppItem(uint64 PrimaryItemId, uint32 AppId, uint64 AppItemId);
+
+	/* Apps the item has been copied to */
+	TArray<uint32> GetAppsWithItem(uint64 PrimaryItemId) const;
+
+	/* Workshop dependency links this tool has registered for an item, so links to mods that are no longer dependencies can be removed */
+	TArray<uint64> GetItemDependencies(uint64 PublishedFileId) const { return ItemDependencies.FindRef(PublishedFileId); }
+	void SetItemDependencies(uint64 PublishedFileId, const TArray<uint64>& Dependencies);
+
+	/* Gallery as it was last published to an item, what the next submission's preview changes are worked out against */
+	TArray<FWorkshopPreview> GetPublishedGallery(uint64 PublishedFileId) const { return PublishedGalleries.FindRef(PublishedFileId); }
+	void SetPublishedGallery(uint64 PublishedFileId, const TArray<FWorkshopPreview>& Gallery);
+
+	/* Workshop item of the first draft with this package and an ID, 0 if it was never published */
+	uint64 FindWorkshopIdForPackage(const FString& Package) const;
+
+	/* Call after changing a draft, saving is batched up in Tick */
+	void MarkDirty() { bDirty = true; TimeSinceDirty = 0.0f; }
+
+	void Tick(float DeltaTime);
+
+	bool Load();
+	bool Save();
+
+	static FString GetDraftsFilePath();
+
+private:
+
+	TMap<FString, FWorkshopItemDraft> Drafts;
+	TMap<uint64, TMap<FString, uint64>> PlatformItems;
+	TMap<uint64, TMap<uint32, uint64>> AppItems;
+	TMap<uint64, TArray<uint64>> ItemDependencies;
+	TMap<uint64, TArray<FWorkshopPreview>> PublishedGalleries;
+
+	bool bDirty = false;
+	float TimeSinceDirty = 0.0f;
+
+	/* How long typing has to pause for before the drafts get written out */
+	static constexpr float SaveDelay = 2.0f;
+};
@@ -0,0 +1,97 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopItemMetadata.h"
+#include "WorkshopUploader.h"
+#include "WorkshopContentManifest.h"
+#include "WorkshopModDiscovery.h"
+#include "Misc/EngineVersion.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+FWorkshopItemMetadata FWorkshopItemMetadata::Generate(const FString& Package, const FWorkshopContentManifest& Manifest, const TArray<FString>& Platforms, const TArray<uint64>& Dependencies)
+{
+	FWorkshopItemMetadata Metadata;
+	Metadata.Package = Package;
+	Metadata.EngineVersion = FEngineVersion::Current().ToString(EVersionComponent::Patch);
+	Metadata.Platforms = Platforms;
+	Metadata.ContentHash = Manifest.GetContentHash();
+	Metadata.ContentSize = Manifest.GetTotalSize();
+	Metadata.NumFiles = Manifest.Files.Num();
+	Metadata.Dependencies = Dependencies;
+
+	FWorkshopDiscoveredMod Mod;
+	if (FWorkshopModDiscovery::Get().FindMod(Package, Mod))
+	{
+		Metadata.PluginVersionName = Mod.Descriptor.VersionName;
+		Metadata.PluginVersion = Mod.Descriptor.Version;
+	}
+
+	return Metadata;
+}
+
+FString FWorkshopItemMetadata::ToJson() const
+{
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("v"), FormatVersion);
+
+	if (!Package.IsEmpty())
+		RootObject->SetStringField(TEXT("package"), Package);
+	if (!PluginVersionName.IsEmpty())
+		RootObject->SetStringField(TEXT("version"), PluginVersionName);
+
+	RootObject->SetNumberField(TEXT("versionNumber"), PluginVersion);
+	RootObject->SetStringField(TEXT("engine"), EngineVersion);
+	RootObject->SetStringField(TEXT("hash"), ContentHash);
+	RootObject->SetStringField(TEXT("size"), LexToString(ContentSize));
+	RootObject->SetNumberField(TEXT("files"), NumFiles);
+
+	TArray<TSharedPtr<FJsonValue>> PlatformValues;
+	for (const FString& Platform : Platforms)
+		PlatformValues.Add(MakeShared<FJsonValueString>(Platform));
+	RootObject->SetArrayField(TEXT("platforms"), PlatformValues);
+
+	TArray<TSharedPtr<FJsonValue>> DependencyValues;
+	for (uint64 Dependency : Dependencies)
+		DependencyValues.Add(MakeShared<FJsonValueString>(LexToString(Dependency)));
+	RootObject->SetArrayField(TEXT("deps"), DependencyValues);
+
+	auto Serialize = [&RootObject]()
+	{
+		FString JsonString;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+		FJsonSerializer::Serialize(RootObject, Writer);
+		return JsonString;
+	};
+
+	FString JsonString = Serialize();
+
+	// The dependency list is the only part that can grow without bound, and Steam's own dependency links still have it
+	if (FTCHARToUTF8(*JsonString).Length() > MaxMetadataLength)
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("Metadata for %s is too long, leaving the dependencies out of it"), *Package);
+
+		RootObject->RemoveField(TEXT("deps"));
+		JsonString = Serialize();
+	}
+
+	return JsonString;
+}
+
+void FWorkshopItemMetadata::GetKeyValueTags(TArray<TPair<FString, FString>>& OutKeyValueTags) const
+{
+	FEngineVersion Engine;
+	FEngineVersion::Parse(EngineVersion, Engine);
+
+	OutKeyValueTags.Emplace(TEXT("meta_version"), LexToString(FormatVersion));
+	OutKeyValueTags.Emplace(TEXT("engine_version"), FString::Printf(TEXT("%d.%d"), Engine.GetMajor(), Engine.GetMinor()));
+	OutKeyValueTags.Emplace(TEXT("content_hash"), ContentHash);
+	OutKeyValueTags.Emplace(TEXT("content_size"), LexToString(ContentSize));
+
+	if (!PluginVersionName.IsEmpty())
+		OutKeyValueTags.Emplace(TEXT("plugin_version"), PluginVersionName);
+
+	for (const FString& Platform : Platforms)
+		OutKeyValueTags.Emplace(TEXT("platform"), Platform);
+}
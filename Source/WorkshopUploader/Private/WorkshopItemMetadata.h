@@ -0,0 +1,42 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWorkshopContentManifest;
+
+/**
+ * Machine readable summary sent as an item's metadata and key-value tags, so the game can skip incompatible
+ * items and unchanged content from a query alone without downloading anything
+ */
+struct FWorkshopItemMetadata
+{
+	/* Bump when fields are renamed or change meaning, new fields don't need it */
+	static constexpr int32 FormatVersion = 1;
+
+	/* Steam rejects longer metadata (k_cchDeveloperMetadataMax) */
+	static constexpr int32 MaxMetadataLength = 5000;
+
+	FString Package;
+	FString PluginVersionName;
+	int32 PluginVersion = 0;
+	FString EngineVersion;
+	TArray<FString> Platforms;
+
+	/* SHA1 over every file's path and hash, changes whenever any staged file does */
+	FString ContentHash;
+	int64 ContentSize = 0;
+	int32 NumFiles = 0;
+
+	/* Workshop items this one depends on */
+	TArray<uint64> Dependencies;
+
+	static FWorkshopItemMetadata Generate(const FString& Package, const FWorkshopContentManifest& Manifest, const TArray<FString>& Platforms, const TArray<uint64>& Dependencies);
+
+	/* Compact JSON, dependencies are dropped if it would be too long for Steam */
+	FString ToJson() const;
+
+	/* Short values for filtering in queries, one "platform" tag per platform the content was staged for */
+	void GetKeyValueTags(TArray<TPair<FString, FString>>& OutKeyValueTags) const;
+};
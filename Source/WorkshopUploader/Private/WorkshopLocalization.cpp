@@ -0,0 +1,89 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopLocalization.h"
+#include "WorkshopUploader.h"
+#include "WorkshopModDiscovery.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+/* https://partner.steamgames.com/doc/store/localization/languages */
+static const TCHAR* SteamLanguages[] =
+{
+	TEXT("arabic"), TEXT("bulgarian"), TEXT("schinese"), TEXT("tchinese"), TEXT("czech"), TEXT("danish"), TEXT("dutch"), TEXT("english"),
+	TEXT("finnish"), TEXT("french"), TEXT("german"), TEXT("greek"), TEXT("hungarian"), TEXT("indonesian"), TEXT("italian"), TEXT("japanese"),
+	TEXT("koreana"), TEXT("norwegian"), TEXT("polish"), TEXT("portuguese"), TEXT("brazilian"), TEXT("romanian"), TEXT("russian"),
+	TEXT("spanish"), TEXT("latam"), TEXT("swedish"), TEXT("thai"), TEXT("turkish"), TEXT("ukrainian"), TEXT("vietnamese"),
+};
+
+FString FWorkshopLocalization::GetLocalizationDir(const FString& Package)
+{
+	FWorkshopDiscoveredMod Mod;
+	if (!FWorkshopModDiscovery::Get().FindMod(Package, Mod))
+		return FString();
+
+	return Mod.BaseDir / TEXT("Workshop") / TEXT("Localization");
+}
+
+TMap<FString, FWorkshopLocalizedText> FWorkshopLocalization::LoadPackageLocalizations(const FString& Package)
+{
+	TMap<FString, FWorkshopLocalizedText> Localizations;
+
+	const FString LocalizationDir = GetLocalizationDir(Package);
+	if (LocalizationDir.IsEmpty())
+		return Localizations;
+
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *(LocalizationDir / TEXT("*.json")), true, false);
+
+	for (const FString& FileName : FileNames)
+	{
+		const FString Language = FPaths::GetBaseFilename(FileName).ToLower();
+
+		if (!IsSteamLanguage(Language))
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Skipping %s, %s isn't a Steam language code"), *(LocalizationDir / FileName), *Language);
+			continue;
+		}
+
+		FString JsonString;
+		if (!FFileHelper::LoadFileToString(JsonString, *(LocalizationDir / FileName)))
+			continue;
+
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't parse %s"), *(LocalizationDir / FileName));
+			continue;
+		}
+
+		FWorkshopLocalizedText Text;
+		FString Value;
+
+		if (JsonObject->TryGetStringField(TEXT("title"), Value) && !Value.IsEmpty())
+			Text.Title = Value;
+		if (JsonObject->TryGetStringField(TEXT("description"), Value) && !Value.IsEmpty())
+			Text.Description = Value;
+
+		if (Text.Title.IsSet() || Text.Description.IsSet())
+			Localizations.Add(Language, MoveTemp(Text));
+	}
+
+	return Localizations;
+}
+
+bool FWorkshopLocalization::IsSteamLanguage(const FString& Language)
+{
+	for (const TCHAR* SteamLanguage : SteamLanguages)
+	{
+		if (Language == SteamLanguage)
+			return true;
+	}
+
+	return false;
+}
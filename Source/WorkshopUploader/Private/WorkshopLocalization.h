@@ -0,0 +1,22 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+/**
+ * Translated titles and descriptions kept next to a mod, one file per language:
+ * Mods/<Package>/Workshop/Localization/<language>.json with "title" and/or "description"
+ */
+struct FWorkshopLocalization
+{
+	/* Folder the translation files are read from */
+	static FString GetLocalizationDir(const FString& Package);
+
+	/* Every translation file with a language Steam knows, keyed by API language code. Missing folder means no translations */
+	static TMap<FString, FWorkshopLocalizedText> LoadPackageLocalizations(const FString& Package);
+
+	/* Whether Language is one of Steam's API language codes (english, french, schinese...) */
+	static bool IsSteamLanguage(const FString& Language);
+};
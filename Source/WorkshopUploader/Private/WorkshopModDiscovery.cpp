@@ -0,0 +1,289 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopModDiscovery.h"
+#include "WorkshopUploader.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ConfigCacheIni.h"
+
+static const TCHAR* DiscoveryConfigSection = TEXT("WorkshopUploader");
+
+static bool MatchesAny(const FString& Path, const TArray<FString>& Patterns)
+{
+	for (const FString& Pattern : Patterns)
+	{
+		if (Path.MatchesWildcard(Pattern))
+			return true;
+	}
+	return false;
+}
+
+/* A folder holding a descriptor is a mod and isn't looked into any further, its Content can hold thousands of folders */
+static void FindDescriptors(const FString& Root, const FString& Dir, int32 Depth, const FWorkshopModDiscoverySettings& Settings, TArray<FString>& OutDescriptors)
+{
+	TArray<FString> Descriptors;
+	IFileManager::Get().FindFiles(Descriptors, *(Dir / TEXT("*.uplugin")), true, false);
+
+	if (Descriptors.Num() > 0)
+	{
+		for (const FString& Descriptor : Descriptors)
+		{
+			const FString DescriptorPath = Dir / Descriptor;
+
+			FString RelativePath = DescriptorPath;
+			FPaths::MakePathRelativeTo(RelativePath, *(Root / TEXT("")));
+
+			if (MatchesAny(RelativePath, Settings.Include) && !MatchesAny(RelativePath, Settings.Exclude))
+				OutDescriptors.Add(DescriptorPath);
+		}
+		return;
+	}
+
+	if (Depth >= Settings.MaxDepth)
+		return;
+
+	TArray<FString> SubDirs;
+	IFileManager::Get().FindFiles(SubDirs, *(Dir / TEXT("*")), false, true);
+	SubDirs.Sort();
+
+	for (const FString& SubDir : SubDirs)
+		FindDescriptors(Root, Dir / SubDir, Depth + 1, Settings, OutDescriptors);
+}
+
+FString FWorkshopModDiscoverySettings::PatternsToString(const TArray<FString>& Patterns)
+{
+	return FString::Join(Patterns, TEXT("\n"));
+}
+
+TArray<FString> FWorkshopModDiscoverySettings::PatternsFromString(const FString& Lines)
+{
+	TArray<FString> ParsedLines;
+	Lines.ParseIntoArrayLines(ParsedLines);
+
+	TArray<FString> Patterns;
+	for (const FString& Line : ParsedLines)
+	{
+		if (!Line.TrimStartAndEnd().IsEmpty())
+			Patterns.Add(Line.TrimStartAndEnd());
+	}
+	return Patterns;
+}
+
+FWorkshopModDiscoverySettings FWorkshopModDiscoverySettings::Load()
+{
+	FWorkshopModDiscoverySettings Settings;
+
+	// A list that isn't in the config keeps its default, an empty one would find nothing anyway
+	TArray<FString> Values;
+	if (GConfig->GetArray(DiscoveryConfigSection, TEXT("ModDiscoveryRoots"), Values, GGameIni) > 0)
+		Settings.Roots = Values;
+	if (GConfig->GetArray(DiscoveryConfigSection, TEXT("ModDiscoveryInclude"), Values, GGameIni) > 0)
+		Settings.Include = Values;
+
+	GConfig->GetArray(DiscoveryConfigSection, TEXT("ModDiscoveryExclude"), Settings.Exclude, GGameIni);
+	GConfig->GetInt(DiscoveryConfigSection, TEXT("ModDiscoveryMaxDepth"), Settings.MaxDepth, GGameIni);
+
+	return Settings;
+}
+
+void FWorkshopModDiscoverySettings::Save() const
+{
+	const FString DefaultGameIni = FConfigCacheIni::NormalizeConfigIniPath(FPaths::ProjectConfigDir() / TEXT("DefaultGame.ini"));
+	GConfig->LoadFile(DefaultGameIni);
+
+	// The running game config gets the same values, so they're used straight away without reloading it
+	for (const FString& ConfigFile : { GGameIni, DefaultGameIni })
+	{
+		GConfig->SetArray(DiscoveryConfigSection, TEXT("ModDiscoveryRoots"), Roots, ConfigFile);
+		GConfig->SetArray(DiscoveryConfigSection, TEXT("ModDiscoveryInclude"), Include, ConfigFile);
+		GConfig->SetArray(DiscoveryConfigSection, TEXT("ModDiscoveryExclude"), Exclude, ConfigFile);
+		GConfig->SetInt(DiscoveryConfigSection, TEXT("ModDiscoveryMaxDepth"), MaxDepth, ConfigFile);
+	}
+
+	GConfig->Flush(false, DefaultGameIni);
+}
+
+FWorkshopModDiscovery& FWorkshopModDiscovery::Get()
+{
+	static FWorkshopModDiscovery Discovery;
+	return Discovery;
+}
+
+FWorkshopModDiscovery::FWorkshopModDiscovery()
+	: Settings(FWorkshopModDiscoverySettings::Load())
+{
+	Rescan();
+}
+
+FWorkshopModDiscoverySettings FWorkshopModDiscovery::GetSettings() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Settings;
+}
+
+void FWorkshopModDiscovery::SetSettings(const FWorkshopModDiscoverySettings& NewSettings)
+{
+	{
+		FWriteScopeLock WriteLock(Lock);
+		Settings = NewSettings;
+	}
+
+	NewSettings.Save();
+}
+
+bool FWorkshopModDiscovery::Rescan()
+{
+	const FWorkshopModDiscoverySettings CurrentSettings = GetSettings();
+
+	TMap<FString, FWorkshopDiscoveredMod> PreviousMods;
+	{
+		FReadScopeLock ReadLock(Lock);
+		PreviousMods = Mods;
+	}
+
+	TArray<TArray<FString>> RootDescriptors;
+	RootDescriptors.SetNum(CurrentSettings.Roots.Num());
+
+	ParallelFor(CurrentSettings.Roots.Num(), [&CurrentSettings, &RootDescriptors](int32 RootIndex)
+	{
+		const FString Root = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CurrentSettings.Roots[RootIndex]);
+
+		if (IFileManager::Get().DirectoryExists(*Root))
+			FindDescriptors(Root, Root, 0, CurrentSettings, RootDescriptors[RootIndex]);
+	});
+
+	// Earlier roots come first, so they win when two roots hold a mod with the same name
+	TArray<FString> DescriptorPaths;
+	for (const TArray<FString>& Descriptors : RootDescriptors)
+		DescriptorPaths.Append(Descriptors);
+
+	TArray<FWorkshopDiscoveredMod> Parsed;
+	Parsed.SetNum(DescriptorPaths.Num());
+
+	TArray<FString> ParseErrors;
+	ParseErrors.SetNum(DescriptorPaths.Num());
+
+	TArray<bool> bReparsed;
+	bReparsed.SetNumZeroed(DescriptorPaths.Num());
+
+	ParallelFor(DescriptorPaths.Num(), [&DescriptorPaths, &PreviousMods, &Parsed, &ParseErrors, &bReparsed](int32 Index)
+	{
+		FWorkshopDiscoveredMod& Mod = Parsed[Index];
+		Mod.DescriptorPath = FPaths::ConvertRelativePathToFull(DescriptorPaths[Index]);
+		Mod.Package = FPaths::GetBaseFilename(Mod.DescriptorPath);
+		Mod.BaseDir = FPaths::GetPath(Mod.DescriptorPath);
+		Mod.DescriptorTime = IFileManager::Get().GetTimeStamp(*Mod.DescriptorPath);
+
+		const FWorkshopDiscoveredMod* PreviousMod = PreviousMods.Find(Mod.Package);
+		if (PreviousMod != nullptr && PreviousMod->DescriptorPath == Mod.DescriptorPath && PreviousMod->DescriptorTime == Mod.DescriptorTime)
+		{
+			Mod.Descriptor = PreviousMod->Descriptor;
+			return;
+		}
+
+		bReparsed[Index] = true;
+
+		FText FailReason;
+		if (!Mod.Descriptor.Load(Mod.DescriptorPath, FailReason))
+			ParseErrors[Index] = FString::Printf(TEXT("Couldn't read %s: %s"), *Mod.DescriptorPath, *FailReason.ToString());
+	});
+
+	TMap<FString, FWorkshopDiscoveredMod> NewMods;
+	TArray<FString> NewProblems;
+	int32 NewNumParsed = 0;
+
+	for (int32 Index = 0; Index < Parsed.Num(); ++Index)
+	{
+		if (bReparsed[Index])
+			++NewNumParsed;
+
+		if (!ParseErrors[Index].IsEmpty())
+		{
+			NewProblems.Add(ParseErrors[Index]);
+			continue;
+		}
+
+		FWorkshopDiscoveredMod& Mod = Parsed[Index];
+
+		if (const FWorkshopDiscoveredMod* Existing = NewMods.Find(Mod.Package))
+		{
+			NewProblems.Add(FString::Printf(TEXT("%s is in both %s and %s, using the first"), *Mod.Package, *Existing->BaseDir, *Mod.BaseDir));
+			continue;
+		}
+
+		NewMods.Add(Mod.Package, MoveTemp(Mod));
+	}
+
+	bool bChanged = NewNumParsed > 0 || NewMods.Num() != PreviousMods.Num();
+	for (const TPair<FString, FWorkshopDiscoveredMod>& Entry : NewMods)
+	{
+		if (bChanged)
+			break;
+
+		const FWorkshopDiscoveredMod* PreviousMod = PreviousMods.Find(Entry.Key);
+		bChanged = PreviousMod == nullptr || PreviousMod->BaseDir != Entry.Value.BaseDir;
+	}
+
+	for (const FString& Problem : NewProblems)
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("%s"), *Problem);
+
+	if (bChanged)
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Found %d mods in %d folders, %d descriptors were new or changed"), NewMods.Num(), CurrentSettings.Roots.Num(), NewNumParsed);
+
+	FWriteScopeLock WriteLock(Lock);
+	Mods = MoveTemp(NewMods);
+	NumParsed = NewNumParsed;
+	Problems = MoveTemp(NewProblems);
+
+	return bChanged;
+}
+
+TArray<FString> FWorkshopModDiscovery::GetPackages() const
+{
+	TArray<FString> Packages;
+	{
+		FReadScopeLock ReadLock(Lock);
+		Mods.GetKeys(Packages);
+	}
+
+	Packages.Sort();
+
+	return Packages;
+}
+
+bool FWorkshopModDiscovery::FindMod(const FString& Package, FWorkshopDiscoveredMod& OutMod) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	const FWorkshopDiscoveredMod* Mod = Mods.Find(Package);
+	if (Mod == nullptr)
+		return false;
+
+	OutMod = *Mod;
+	return true;
+}
+
+FString FWorkshopModDiscovery::GetModDir(const FString& Package) const
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+
+		if (const FWorkshopDiscoveredMod* Mod = Mods.Find(Package))
+			return Mod->BaseDir;
+	}
+
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Mods") / Package);
+}
+
+FString FWorkshopModDiscovery::Describe() const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	FString Description = FString::Printf(TEXT("%d mods found in %d folders, %d descriptors read in the last rescan"), Mods.Num(), Settings.Roots.Num(), NumParsed);
+
+	for (const FString& Problem : Problems)
+		Description += TEXT("\n") + Problem;
+
+	return Description;
+}
@@ -0,0 +1,95 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginDescriptor.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * Where mods are looked for, read from the [WorkshopUploader] section of the project's game config so the whole team
+ * finds the same mods:
+ *
+ *   +ModDiscoveryRoots=Mods
+ *   +ModDiscoveryExclude=*Test*
+ *   ModDiscoveryMaxDepth=3
+ */
+struct FWorkshopModDiscoverySettings
+{
+	/* Folders searched for .uplugin files, relative ones are relative to the project folder */
+	TArray<FString> Roots = { TEXT("Mods") };
+
+	/* Wildcards matched against a descriptor's path relative to its root, a mod has to match an include and no exclude */
+	TArray<FString> Include = { TEXT("*") };
+	TArray<FString> Exclude;
+
+	/* How many folders down from a root a descriptor can be */
+	int32 MaxDepth = 3;
+
+	/* One pattern per line, the format they're edited in */
+	static FString PatternsToString(const TArray<FString>& Patterns);
+	static TArray<FString> PatternsFromString(const FString& Lines);
+
+	static FWorkshopModDiscoverySettings Load();
+
+	/* Writes the settings to the project's DefaultGame.ini, like the size budgets */
+	void Save() const;
+};
+
+struct FWorkshopDiscoveredMod
+{
+	/* The descriptor's file name, what the mod is known by everywhere else */
+	FString Package;
+	FString DescriptorPath;
+
+	/* The canonical folder of the mod, its staged builds, localization and so on are all found under here */
+	FString BaseDir;
+
+	FPluginDescriptor Descriptor;
+
+	/* Descriptors are only parsed again when this changes */
+	FDateTime DescriptorTime;
+};
+
+/**
+ * Finds mods by walking the configured roots for .uplugin files and parsing them itself, so mods packaged or copied in
+ * after the editor started are picked up by the next rescan. Rescans only reparse descriptors that are new or changed.
+ * Discovered mods can be looked up from any thread
+ */
+class FWorkshopModDiscovery
+{
+public:
+
+	static FWorkshopModDiscovery& Get();
+
+	FWorkshopModDiscoverySettings GetSettings() const;
+
+	/* Saves the settings, the next rescan uses them */
+	void SetSettings(const FWorkshopModDiscoverySettings& NewSettings);
+
+	/* Walks the roots side by side, returns true if mods were added, removed or changed */
+	bool Rescan();
+
+	/* Sorted by name */
+	TArray<FString> GetPackages() const;
+
+	bool FindMod(const FString& Package, FWorkshopDiscoveredMod& OutMod) const;
+
+	/* Canonical folder of a mod, ProjectDir/Mods/Package for one that hasn't been discovered */
+	FString GetModDir(const FString& Package) const;
+
+	/* Summary of the last rescan */
+	FString Describe() const;
+
+private:
+
+	FWorkshopModDiscovery();
+
+	mutable FRWLock Lock;
+
+	FWorkshopModDiscoverySettings Settings;
+	TMap<FString, FWorkshopDiscoveredMod> Mods;
+
+	int32 NumParsed = 0;
+	TArray<FString> Problems;
+};
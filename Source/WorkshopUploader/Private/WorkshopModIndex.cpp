@@ -0,0 +1,218 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopModIndex.h"
+#include "WorkshopStagedContent.h"
+#include "WorkshopContentManifest.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/FileManager.h"
+#include "Containers/BitArray.h"
+
+void FWorkshopModIndex::Rebuild(TArray<FWorkshopModEntry> Mods)
+{
+	TArray<bool> bStaged;
+	bStaged.SetNumZeroed(Mods.Num());
+
+	ParallelFor(Mods.Num(), [this, &Mods, &bStaged](int32 Index)
+	{
+		FWorkshopModEntry& Mod = Mods[Index];
+		const FString StagedBuildsDir = FWorkshopStagedContent::GetStagedBuildsDir(Mod.Package);
+
+		Mod.StagedTime = IFileManager::Get().GetTimeStamp(*StagedBuildsDir);
+		if (Mod.StagedTime == FDateTime::MinValue())
+			return;
+
+		TSharedPtr<FWorkshopModEntry> Previous = Find(Mod.Package);
+
+		if (Previous.IsValid() && Previous->StagedTime == Mod.StagedTime)
+		{
+			Mod.Platforms = Previous->Platforms;
+			Mod.StagedSize = Previous->StagedSize;
+		}
+		else
+		{
+			Mod.Platforms = FWorkshopStagedContent::FindStagedPlatforms(StagedBuildsDir);
+
+			IFileManager::Get().IterateDirectoryStatRecursively(*StagedBuildsDir, [&Mod](const TCHAR*, const FFileStatData& StatData)
+			{
+				if (!StatData.bIsDirectory)
+					Mod.StagedSize += StatData.FileSize;
+
+				return true;
+			});
+		}
+
+		// The manifest is written when content is published, so its timestamp is when that happened
+		if (Mod.PublishedFileId != 0)
+			Mod.LastPublished = IFileManager::Get().GetTimeStamp(*FWorkshopContentManifest::GetManifestPath(Mod.PublishedFileId));
+
+		bStaged[Index] = Mod.Platforms.Num() > 0;
+	});
+
+	Entries.Empty(Mods.Num());
+	Words.Empty();
+	SearchText.Empty(Mods.Num());
+
+	for (int32 Index = 0; Index < Mods.Num(); ++Index)
+	{
+		if (bStaged[Index])
+			Entries.Add(MakeShared<FWorkshopModEntry>(MoveTemp(Mods[Index])));
+	}
+
+	Entries.Sort([](const TSharedPtr<FWorkshopModEntry>& A, const TSharedPtr<FWorkshopModEntry>& B) { return A->Package < B->Package; });
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		const FWorkshopModEntry& Entry = *Entries[EntryIndex];
+
+		TArray<FString> Texts = Entry.Tags;
+		Texts.Add(Entry.Package);
+		Texts.Add(Entry.FriendlyName);
+
+		TArray<FString> EntryWords;
+		for (const FString& Text : Texts)
+			SplitWords(Text, EntryWords);
+
+		for (const FString& Word : EntryWords)
+			Words.Add({ Word, EntryIndex });
+
+		SearchText.Add(FString::Join(Texts, TEXT(" ")).ToLower());
+	}
+
+	Words.Sort([](const FIndexedWord& A, const FIndexedWord& B) { return A.Word < B.Word; });
+
+	LastQuery.Empty();
+	LastMatches.Empty();
+}
+
+TSharedPtr<FWorkshopModEntry> FWorkshopModIndex::Find(const FString& Package) const
+{
+	const int32 Index = Algo::LowerBound(Entries, Package, [](const TSharedPtr<FWorkshopModEntry>& Entry, const FString& Value) { return Entry->Package < Value; });
+
+	return Entries.IsValidIndex(Index) && Entries[Index]->Package == Package ? Entries[Index] : nullptr;
+}
+
+void FWorkshopModIndex::Search(const FString& Query, TArray<TSharedPtr<FWorkshopModEntry>>& OutResults)
+{
+	const FString LowerQuery = Query.TrimStartAndEnd().ToLower();
+
+	TArray<FString> QueryWords;
+	LowerQuery.ParseIntoArrayWS(QueryWords);
+
+	if (QueryWords.Num() == 0)
+	{
+		OutResults = Entries;
+
+		LastQuery.Empty();
+		LastMatches.Empty();
+		return;
+	}
+
+	// Typing one more character can only narrow the results down
+	TArray<int32> Candidates;
+	if (!LastQuery.IsEmpty() && LowerQuery.StartsWith(LastQuery))
+	{
+		Candidates = MoveTemp(LastMatches);
+	}
+	else
+	{
+		Candidates.Reserve(Entries.Num());
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+			Candidates.Add(EntryIndex);
+	}
+
+	TArray<int32> Scores;
+	Scores.SetNumZeroed(Entries.Num());
+
+	for (const FString& QueryWord : QueryWords)
+	{
+		TBitArray<> PrefixHits(false, Entries.Num());
+
+		int32 WordIndex = Algo::LowerBound(Words, QueryWord, [](const FIndexedWord& Indexed, const FString& Value) { return Indexed.Word < Value; });
+		for (; WordIndex < Words.Num() && Words[WordIndex].Word.StartsWith(QueryWord, ESearchCase::CaseSensitive); ++WordIndex)
+			PrefixHits[Words[WordIndex].EntryIndex] = true;
+
+		for (int32 CandidateIndex = Candidates.Num() - 1; CandidateIndex >= 0; --CandidateIndex)
+		{
+			const int32 EntryIndex = Candidates[CandidateIndex];
+
+			const int32 Score = PrefixHits[EntryIndex] ? 100 : FuzzyScore(SearchText[EntryIndex], QueryWord);
+			if (Score > 0)
+				Scores[EntryIndex] += Score;
+			else
+				Candidates.RemoveAtSwap(CandidateIndex);
+		}
+	}
+
+	Candidates.Sort([&Scores, this](int32 A, int32 B)
+	{
+		return Scores[A] != Scores[B] ? Scores[A] > Scores[B] : Entries[A]->Package < Entries[B]->Package;
+	});
+
+	OutResults.Reset(Candidates.Num());
+	for (int32 EntryIndex : Candidates)
+		OutResults.Add(Entries[EntryIndex]);
+
+	LastQuery = LowerQuery;
+	LastMatches = MoveTemp(Candidates);
+}
+
+void FWorkshopModIndex::SplitWords(const FString& Text, TArray<FString>& OutWords)
+{
+	if (Text.IsEmpty())
+		return;
+
+	// The whole name is a word too, so "mycoolm" still finds MyCoolMod by prefix
+	OutWords.Add(Text.ToLower());
+
+	FString Word;
+
+	for (int32 CharIndex = 0; CharIndex < Text.Len(); ++CharIndex)
+	{
+		const TCHAR Char = Text[CharIndex];
+		const bool bCamelBreak = CharIndex > 0 && FChar::IsUpper(Char) && FChar::IsLower(Text[CharIndex - 1]);
+
+		if (!FChar::IsAlnum(Char) || bCamelBreak)
+		{
+			if (Word.Len() > 0)
+				OutWords.Add(MoveTemp(Word));
+
+			Word.Reset();
+
+			if (!FChar::IsAlnum(Char))
+				continue;
+		}
+
+		Word.AppendChar(FChar::ToLower(Char));
+	}
+
+	if (Word.Len() > 0 && Word != OutWords.Last())
+		OutWords.Add(MoveTemp(Word));
+}
+
+int32 FWorkshopModIndex::FuzzyScore(const FString& Text, const FString& Word)
+{
+	// Every character of Word in order, characters that follow each other count for more
+	int32 Score = 0;
+	int32 Run = 0;
+	int32 TextIndex = 0;
+
+	for (const TCHAR Char : Word)
+	{
+		while (TextIndex < Text.Len() && Text[TextIndex] != Char)
+		{
+			++TextIndex;
+			Run = 0;
+		}
+
+		if (TextIndex == Text.Len())
+			return 0;
+
+		Score += 1 + Run;
+		++Run;
+		++TextIndex;
+	}
+
+	// Always below a prefix hit
+	return FMath::Min(Score, 99);
+}
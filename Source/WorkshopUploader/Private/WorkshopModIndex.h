@@ -0,0 +1,71 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/DateTime.h"
+
+/* One packaged mod as the pickers list it */
+struct FWorkshopModEntry
+{
+	FString Package;
+	FString FriendlyName;
+
+	/* The plugin's category and the tags its drafts were given */
+	TArray<FString> Tags;
+
+	uint64 PublishedFileId = 0;
+
+	/* Filled in by the index */
+	TArray<FString> Platforms;
+	int64 StagedSize = 0;
+
+	/* When its content was last published from here, FDateTime::MinValue() if never */
+	FDateTime LastPublished = FDateTime::MinValue();
+
+	/* StagedBuilds is recreated whenever the mod is staged, so its timestamp says whether the rest is still current */
+	FDateTime StagedTime;
+};
+
+/**
+ * Packaged mods with a word prefix index over their names and tags, so the pickers can filter hundreds of mods on every
+ * keystroke. Prefix hits rank above fuzzy (in order, with gaps) ones, and a query that extends the previous one only
+ * rescans what that one matched
+ */
+class FWorkshopModIndex
+{
+public:
+
+	/* Takes the mods with a staged build, measuring only the ones restaged since the last rebuild */
+	void Rebuild(TArray<FWorkshopModEntry> Mods);
+
+	/* Sorted by package name */
+	const TArray<TSharedPtr<FWorkshopModEntry>>& GetEntries() const { return Entries; }
+
+	TSharedPtr<FWorkshopModEntry> Find(const FString& Package) const;
+
+	/* Every whitespace separated word of Query has to match, best matches first. An empty query lists everything */
+	void Search(const FString& Query, TArray<TSharedPtr<FWorkshopModEntry>>& OutResults);
+
+private:
+
+	TArray<TSharedPtr<FWorkshopModEntry>> Entries;
+
+	struct FIndexedWord
+	{
+		FString Word;
+		int32 EntryIndex;
+	};
+
+	/* Lower case words of every name and tag, sorted so a prefix is a binary search away */
+	TArray<FIndexedWord> Words;
+
+	/* Lower case name, friendly name and tags per entry, what fuzzy matching runs over */
+	TArray<FString> SearchText;
+
+	FString LastQuery;
+	TArray<int32> LastMatches;
+
+	static void SplitWords(const FString& Text, TArray<FString>& OutWords);
+	static int32 FuzzyScore(const FString& Text, const FString& Word);
+};
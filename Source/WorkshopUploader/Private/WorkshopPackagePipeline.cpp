@@ -0,0 +1,306 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopPackagePipeline.h"
+#include "WorkshopUploader.h"
+#include "Misc/MonitoredProcess.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
+
+static const TCHAR* GetJobStateName(EWorkshopPackageJobState State)
+{
+	switch (State)
+	{
+		case EWorkshopPackageJobState::Queued: return TEXT("Queued");
+		case EWorkshopPackageJobState::Packaging: return TEXT("Packaging");
+		case EWorkshopPackageJobState::WaitingToUpload: return TEXT("Waiting to upload");
+		case EWorkshopPackageJobState::Uploading: return TEXT("Uploading");
+		case EWorkshopPackageJobState::Succeeded: return TEXT("Published");
+		case EWorkshopPackageJobState::Failed: return TEXT("Failed");
+		case EWorkshopPackageJobState::Cancelled: return TEXT("Cancelled");
+	}
+
+	return TEXT("");
+}
+
+FWorkshopPackagePipeline::FWorkshopPackagePipeline(FPublishPackage InPublishPackage)
+	: PublishPackage(MoveTemp(InPublishPackage))
+{
+}
+
+FWorkshopPackagePipeline::~FWorkshopPackagePipeline()
+{
+	// The processes' output callbacks point back at this pipeline
+	for (TPair<int32, TSharedPtr<FMonitoredProcess>>& Process : Processes)
+		Process.Value->Cancel(true);
+
+	Processes.Empty();
+}
+
+void FWorkshopPackagePipeline::Enqueue(const TMap<FString, TArray<FString>>& PackageDependencies)
+{
+	TArray<FString> Pending;
+	PackageDependencies.GenerateKeyArray(Pending);
+	Pending.Sort();
+
+	// Topological order (Kahn), so roots get packaged and uploaded first. Dependencies outside this batch don't hold anything up
+	TArray<FString> Ordered;
+
+	while (Pending.Num() > 0)
+	{
+		const int32 ReadyIndex = Pending.IndexOfByPredicate([&Pending, &PackageDependencies](const FString& Package)
+		{
+			return !PackageDependencies.FindChecked(Package).ContainsByPredicate([&Pending](const FString& Dependency) { return Pending.Contains(Dependency); });
+		});
+
+		if (ReadyIndex == INDEX_NONE)
+			break;
+
+		Ordered.Add(Pending[ReadyIndex]);
+		Pending.RemoveAt(ReadyIndex);
+	}
+
+	const int32 Batch = NextBatch++;
+
+	auto AddJob = [this, &PackageDependencies, Batch](const FString& Package) -> int32
+	{
+		// Mods still going from an earlier batch stay in that one, jobs of this batch that depend on them wait for it
+		if (FindJob(Package, Batch) != INDEX_NONE)
+			return INDEX_NONE;
+
+		FWorkshopPackageJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Package = Package;
+		Job.Batch = Batch;
+		Job.Dependencies = PackageDependencies.FindChecked(Package);
+
+		return Jobs.Num() - 1;
+	};
+
+	for (const FString& Package : Ordered)
+		AddJob(Package);
+
+	// Whatever is left depends on itself somewhere down the line
+	for (const FString& Package : Pending)
+	{
+		const int32 JobIndex = AddJob(Package);
+
+		if (JobIndex != INDEX_NONE)
+			SetJobState(JobIndex, EWorkshopPackageJobState::Failed, FString::Printf(TEXT("Circular dependency between %s"), *FString::Join(Pending, TEXT(", "))));
+	}
+
+	OnJobsChanged.Broadcast();
+}
+
+int32 FWorkshopPackagePipeline::FindJob(const FString& Package, int32 Batch) const
+{
+	// Finished jobs of earlier batches are ignored, a mod that failed last time mustn't fail the mods that depend on it now
+	return Jobs.FindLastByPredicate([&Package, Batch](const FWorkshopPackageJob& Job)
+	{
+		if (Job.Package != Package)
+			return false;
+
+		return Job.Batch == Batch || Job.State == EWorkshopPackageJobState::Queued || Job.State == EWorkshopPackageJobState::Packaging
+			|| Job.State == EWorkshopPackageJobState::WaitingToUpload || Job.State == EWorkshopPackageJobState::Uploading;
+	});
+}
+
+void FWorkshopPackagePipeline::Cancel()
+{
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+	{
+		const EWorkshopPackageJobState State = Jobs[JobIndex].State;
+
+		if (State == EWorkshopPackageJobState::Queued || State == EWorkshopPackageJobState::Packaging || State == EWorkshopPackageJobState::WaitingToUpload)
+			SetJobState(JobIndex, EWorkshopPackageJobState::Cancelled, FString());
+	}
+
+	for (TPair<int32, TSharedPtr<FMonitoredProcess>>& Process : Processes)
+		Process.Value->Cancel(true);
+
+	Processes.Empty();
+
+	OnJobsChanged.Broadcast();
+}
+
+bool FWorkshopPackagePipeline::IsRunning() const
+{
+	return NumUploading > 0 || Jobs.ContainsByPredicate([](const FWorkshopPackageJob& Job)
+	{
+		return Job.State == EWorkshopPackageJobState::Queued || Job.State == EWorkshopPackageJobState::Packaging || Job.State == EWorkshopPackageJobState::WaitingToUpload;
+	});
+}
+
+void FWorkshopPackagePipeline::Tick()
+{
+	bool bChanged = false;
+
+	{
+		FScopeLock Lock(&StatusLinesLock);
+
+		for (TPair<int32, FString>& StatusLine : PendingStatusLines)
+		{
+			if (Jobs.IsValidIndex(StatusLine.Key))
+				Jobs[StatusLine.Key].StatusLine = MoveTemp(StatusLine.Value);
+		}
+
+		bChanged = PendingStatusLines.Num() > 0;
+		PendingStatusLines.Reset();
+	}
+
+	// Finished packaging goes straight into the upload queue
+	for (auto It = Processes.CreateIterator(); It; ++It)
+	{
+		if (It.Value()->IsRunning())
+			continue;
+
+		const int32 JobIndex = It.Key();
+		Jobs[JobIndex].PackageSeconds = FPlatformTime::Seconds() - StartTimes.FindRef(JobIndex);
+
+		const int32 ReturnCode = It.Value()->GetReturnCode();
+
+		if (ReturnCode == 0)
+			SetJobState(JobIndex, EWorkshopPackageJobState::WaitingToUpload, FString());
+		else
+			SetJobState(JobIndex, EWorkshopPackageJobState::Failed, FString::Printf(TEXT("UAT exited with code %d, see the output log"), ReturnCode));
+
+		It.RemoveCurrent();
+		bChanged = true;
+	}
+
+	// One UAT at a time, two cooks of the same project would write over each other's output. Uploads of what's already
+	// packaged carry on in the meantime
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num() && Processes.Num() == 0; ++JobIndex)
+	{
+		if (Jobs[JobIndex].State != EWorkshopPackageJobState::Queued)
+			continue;
+
+		if (!LaunchPackaging(JobIndex))
+			SetJobState(JobIndex, EWorkshopPackageJobState::Failed, TEXT("Couldn't launch UAT"));
+
+		bChanged = true;
+	}
+
+	StartUploads();
+
+	if (bChanged)
+		OnJobsChanged.Broadcast();
+}
+
+bool FWorkshopPackagePipeline::LaunchPackaging(int32 JobIndex)
+{
+	FWorkshopPackageJob& Job = Jobs[JobIndex];
+
+	// Packaging a mod is a DLC cook of its plugin, staged into the plugin's Saved/StagedBuilds folder. -WaitMutex queues it
+	// behind a UAT started from somewhere else, such as the project launcher, instead of failing
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString Arguments = FString::Printf(
+		TEXT("BuildCookRun -project=\"%s\" -noP4 -unattended -utf8output -nocompile -nocompileeditor -platform=%s -clientconfig=Shipping ")
+		TEXT("-cook -stage -pak -WaitMutex -DLCName=%s -BasedOnReleaseVersion=%s"),
+		*ProjectPath, *FString::Join(Settings.Platforms, TEXT("+")), *Job.Package, *Settings.ReleaseVersion);
+
+#if PLATFORM_WINDOWS
+	const FString UATPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.bat"));
+	TSharedPtr<FMonitoredProcess> Process = MakeShared<FMonitoredProcess>(TEXT("cmd.exe"), FString::Printf(TEXT("/c \"\"%s\" %s\""), *UATPath, *Arguments), true);
+#else
+	const FString UATPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.sh"));
+	TSharedPtr<FMonitoredProcess> Process = MakeShared<FMonitoredProcess>(TEXT("/bin/sh"), FString::Printf(TEXT("\"%s\" %s"), *UATPath, *Arguments), true);
+#endif
+
+	const FString Package = Job.Package;
+
+	Process->OnOutput().BindLambda([this, JobIndex, Package](FString Output)
+	{
+		UE_LOG(LogWorkshopUploader, Log, TEXT("[%s] %s"), *Package, *Output);
+
+		FScopeLock Lock(&StatusLinesLock);
+		PendingStatusLines.Add(JobIndex, Output.TrimStartAndEnd());
+	});
+
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Packaging %s: %s"), *Job.Package, *Arguments);
+
+	if (!Process->Launch())
+		return false;
+
+	Processes.Add(JobIndex, Process);
+	StartTimes.Add(JobIndex, FPlatformTime::Seconds());
+	SetJobState(JobIndex, EWorkshopPackageJobState::Packaging, FString());
+
+	return true;
+}
+
+void FWorkshopPackagePipeline::StartUploads()
+{
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num() && NumUploading < FMath::Max(1, Settings.MaxConcurrentUploads); ++JobIndex)
+	{
+		if (Jobs[JobIndex].State != EWorkshopPackageJobState::WaitingToUpload)
+			continue;
+
+		bool bDependenciesPublished = true;
+		FString FailedDependency;
+
+		for (const FString& Dependency : Jobs[JobIndex].Dependencies)
+		{
+			const int32 DependencyJob = FindJob(Dependency, Jobs[JobIndex].Batch);
+			if (DependencyJob == INDEX_NONE)
+				continue;
+
+			const EWorkshopPackageJobState DependencyState = Jobs[DependencyJob].State;
+
+			if (DependencyState == EWorkshopPackageJobState::Failed || DependencyState == EWorkshopPackageJobState::Cancelled)
+				FailedDependency = Dependency;
+			else if (DependencyState != EWorkshopPackageJobState::Succeeded)
+				bDependenciesPublished = false;
+		}
+
+		if (!FailedDependency.IsEmpty())
+		{
+			SetJobState(JobIndex, EWorkshopPackageJobState::Failed, FString::Printf(TEXT("%s wasn't published"), *FailedDependency));
+			OnJobsChanged.Broadcast();
+			continue;
+		}
+
+		if (!bDependenciesPublished)
+			continue;
+
+		++NumUploading;
+		SetJobState(JobIndex, EWorkshopPackageJobState::Uploading, FString());
+
+		const double UploadStartTime = FPlatformTime::Seconds();
+
+		PublishPackage(Jobs[JobIndex].Package, [this, JobIndex, UploadStartTime](bool bSuccess, const FString& Message)
+		{
+			--NumUploading;
+
+			Jobs[JobIndex].UploadSeconds = FPlatformTime::Seconds() - UploadStartTime;
+			SetJobState(JobIndex, bSuccess ? EWorkshopPackageJobState::Succeeded : EWorkshopPackageJobState::Failed, Message);
+
+			UE_LOG(LogWorkshopUploader, Log, TEXT("%s: %s after packaging for %.1fs and uploading for %.1fs"), *Jobs[JobIndex].Package,
+				bSuccess ? TEXT("published") : TEXT("failed"), Jobs[JobIndex].PackageSeconds, Jobs[JobIndex].UploadSeconds);
+
+			OnJobsChanged.Broadcast();
+		});
+	}
+}
+
+void FWorkshopPackagePipeline::SetJobState(int32 JobIndex, EWorkshopPackageJobState State, const FString& StatusLine)
+{
+	Jobs[JobIndex].State = State;
+	Jobs[JobIndex].StatusLine = StatusLine;
+}
+
+FString FWorkshopPackagePipeline::Describe() const
+{
+	FString Description;
+
+	for (const FWorkshopPackageJob& Job : Jobs)
+	{
+		Description += FString::Printf(TEXT("%s: %s"), *Job.Package, GetJobStateName(Job.State));
+
+		if (!Job.StatusLine.IsEmpty())
+			Description += FString::Printf(TEXT(" - %s"), *Job.StatusLine);
+
+		Description += TEXT("\n");
+	}
+
+	return Description;
+}
@@ -0,0 +1,109 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class FMonitoredProcess;
+
+enum class EWorkshopPackageJobState : uint8
+{
+	Queued,
+	Packaging,
+	WaitingToUpload,
+	Uploading,
+	Succeeded,
+	Failed,
+	Cancelled,
+};
+
+struct FWorkshopPackageJob
+{
+	FString Package;
+	EWorkshopPackageJobState State = EWorkshopPackageJobState::Queued;
+
+	/* Enqueue call the job came from, dependencies are only looked up among jobs of the same batch */
+	int32 Batch = 0;
+
+	/* Mods that have to be published before this one */
+	TArray<FString> Dependencies;
+
+	/* Last line UAT printed, or why the job failed */
+	FString StatusLine;
+
+	double PackageSeconds = 0.0;
+	double UploadSeconds = 0.0;
+};
+
+/* Command line options for packaging a mod */
+struct FWorkshopPackageSettings
+{
+	/* Release of the base game the mods are cooked against, see -BasedOnReleaseVersion */
+	FString ReleaseVersion = TEXT("1.0");
+
+	/* Every platform is cooked and staged by the same UAT run, each one then gets published as its own item */
+	TArray<FString> Platforms = { TEXT("Win64") };
+
+	/* Mods that don't depend on each other upload side by side */
+	int32 MaxConcurrentUploads = 2;
+};
+
+/**
+ * Packages mods with UAT in the background and hands each one to the publish step as soon as it's staged,
+ * so packaging the next mod overlaps uploading the previous one. Mods are packaged one at a time, every UAT run
+ * cooks the same project into the same Saved and Intermediate folders. A mod only uploads once every mod it depends
+ * on in the same batch has been published, independent mods upload in parallel
+ */
+class FWorkshopPackagePipeline
+{
+public:
+
+	/* Publishes a packaged mod, OnComplete must be called on the game thread once it's done */
+	typedef TFunction<void(const FString& Package, TFunction<void(bool bSuccess, const FString& Message)> OnComplete)> FPublishPackage;
+
+	explicit FWorkshopPackagePipeline(FPublishPackage InPublishPackage);
+	~FWorkshopPackagePipeline();
+
+	FWorkshopPackageSettings Settings;
+
+	/* Queues mods (keys) for packaging and publishing in dependency order, mods that are already queued are skipped */
+	void Enqueue(const TMap<FString, TArray<FString>>& PackageDependencies);
+
+	/* Stops running UAT processes and drops everything that hasn't started uploading */
+	void Cancel();
+
+	void Tick();
+
+	bool IsRunning() const;
+	const TArray<FWorkshopPackageJob>& GetJobs() const { return Jobs; }
+
+	/* One line per job */
+	FString Describe() const;
+
+	DECLARE_MULTICAST_DELEGATE(FOnJobsChanged);
+	FOnJobsChanged OnJobsChanged;
+
+private:
+
+	FPublishPackage PublishPackage;
+
+	TArray<FWorkshopPackageJob> Jobs;
+
+	/* UAT processes by job index, their output arrives on the process' own thread */
+	TMap<int32, TSharedPtr<FMonitoredProcess>> Processes;
+	TMap<int32, double> StartTimes;
+
+	FCriticalSection StatusLinesLock;
+	TMap<int32, FString> PendingStatusLines;
+
+	int32 NumUploading = 0;
+	int32 NextBatch = 0;
+
+	bool LaunchPackaging(int32 JobIndex);
+	void StartUploads();
+
+	/* The package's job in Batch, or its job from an earlier batch that's still going. INDEX_NONE if there's neither */
+	int32 FindJob(const FString& Package, int32 Batch) const;
+	void SetJobState(int32 JobIndex, EWorkshopPackageJobState State, const FString& StatusLine);
+};
@@ -0,0 +1,159 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopPatchAnalyzer.h"
+#include "Misc/Paths.h"
+
+static bool IsPakContainerFile(const FString& Path)
+{
+	const FString Extension = FPaths::GetExtension(Path);
+
+	return Extension == TEXT("pak") || Extension == TEXT("utoc") || Extension == TEXT("ucas") || Extension == TEXT("sig");
+}
+
+int32 FWorkshopPatchReport::GetNumFilesDefeatingDeltaPatching() const
+{
+	int32 NumFiles = 0;
+
+	for (const FWorkshopPatchFileEstimate& File : Files)
+	{
+		if (File.bDefeatsDeltaPatching)
+			++NumFiles;
+	}
+
+	return NumFiles;
+}
+
+FString FWorkshopPatchReport::ToString(int32 MaxFiles) const
+{
+	auto FormatBytes = [](int64 Bytes) { return FText::AsMemory(Bytes).ToString(); };
+
+	FString Report;
+
+	if (!bHasPreviousManifest)
+		Report += TEXT("No manifest from a previous publish of this item, every byte counts as changed.\n");
+
+	Report += FString::Printf(TEXT("Estimated download for subscribers: %s of %s (%.1f%%)\n"), *FormatBytes(ChangedBytes), *FormatBytes(TotalSize),
+		TotalSize > 0 ? 100.0 * ChangedBytes / TotalSize : 0.0);
+
+	if (RemovedBytes > 0)
+		Report += FString::Printf(TEXT("No longer shipped: %s\n"), *FormatBytes(RemovedBytes));
+
+	if (Groups.Num() > 0)
+	{
+		Report += TEXT("\nPer pak:\n");
+
+		for (const FWorkshopPatchGroupEstimate& Group : Groups)
+			Report += FString::Printf(TEXT("  %s: %s changed of %s (%d files)\n"), *Group.Name, *FormatBytes(Group.ChangedBytes), *FormatBytes(Group.Size), Group.NumFiles);
+	}
+
+	Report += TEXT("\nLargest changes:\n");
+
+	for (int32 i = 0; i < Files.Num() && i < MaxFiles; ++i)
+	{
+		const FWorkshopPatchFileEstimate& File = Files[i];
+
+		if (File.ChangedBytes == 0)
+			break;
+
+		Report += FString::Printf(TEXT("  %s: %s of %s%s%s\n"), *File.Path, *FormatBytes(File.ChangedBytes), *FormatBytes(File.Size),
+			File.bNewFile ? TEXT(" [new]") : TEXT(""),
+			File.bDefeatsDeltaPatching ? TEXT(" [layout defeats delta patching]") : TEXT(""));
+	}
+
+	const int32 NumDefeating = GetNumFilesDefeatingDeltaPatching();
+
+	if (NumDefeating > 0)
+	{
+		Report += FString::Printf(TEXT("\n%d file(s) were rewritten almost entirely even though they existed before. For paks this usually means the ")
+			TEXT("file order changed, compression or encryption spans the whole file, or the pak was rebuilt without an order file.\n"), NumDefeating);
+	}
+
+	return Report;
+}
+
+FWorkshopPatchReport FWorkshopPatchAnalyzer::Analyze(const FWorkshopContentManifest& NewManifest, const FWorkshopContentManifest* PreviousManifest)
+{
+	FWorkshopPatchReport Report;
+	Report.bHasPreviousManifest = PreviousManifest != nullptr;
+
+	// Steam dedupes chunks across the whole item, so a chunk is free wherever it was in the previous version
+	TSet<uint64> PreviousChunks;
+	TMap<FString, const FWorkshopManifestFile*> PreviousFiles;
+
+	if (PreviousManifest)
+	{
+		for (const FWorkshopManifestFile& File : PreviousManifest->Files)
+		{
+			PreviousFiles.Add(File.Path, &File);
+
+			for (const FWorkshopChunk& Chunk : File.Chunks)
+				PreviousChunks.Add(Chunk.Hash);
+		}
+	}
+
+	TMap<FString, FWorkshopPatchGroupEstimate> Groups;
+
+	for (const FWorkshopManifestFile& File : NewManifest.Files)
+	{
+		FWorkshopPatchFileEstimate& Estimate = Report.Files.AddDefaulted_GetRef();
+		Estimate.Path = File.Path;
+		Estimate.Size = File.Size;
+
+		const FWorkshopManifestFile* const* PreviousFile = PreviousFiles.Find(File.Path);
+		Estimate.bNewFile = PreviousFile == nullptr;
+
+		if (PreviousFile && (*PreviousFile)->Hash == File.Hash)
+		{
+			PreviousFiles.Remove(File.Path);
+		}
+		else
+		{
+			for (const FWorkshopChunk& Chunk : File.Chunks)
+			{
+				if (!PreviousChunks.Contains(Chunk.Hash))
+					Estimate.ChangedBytes += Chunk.Size;
+			}
+
+			if (PreviousFile)
+			{
+				const float ReusedFraction = File.Size > 0 ? 1.0f - static_cast<float>(Estimate.ChangedBytes) / File.Size : 1.0f;
+				Estimate.bDefeatsDeltaPatching = File.Size >= DeltaCheckMinFileSize && ReusedFraction < DeltaCheckMinReusedFraction;
+
+				PreviousFiles.Remove(File.Path);
+			}
+		}
+
+		Report.TotalSize += Estimate.Size;
+		Report.ChangedBytes += Estimate.ChangedBytes;
+
+		const FString GroupName = IsPakContainerFile(File.Path) ? FPaths::GetBaseFilename(File.Path, false) : FString(TEXT("Loose files"));
+
+		FWorkshopPatchGroupEstimate& Group = Groups.FindOrAdd(GroupName);
+		Group.Name = GroupName;
+		Group.NumFiles++;
+		Group.Size += Estimate.Size;
+		Group.ChangedBytes += Estimate.ChangedBytes;
+	}
+
+	// Whatever is left over was removed
+	for (const TPair<FString, const FWorkshopManifestFile*>& RemovedFile : PreviousFiles)
+		Report.RemovedBytes += RemovedFile.Value->Size;
+
+	Report.Files.Sort([](const FWorkshopPatchFileEstimate& A, const FWorkshopPatchFileEstimate& B) { return A.ChangedBytes > B.ChangedBytes; });
+
+	Groups.GenerateValueArray(Report.Groups);
+	Report.Groups.Sort([](const FWorkshopPatchGroupEstimate& A, const FWorkshopPatchGroupEstimate& B) { return A.ChangedBytes > B.ChangedBytes; });
+
+	return Report;
+}
+
+FWorkshopPatchReport FWorkshopPatchAnalyzer::AnalyzeFolder(const FString& ContentFolder, uint64 PublishedFileId)
+{
+	const FWorkshopContentManifest NewManifest = FWorkshopContentManifest::BuildCached(ContentFolder, FWorkshopContentManifest::GetCachedManifestPath(ContentFolder));
+
+	FWorkshopContentManifest PreviousManifest;
+	// Staged build against staged build, what was uploaded may have been repacked or had shared files split out
+	const bool bHasPrevious = FWorkshopContentManifest::LoadSource(PublishedFileId, PreviousManifest);
+
+	return Analyze(NewManifest, bHasPrevious ? &PreviousManifest : nullptr);
+}
@@ -0,0 +1,62 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopContentManifest.h"
+
+struct FWorkshopPatchFileEstimate
+{
+	FString Path;
+	int64 Size = 0;
+
+	/* Bytes of this file in chunks subscribers don't already have */
+	int64 ChangedBytes = 0;
+
+	bool bNewFile = false;
+
+	/* Changed, but shares almost no chunks with its previous version, so nearly the whole file gets downloaded again */
+	bool bDefeatsDeltaPatching = false;
+};
+
+/* Totals for one pak (its .pak/.utoc/.ucas/.sig files together) or for all loose files */
+struct FWorkshopPatchGroupEstimate
+{
+	FString Name;
+	int32 NumFiles = 0;
+	int64 Size = 0;
+	int64 ChangedBytes = 0;
+};
+
+struct FWorkshopPatchReport
+{
+	bool bHasPreviousManifest = false;
+
+	int64 TotalSize = 0;
+	int64 ChangedBytes = 0;
+	int64 RemovedBytes = 0;
+
+	/* Sorted by changed bytes, largest first */
+	TArray<FWorkshopPatchFileEstimate> Files;
+	TArray<FWorkshopPatchGroupEstimate> Groups;
+
+	int32 GetNumFilesDefeatingDeltaPatching() const;
+
+	/* Human readable summary listing at most MaxFiles files */
+	FString ToString(int32 MaxFiles = 20) const;
+};
+
+/* Predicts how much subscribers will download for an update by comparing chunk hashes with the last published manifest */
+class FWorkshopPatchAnalyzer
+{
+public:
+
+	static FWorkshopPatchReport Analyze(const FWorkshopContentManifest& NewManifest, const FWorkshopContentManifest* PreviousManifest);
+
+	/* Hashes ContentFolder, reusing cached hashes of files that haven't changed, and compares it with the saved manifest for PublishedFileId. Reads files, so call it off the game thread */
+	static FWorkshopPatchReport AnalyzeFolder(const FString& ContentFolder, uint64 PublishedFileId);
+
+	/* Files at least this big that keep less than this fraction of their chunks get flagged */
+	static constexpr int64 DeltaCheckMinFileSize = 1024 * 1024;
+	static constexpr float DeltaCheckMinReusedFraction = 0.1f;
+};
@@ -0,0 +1,242 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopPreviewImages.h"
+#include "WorkshopUploader.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Async/ParallelFor.h"
+
+/* JPEG qualities tried in turn until the image fits */
+static const int32 JpegQualities[] = { 90, 80, 70, 60, 50 };
+
+FString FWorkshopPreviewImages::GetProcessedDir()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Previews"));
+}
+
+bool FWorkshopPreviewImages::ProcessImage(IImageWrapperModule& ImageWrapperModule, const FString& SourcePath, FWorkshopPreview& OutPreview, FString& OutError)
+{
+	TArray<uint8> SourceData;
+	if (!FFileHelper::LoadFileToArray(SourceData, *SourcePath))
+	{
+		OutError = FString::Printf(TEXT("Couldn't read %s"), *SourcePath);
+		return false;
+	}
+
+	// The limits and qualities are hashed along with the source, so changing them doesn't reuse output processed with the old ones
+	FString ProcessingKey = FString::Printf(TEXT("%d|%lld"), MaxDimension, MaxFileSize);
+	for (int32 Quality : JpegQualities)
+		ProcessingKey += FString::Printf(TEXT("|%d"), Quality);
+
+	const FTCHARToUTF8 ProcessingKeyUtf8(*ProcessingKey);
+
+	FSHA1 HashState;
+	HashState.Update(SourceData.GetData(), SourceData.Num());
+	HashState.Update(reinterpret_cast<const uint8*>(ProcessingKeyUtf8.Get()), ProcessingKeyUtf8.Length());
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(Hash.Hash);
+
+	OutPreview.Type = EWorkshopPreviewType::Image;
+	OutPreview.Key = Hash.ToString();
+
+	// Same source processed the same way, same result, nothing to decode
+	const FString ProcessedBase = GetProcessedDir() / OutPreview.Key;
+	for (const TCHAR* Extension : { TEXT(".jpg"), TEXT(".png") })
+	{
+		if (FPaths::FileExists(ProcessedBase + Extension))
+		{
+			OutPreview.Value = ProcessedBase + Extension;
+			return true;
+		}
+	}
+
+	const EImageFormat Format = ImageWrapperModule.DetectImageFormat(SourceData.GetData(), SourceData.Num());
+	TSharedPtr<IImageWrapper> SourceImage = Format != EImageFormat::Invalid ? ImageWrapperModule.CreateImageWrapper(Format) : nullptr;
+
+	if (!SourceImage.IsValid() || !SourceImage->SetCompressed(SourceData.GetData(), SourceData.Num()))
+	{
+		OutError = FString::Printf(TEXT("%s isn't an image that can be read"), *SourcePath);
+		return false;
+	}
+
+	const int32 Width = SourceImage->GetWidth();
+	const int32 Height = SourceImage->GetHeight();
+
+	if (Width <= 0 || Height <= 0)
+	{
+		OutError = FString::Printf(TEXT("%s is empty"), *SourcePath);
+		return false;
+	}
+
+	const bool bIsSteamFormat = Format == EImageFormat::PNG || Format == EImageFormat::JPEG;
+	const bool bFits = FMath::Max(Width, Height) <= MaxDimension && SourceData.Num() <= MaxFileSize;
+
+	// Written under a temporary name so a half written file is never mistaken for a finished one
+	auto SaveProcessed = [&OutPreview, &OutError, &ProcessedBase](const auto& Data, const TCHAR* Extension)
+	{
+		const FString TempPath = ProcessedBase + Extension + TEXT(".tmp");
+
+		if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*(ProcessedBase + Extension), *TempPath))
+		{
+			OutError = FString::Printf(TEXT("Couldn't write %s"), *(ProcessedBase + Extension));
+			return false;
+		}
+
+		OutPreview.Value = ProcessedBase + Extension;
+		return true;
+	};
+
+	if (bIsSteamFormat && bFits)
+		return SaveProcessed(SourceData, Format == EImageFormat::PNG ? TEXT(".png") : TEXT(".jpg"));
+
+	TArray<uint8> RawData;
+	if (!SourceImage->GetRaw(ERGBFormat::BGRA, 8, RawData))
+	{
+		OutError = FString::Printf(TEXT("Couldn't decode %s"), *SourcePath);
+		return false;
+	}
+
+	// BGRA8 is FColor's memory layout
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(Width * Height);
+	FMemory::Memcpy(Pixels.GetData(), RawData.GetData(), Pixels.Num() * sizeof(FColor));
+	RawData.Empty();
+
+	int32 NewWidth = Width;
+	int32 NewHeight = Height;
+
+	if (FMath::Max(Width, Height) > MaxDimension)
+	{
+		const float Scale = static_cast<float>(MaxDimension) / FMath::Max(Width, Height);
+		NewWidth = FMath::Max(1, FMath::RoundToInt(Width * Scale));
+		NewHeight = FMath::Max(1, FMath::RoundToInt(Height * Scale));
+
+		TArray<FColor> Resized;
+		FImageUtils::ImageResize(Width, Height, Pixels, NewWidth, NewHeight, Resized, false);
+		Pixels = MoveTemp(Resized);
+	}
+
+	TSharedPtr<IImageWrapper> Jpeg = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+	if (!Jpeg.IsValid() || !Jpeg->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), NewWidth, NewHeight, ERGBFormat::BGRA, 8))
+	{
+		OutError = FString::Printf(TEXT("Couldn't recompress %s"), *SourcePath);
+		return false;
+	}
+
+	for (int32 Quality : JpegQualities)
+	{
+		const TArray64<uint8> Compressed = Jpeg->GetCompressed(Quality);
+
+		if (Compressed.Num() > 0 && Compressed.Num() <= MaxFileSize)
+			return SaveProcessed(Compressed, TEXT(".jpg"));
+	}
+
+	OutError = FString::Printf(TEXT("%s is still over %s at the lowest quality"), *SourcePath, *FText::AsMemory(MaxFileSize).ToString());
+	return false;
+}
+
+bool FWorkshopPreviewImages::ProcessGallery(IImageWrapperModule& ImageWrapperModule, const TArray<FString>& Entries, TArray<FWorkshopPreview>& OutGallery, TArray<FString>& OutErrors)
+{
+	IFileManager::Get().MakeDirectory(*GetProcessedDir(), true);
+
+	OutGallery.SetNum(Entries.Num());
+	TArray<FString> Errors;
+	Errors.SetNum(Entries.Num());
+
+	// Each image is decoded, scaled and encoded on its own worker, the slowest image sets the pace rather than the sum of them
+	ParallelFor(Entries.Num(), [&ImageWrapperModule, &Entries, &OutGallery, &Errors](int32 Index)
+	{
+		const FString VideoId = GetYouTubeVideoId(Entries[Index]);
+
+		if (!VideoId.IsEmpty())
+		{
+			OutGallery[Index].Type = EWorkshopPreviewType::YouTubeVideo;
+			OutGallery[Index].Value = VideoId;
+			OutGallery[Index].Key = VideoId;
+			return;
+		}
+
+		ProcessImage(ImageWrapperModule, Entries[Index], OutGallery[Index], Errors[Index]);
+	});
+
+	for (const FString& Error : Errors)
+	{
+		if (!Error.IsEmpty())
+			OutErrors.Add(Error);
+	}
+
+	return OutErrors.Num() == 0;
+}
+
+FString FWorkshopPreviewImages::GetYouTubeVideoId(const FString& Entry)
+{
+	FString VideoId;
+
+	int32 Start = Entry.Find(TEXT("youtube.com/watch?v="));
+	if (Start != INDEX_NONE)
+	{
+		VideoId = Entry.Mid(Start + FCString::Strlen(TEXT("youtube.com/watch?v=")));
+	}
+	else if ((Start = Entry.Find(TEXT("youtu.be/"))) != INDEX_NONE)
+	{
+		VideoId = Entry.Mid(Start + FCString::Strlen(TEXT("youtu.be/")));
+	}
+
+	// Drop any other query parameters (&t=, ?si=...)
+	int32 End = INDEX_NONE;
+	if (VideoId.FindChar(TEXT('&'), End) || VideoId.FindChar(TEXT('?'), End))
+		VideoId.LeftInline(End);
+
+	return VideoId.TrimStartAndEnd();
+}
+
+TArray<FWorkshopPreviewChange> FWorkshopPreviewImages::DiffGallery(const TArray<FWorkshopPreview>& Published, const TArray<FWorkshopPreview>& Gallery)
+{
+	TArray<FWorkshopPreviewChange> Changes;
+
+	// Matching positions are skipped and changed ones replaced in place. Steam can't turn an image slot into a video one,
+	// so from the first slot that changes type everything after it is removed and added again in the new order
+	int32 TailStart = FMath::Min(Published.Num(), Gallery.Num());
+
+	for (int32 Index = 0; Index < TailStart; ++Index)
+	{
+		if (Published[Index] == Gallery[Index])
+			continue;
+
+		if (Published[Index].Type != Gallery[Index].Type)
+		{
+			TailStart = Index;
+			break;
+		}
+
+		FWorkshopPreviewChange& Change = Changes.AddDefaulted_GetRef();
+		Change.Action = FWorkshopPreviewChange::EAction::Replace;
+		Change.Index = Index;
+		Change.Preview = Gallery[Index];
+	}
+
+	// Highest first, so removing one doesn't shift the ones still to be removed
+	for (int32 Index = Published.Num() - 1; Index >= TailStart; --Index)
+	{
+		FWorkshopPreviewChange& Change = Changes.AddDefaulted_GetRef();
+		Change.Action = FWorkshopPreviewChange::EAction::Remove;
+		Change.Index = Index;
+	}
+
+	for (int32 Index = TailStart; Index < Gallery.Num(); ++Index)
+	{
+		FWorkshopPreviewChange& Change = Changes.AddDefaulted_GetRef();
+		Change.Action = FWorkshopPreviewChange::EAction::Add;
+		Change.Index = Index;
+		Change.Preview = Gallery[Index];
+	}
+
+	return Changes;
+}
@@ -0,0 +1,35 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopBackend.h"
+
+class IImageWrapperModule;
+
+/**
+ * Gets preview images ready for the Workshop: checked, scaled down and recompressed until they fit Steam's limits.
+ * Results are kept under Saved/WorkshopUploader/Previews by source hash, so an unchanged image is only processed once
+ */
+struct FWorkshopPreviewImages
+{
+	/* Longest edge, larger images are scaled down */
+	static constexpr int32 MaxDimension = 1920;
+
+	/* Steam rejects previews over 1MB */
+	static constexpr int64 MaxFileSize = 1024 * 1024;
+
+	static FString GetProcessedDir();
+
+	/* Processes one image file, blocking. Safe to call from any thread once the ImageWrapper module is loaded */
+	static bool ProcessImage(IImageWrapperModule& ImageWrapperModule, const FString& SourcePath, FWorkshopPreview& OutPreview, FString& OutError);
+
+	/* Turns a draft's gallery entries (image paths or YouTube links) into previews, images are processed in parallel. Blocking */
+	static bool ProcessGallery(IImageWrapperModule& ImageWrapperModule, const TArray<FString>& Entries, TArray<FWorkshopPreview>& OutGallery, TArray<FString>& OutErrors);
+
+	/* YouTube video ID of a youtube.com/watch?v= or youtu.be/ link, empty if Entry isn't one */
+	static FString GetYouTubeVideoId(const FString& Entry);
+
+	/* Changes that turn Published into Gallery, entries that are already in the right place are left alone */
+	static TArray<FWorkshopPreviewChange> DiffGallery(const TArray<FWorkshopPreview>& Published, const TArray<FWorkshopPreview>& Gallery);
+};
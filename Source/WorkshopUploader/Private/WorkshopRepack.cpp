@@ -0,0 +1,586 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopRepack.h"
+#include "WorkshopUploader.h"
+#include "WorkshopContentManifest.h"
+#include "WorkshopStagedContent.h"
+#include "WorkshopBackgroundTasks.h"
+#include "IPlatformFilePak.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/MonitoredProcess.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+
+static const TCHAR* RepackConfigSection = TEXT("WorkshopUploader");
+
+/* Written next to a cache entry's output once every pak in it has been written */
+static const TCHAR* RepackCompleteMarker = TEXT("Repacked.complete");
+
+/* Bump when the output layout changes, so older cache entries aren't reused */
+static const int32 RepackCacheVersion = 1;
+
+/* UnrealPak's error lines are copied into the report, the rest of its output only goes to the log */
+static const int32 MaxErrorsPerRun = 5;
+
+FWorkshopRepackSettings FWorkshopRepackSettings::Load()
+{
+	FWorkshopRepackSettings Settings;
+
+	GConfig->GetBool(RepackConfigSection, TEXT("bRepackStagedContent"), Settings.bEnabled, GGameIni);
+	GConfig->GetString(RepackConfigSection, TEXT("RepackCompressionFormat"), Settings.CompressionFormat, GGameIni);
+	GConfig->GetString(RepackConfigSection, TEXT("RepackArguments"), Settings.Arguments, GGameIni);
+	GConfig->GetInt(RepackConfigSection, TEXT("RepackMinLooseFiles"), Settings.MinLooseFiles, GGameIni);
+	GConfig->GetInt(RepackConfigSection, TEXT("MaxConcurrentRepacks"), Settings.MaxConcurrentRuns, GGameIni);
+	GConfig->GetInt(RepackConfigSection, TEXT("MaxCachedRepacks"), Settings.MaxCachedRepacks, GGameIni);
+
+	return Settings;
+}
+
+FString FWorkshopRepackSettings::GetCacheKey() const
+{
+	return FString::Printf(TEXT("%d;%s;%s;%d"), RepackCacheVersion, *CompressionFormat, *Arguments, MinLooseFiles);
+}
+
+double FWorkshopRepackReport::GetRatio() const
+{
+	return bRepacked && SourceSize > 0 ? (double)OutputSize / (double)SourceSize : 1.0;
+}
+
+FString FWorkshopRepackReport::ToString() const
+{
+	if (!Error.IsEmpty())
+		return FString::Printf(TEXT("Repacking %s failed: %s"), *ContentFolder, *Error);
+
+	if (!bRepacked)
+		return FString::Printf(TEXT("Nothing to repack in %s"), *ContentFolder);
+
+	return FString::Printf(TEXT("Repacked %d loose files and %d paks in %s%s: %s to %s (%.0f%%) in %.1fs"),
+		NumLooseFiles, NumPaks, *ContentFolder, bFromCache ? TEXT(" (cached)") : TEXT(""),
+		*FText::AsMemory(SourceSize).ToString(), *FText::AsMemory(OutputSize).ToString(), GetRatio() * 100.0, Seconds);
+}
+
+static bool IsContainerFile(const FString& Path)
+{
+	return Path.EndsWith(TEXT(".pak")) || Path.EndsWith(TEXT(".utoc")) || Path.EndsWith(TEXT(".ucas")) || Path.EndsWith(TEXT(".sig"));
+}
+
+/* Cooked files outside of any pak, Path is relative to the content folder */
+static bool IsLooseContentFile(const FString& Path)
+{
+	const FString RootedPath = TEXT("/") + Path;
+
+	return !IsContainerFile(Path) && RootedPath.Contains(TEXT("/Content/")) && !RootedPath.Contains(TEXT("/Content/Paks/"));
+}
+
+/* Paks whose every entry was stored without compression, which is what -pak without -compressed stages */
+static bool IsUncompressedPak(IPlatformFile& PlatformFile, const FString& PakPath)
+{
+	// Signed paks and the paks that go with IoStore containers have to stay exactly as they were cooked
+	const FString BasePath = FPaths::ChangeExtension(PakPath, FString());
+	if (FPaths::FileExists(BasePath + TEXT(".sig")) || FPaths::FileExists(BasePath + TEXT(".utoc")))
+		return false;
+
+	// Only the index is read, not the packed files themselves
+	TRefCountPtr<FPakFile> PakFile = new FPakFile(&PlatformFile, *PakPath, false);
+	if (!PakFile->IsValid())
+		return false;
+
+	int32 NumEntries = 0;
+
+	for (FPakFile::FFilenameIterator It(*PakFile); It; ++It)
+	{
+		if (It.Info().CompressionMethodIndex != 0)
+			return false;
+
+		++NumEntries;
+	}
+
+	return NumEntries > 0;
+}
+
+static int64 MeasureFolder(const FString& Folder)
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *Folder, TEXT("*"), true, false);
+
+	int64 Size = 0;
+	for (const FString& File : Files)
+		Size += FMath::Max<int64>(0, IFileManager::Get().FileSize(*File));
+
+	return Size;
+}
+
+static FString GetUnrealPakPath()
+{
+#if PLATFORM_WINDOWS
+	const TCHAR* Executable = TEXT("UnrealPak.exe");
+#else
+	const TCHAR* Executable = TEXT("UnrealPak");
+#endif
+
+	return FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Binaries") / FPlatformProcess::GetBinariesSubdirectory() / Executable);
+}
+
+FWorkshopRepacker::FWorkshopRepacker(TSharedRef<FWorkshopBackgroundTasks> InBackgroundTasks)
+	: Settings(FWorkshopRepackSettings::Load())
+	, BackgroundTasks(InBackgroundTasks)
+{
+}
+
+FWorkshopRepacker::~FWorkshopRepacker()
+{
+	// The processes' output callbacks point at their runs
+	for (const TSharedRef<FRun>& Run : ActiveRuns)
+		Run->Process->Cancel(true);
+
+	ActiveRuns.Empty();
+}
+
+FString FWorkshopRepacker::GetCacheDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Repacked");
+}
+
+TSharedRef<FWorkshopRepackJob> FWorkshopRepacker::Plan(const FString& ContentFolder, const FWorkshopRepackSettings& Settings)
+{
+	TSharedRef<FWorkshopRepackJob> Job = MakeShared<FWorkshopRepackJob>();
+	FWorkshopRepackReport& Report = Job->Report;
+	Report.ContentFolder = ContentFolder;
+	Job->Settings = Settings;
+	Job->StartTime = FPlatformTime::Seconds();
+
+	// Same hash cache the upload uses, so this is only slow for files that changed since they were last hashed
+	const FWorkshopContentManifest Manifest = FWorkshopContentManifest::BuildCached(ContentFolder, FWorkshopContentManifest::GetCachedManifestPath(ContentFolder));
+	Report.SourceSize = Manifest.GetTotalSize();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const FWorkshopManifestFile& File : Manifest.Files)
+	{
+		if (File.Path.EndsWith(TEXT(".pak")) && IsUncompressedPak(PlatformFile, ContentFolder / File.Path))
+			Job->Paks.Add(File.Path);
+		else if (IsLooseContentFile(File.Path))
+			Job->LooseFiles.Add(File.Path);
+		else
+			Job->KeptFiles.Add(File.Path);
+	}
+
+	if (Job->LooseFiles.Num() < Settings.MinLooseFiles)
+	{
+		Job->KeptFiles.Append(Job->LooseFiles);
+		Job->LooseFiles.Empty();
+	}
+
+	if (Job->LooseFiles.Num() == 0 && Job->Paks.Num() == 0)
+		return Job;
+
+	Report.bRepacked = true;
+	Report.NumLooseFiles = Job->LooseFiles.Num();
+	Report.NumPaks = Job->Paks.Num();
+
+	// The same content repacked with the same settings always comes out the same, so it's only done once
+	const FTCHARToUTF8 KeySource(*(Manifest.GetContentHash() + Settings.GetCacheKey()));
+	uint8 KeyHash[20];
+	FSHA1::HashBuffer(KeySource.Get(), KeySource.Length(), KeyHash);
+
+	// The output folder keeps the content folder's name, platform items are told apart by it
+	Report.CacheEntryDir = GetCacheDir() / BytesToHex(KeyHash, sizeof(KeyHash));
+	Report.OutputFolder = Report.CacheEntryDir / FPaths::GetCleanFilename(ContentFolder);
+
+	return Job;
+}
+
+void FWorkshopRepacker::Prepare(FWorkshopRepackJob& Job)
+{
+	FWorkshopRepackReport& Report = Job.Report;
+	const FString& ContentFolder = Report.ContentFolder;
+
+	// Anything left here is from a repack that never finished
+	IFileManager::Get().DeleteDirectory(*Report.CacheEntryDir, false, true);
+
+	// Everything that isn't repacked goes across as it is, spread over the thread pool
+	FCriticalSection FailedLock;
+	TArray<FString> FailedFiles;
+
+	ParallelFor(Job.KeptFiles.Num(), [&](int32 FileIndex)
+	{
+		const FString& Path = Job.KeptFiles[FileIndex];
+
+		if (IFileManager::Get().Copy(*(Report.OutputFolder / Path), *(ContentFolder / Path)) != COPY_OK)
+		{
+			FScopeLock Lock(&FailedLock);
+			FailedFiles.Add(Path);
+		}
+	});
+
+	if (FailedFiles.Num() > 0)
+	{
+		Report.Error = FString::Printf(TEXT("Couldn't copy %s to %s"), *FString::Join(FailedFiles, TEXT(", ")), *Report.OutputFolder);
+		return;
+	}
+
+	// Pak mount points are relative to the staged platform folder, so packed paths start below it
+	const bool bHasPlatformFolders = FWorkshopStagedContent::FindStagedPlatforms(ContentFolder).Num() > 0;
+
+	// One pak per content root, <Root>/Content/Paks/<Root>-Repacked.pak, which is where the game already looks for the mod's own paks
+	TMap<FString, TArray<FString>> LooseFilesByRoot;
+	for (const FString& Path : Job.LooseFiles)
+	{
+		const int32 ContentIndex = (TEXT("/") + Path).Find(TEXT("/Content/"));
+		LooseFilesByRoot.FindOrAdd(Path.Left(ContentIndex + 7)).Add(Path);
+	}
+
+	for (const TPair<FString, TArray<FString>>& Root : LooseFilesByRoot)
+	{
+		FString RootName = FPaths::GetCleanFilename(FPaths::GetPath(Root.Key));
+		if (RootName.IsEmpty())
+			RootName = FPaths::GetCleanFilename(ContentFolder);
+
+		const FString PakPath = FPaths::ConvertRelativePathToFull(Report.OutputFolder / Root.Key / TEXT("Paks") / RootName + TEXT("-Repacked.pak"));
+		const FString ResponsePath = FPaths::ConvertRelativePathToFull(Report.CacheEntryDir / FString::Printf(TEXT("%s-%d.txt"), *RootName, Job.Commands.Num()));
+
+		TArray<FString> ResponseLines;
+		for (const FString& Path : Root.Value)
+		{
+			const FString MountedPath = bHasPlatformFolders ? Path.Mid(Path.Find(TEXT("/")) + 1) : Path;
+			ResponseLines.Add(FString::Printf(TEXT("\"%s\" \"../../../%s\""), *FPaths::ConvertRelativePathToFull(ContentFolder / Path), *MountedPath));
+		}
+
+		if (!FFileHelper::SaveStringArrayToFile(ResponseLines, *ResponsePath))
+		{
+			Report.Error = FString::Printf(TEXT("Couldn't write %s"), *ResponsePath);
+			return;
+		}
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(PakPath), true);
+		Job.Commands.Add(FString::Printf(TEXT("\"%s\" -create=\"%s\" -compress -compressionformats=%s %s"), *PakPath, *ResponsePath, *Job.Settings.CompressionFormat, *Job.Settings.Arguments));
+	}
+
+	for (const FString& Path : Job.Paks)
+	{
+		const FString OutputPath = FPaths::ConvertRelativePathToFull(Report.OutputFolder / Path);
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+		Job.Commands.Add(FString::Printf(TEXT("\"%s\" -repack -output=\"%s\" -compress -compressionformats=%s %s"),
+			*FPaths::ConvertRelativePathToFull(ContentFolder / Path), *OutputPath, *Job.Settings.CompressionFormat, *Job.Settings.Arguments));
+	}
+}
+
+void FWorkshopRepacker::Repack(const FString& ContentFolder, TFunction<void(const FWorkshopRepackReport& Report)> OnComplete)
+{
+	const FWorkshopRepackSettings JobSettings = Settings;
+	TSharedRef<TSharedPtr<FWorkshopRepackJob>> Job = MakeShared<TSharedPtr<FWorkshopRepackJob>>();
+
+	RunOnThreadPool([ContentFolder, JobSettings, Job]()
+	{
+		*Job = Plan(ContentFolder, JobSettings);
+	},
+	[this, Job, OnComplete]()
+	{
+		Acquire(Job->ToSharedRef(), OnComplete);
+	});
+}
+
+void FWorkshopRepacker::Unpin(const FString& CacheEntryDir)
+{
+	FCacheEntry* Entry = CacheEntries.Find(CacheEntryDir);
+	if (Entry == nullptr || Entry->NumPins == 0)
+		return;
+
+	if (--Entry->NumPins == 0 && !Entry->bBusy)
+		CacheEntries.Remove(CacheEntryDir);
+}
+
+void FWorkshopRepacker::RunOnThreadPool(TFunction<void()> Work, TFunction<void()> OnComplete)
+{
+	++NumPendingTasks;
+
+	BackgroundTasks->Run(MoveTemp(Work), [this, OnComplete]()
+	{
+		--NumPendingTasks;
+		OnComplete();
+	});
+}
+
+void FWorkshopRepacker::Acquire(TSharedRef<FWorkshopRepackJob> Job, FOnRepacked OnComplete)
+{
+	const FWorkshopRepackReport& Report = Job->Report;
+
+	if (!Report.bRepacked)
+	{
+		Finish(Job, OnComplete);
+		return;
+	}
+
+	FCacheEntry& Entry = CacheEntries.FindOrAdd(Report.CacheEntryDir);
+
+	// Two mods staged the same way, or the same mod published twice, would otherwise write the same entry at once
+	if (Entry.bBusy)
+	{
+		Entry.Waiting.Add([this, Job, OnComplete]() { Acquire(Job, OnComplete); });
+		return;
+	}
+
+	// Pinned from here on, so the entry can't be pruned between being found and being uploaded
+	++Entry.NumPins;
+
+	const FString MarkerPath = Report.CacheEntryDir / RepackCompleteMarker;
+
+	if (FPaths::FileExists(MarkerPath))
+	{
+		RunOnThreadPool([Job, MarkerPath]()
+		{
+			// Touched so the entry counts as recently used when the cache is pruned
+			IFileManager::Get().SetTimeStamp(*MarkerPath, FDateTime::UtcNow());
+
+			Job->Report.bFromCache = true;
+			Job->Report.OutputSize = MeasureFolder(Job->Report.OutputFolder);
+		},
+		[this, Job, OnComplete]()
+		{
+			Finish(Job, OnComplete);
+		});
+
+		return;
+	}
+
+	Entry.bBusy = true;
+
+	// Room is made for the entry about to be written
+	const TArray<FString> PrunedEntries = ClaimPrunableEntries(Job->Settings.MaxCachedRepacks - 1);
+
+	RunOnThreadPool([Job, PrunedEntries]()
+	{
+		for (const FString& PrunedEntry : PrunedEntries)
+		{
+			UE_LOG(LogWorkshopUploader, Log, TEXT("Removing repacked content %s from the cache"), *FPaths::GetCleanFilename(PrunedEntry));
+			IFileManager::Get().DeleteDirectory(*PrunedEntry, false, true);
+		}
+
+		Prepare(*Job);
+	},
+	[this, Job, PrunedEntries, OnComplete]()
+	{
+		for (const FString& PrunedEntry : PrunedEntries)
+			ReleaseEntry(PrunedEntry);
+
+		Run(Job, OnComplete);
+	});
+}
+
+TArray<FString> FWorkshopRepacker::ClaimPrunableEntries(int32 MaxEntries)
+{
+	const FString CacheDir = GetCacheDir();
+
+	TArray<FString> EntryNames;
+	IFileManager::Get().FindFiles(EntryNames, *(CacheDir / TEXT("*")), false, true);
+
+	// Entries still being written have no marker yet and are left alone
+	TArray<TPair<FDateTime, FString>> Entries;
+	for (const FString& EntryName : EntryNames)
+	{
+		const FString MarkerPath = CacheDir / EntryName / RepackCompleteMarker;
+		if (FPaths::FileExists(MarkerPath))
+			Entries.Add(TPair<FDateTime, FString>(IFileManager::Get().GetTimeStamp(*MarkerPath), CacheDir / EntryName));
+	}
+
+	Entries.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) { return A.Key > B.Key; });
+
+	TArray<FString> ClaimedEntries;
+
+	for (int32 EntryIndex = FMath::Max(0, MaxEntries); EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		// Entries that are pinned or being waited on stay, the cache can go over its limit until they're released
+		if (CacheEntries.Contains(Entries[EntryIndex].Value))
+			continue;
+
+		CacheEntries.Add(Entries[EntryIndex].Value).bBusy = true;
+		ClaimedEntries.Add(Entries[EntryIndex].Value);
+	}
+
+	return ClaimedEntries;
+}
+
+void FWorkshopRepacker::ReleaseEntry(const FString& CacheEntryDir)
+{
+	FCacheEntry* Entry = CacheEntries.Find(CacheEntryDir);
+	if (Entry == nullptr)
+		return;
+
+	TArray<TFunction<void()>> Waiting = MoveTemp(Entry->Waiting);
+
+	Entry->bBusy = false;
+	Entry->Waiting.Reset();
+
+	if (Entry->NumPins == 0)
+		CacheEntries.Remove(CacheEntryDir);
+
+	// The first to resume finds the entry complete and reuses it, or claims it to write it again if this attempt failed
+	for (TFunction<void()>& Resume : Waiting)
+		Resume();
+}
+
+void FWorkshopRepacker::Run(TSharedRef<FWorkshopRepackJob> Job, FOnRepacked OnComplete)
+{
+	if (!Job->Report.Error.IsEmpty() || Job->Commands.Num() == 0)
+	{
+		FinishWrite(Job, OnComplete);
+		return;
+	}
+
+	TSharedPtr<FRepack> Repack = MakeShared<FRepack>();
+	Repack->Job = Job;
+	Repack->OnComplete = MoveTemp(OnComplete);
+	Repack->NumPending = Job->Commands.Num();
+
+	for (const FString& Command : Job->Commands)
+	{
+		TSharedRef<FRun> Run = MakeShared<FRun>();
+		Run->Repack = Repack;
+		Run->Arguments = Command;
+
+		QueuedRuns.Add(Run);
+	}
+
+	Tick();
+}
+
+void FWorkshopRepacker::FinishWrite(const TSharedRef<FWorkshopRepackJob>& Job, const FOnRepacked& OnComplete)
+{
+	// Measuring every pak that was written, or deleting them all, is left to the thread pool. The entry stays busy until it's done
+	RunOnThreadPool([Job]()
+	{
+		FWorkshopRepackReport& Report = Job->Report;
+
+		if (Report.Error.IsEmpty())
+		{
+			Report.OutputSize = MeasureFolder(Report.OutputFolder);
+
+			// Written last, an entry is only reused once every pak in it is whole
+			FFileHelper::SaveStringToFile(Report.ContentFolder, *(Report.CacheEntryDir / RepackCompleteMarker));
+		}
+		else
+		{
+			IFileManager::Get().DeleteDirectory(*Report.CacheEntryDir, false, true);
+		}
+	},
+	[this, Job, OnComplete]()
+	{
+		ReleaseEntry(Job->Report.CacheEntryDir);
+		Finish(Job, OnComplete);
+	});
+}
+
+void FWorkshopRepacker::Finish(const TSharedRef<FWorkshopRepackJob>& Job, const FOnRepacked& OnComplete)
+{
+	FWorkshopRepackReport& Report = Job->Report;
+	Report.Seconds = FPlatformTime::Seconds() - Job->StartTime;
+
+	if (Report.bRepacked || !Report.Error.IsEmpty())
+		UE_LOG(LogWorkshopUploader, Log, TEXT("%s"), *Report.ToString());
+
+	// A failed repack leaves nothing to upload, so there's nothing to keep pinned
+	if (Report.bRepacked && !Report.Error.IsEmpty())
+		Unpin(Report.CacheEntryDir);
+
+	OnComplete(Report);
+}
+
+void FWorkshopRepacker::Tick()
+{
+	// Completing a repack can queue more, so collect the finished runs first
+	TArray<TSharedRef<FRun>> FinishedRuns;
+
+	for (int32 RunIndex = ActiveRuns.Num() - 1; RunIndex >= 0; --RunIndex)
+	{
+		if (ActiveRuns[RunIndex]->Process->IsRunning())
+			continue;
+
+		FinishedRuns.Insert(ActiveRuns[RunIndex], 0);
+		ActiveRuns.RemoveAt(RunIndex);
+	}
+
+	while (QueuedRuns.Num() > 0 && ActiveRuns.Num() < FMath::Max(1, Settings.MaxConcurrentRuns))
+	{
+		TSharedRef<FRun> Run = QueuedRuns[0];
+		QueuedRuns.RemoveAt(0);
+
+		if (Launch(Run))
+			ActiveRuns.Add(Run);
+		else
+			FinishedRuns.Add(Run);
+	}
+
+	for (const TSharedRef<FRun>& Run : FinishedRuns)
+		FinishRun(Run, Run->Process.IsValid() ? Run->Process->GetReturnCode() : -1);
+}
+
+bool FWorkshopRepacker::Launch(const TSharedRef<FRun>& Run)
+{
+	const FString UnrealPakPath = GetUnrealPakPath();
+	if (!FPaths::FileExists(UnrealPakPath))
+		return false;
+
+	Run->Process = MakeShared<FMonitoredProcess>(UnrealPakPath, Run->Arguments, true);
+
+	FRun* RunPtr = &Run.Get();
+	Run->Process->OnOutput().BindLambda([RunPtr](FString Output)
+	{
+		UE_LOG(LogWorkshopUploader, Verbose, TEXT("[Repack] %s"), *Output);
+
+		FScopeLock Lock(&RunPtr->OutputLock);
+		RunPtr->Output.Add(MoveTemp(Output));
+	});
+
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Repacking %s: %s %s"), *Run->Repack->Job->Report.ContentFolder, *UnrealPakPath, *Run->Arguments);
+
+	if (!Run->Process->Launch())
+	{
+		Run->Process.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FWorkshopRepacker::FinishRun(const TSharedRef<FRun>& Run, int32 ReturnCode)
+{
+	TSharedPtr<FRepack> Repack = Run->Repack;
+	FWorkshopRepackReport& Report = Repack->Job->Report;
+
+	TArray<FString> Output;
+	{
+		FScopeLock Lock(&Run->OutputLock);
+		Output = MoveTemp(Run->Output);
+	}
+
+	if (!Run->Process.IsValid())
+	{
+		Report.Error += FString::Printf(TEXT("Couldn't launch %s\n"), *GetUnrealPakPath());
+	}
+	else if (ReturnCode != 0)
+	{
+		Report.Error += FString::Printf(TEXT("UnrealPak exited with code %d\n"), ReturnCode);
+
+		int32 NumErrors = 0;
+		for (const FString& Line : Output)
+		{
+			if (Line.Contains(TEXT("Error")) && NumErrors++ < MaxErrorsPerRun)
+				Report.Error += FString::Printf(TEXT("    %s\n"), *Line.TrimStartAndEnd());
+		}
+	}
+
+	Run->Process.Reset();
+	Run->Repack.Reset();
+
+	if (--Repack->NumPending > 0)
+		return;
+
+	FinishWrite(Repack->Job.ToSharedRef(), Repack->OnComplete);
+}
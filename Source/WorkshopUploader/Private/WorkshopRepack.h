@@ -0,0 +1,203 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+class FMonitoredProcess;
+class FWorkshopBackgroundTasks;
+
+/**
+ * How staged content is repacked before it's uploaded, read from the [WorkshopUploader] section of the project's game config:
+ *
+ *   bRepackStagedContent=True
+ *   RepackCompressionFormat=Zlib
+ *   RepackArguments=-compresslevel=4
+ *
+ * Repacking is off by default. Mods staged with loose files or uncompressed paks are packed again with UnrealPak into
+ * compressed paks, so subscribers download and mount fewer, smaller files
+ */
+struct FWorkshopRepackSettings
+{
+	bool bEnabled = false;
+
+	/* What -compressionformats is given, Oodle ships with UE5 and Zlib works everywhere */
+#if ENGINE_MAJOR_VERSION >= 5
+	FString CompressionFormat = TEXT("Oodle");
+#else
+	FString CompressionFormat = TEXT("Zlib");
+#endif
+
+	/* Added to every UnrealPak command line, e.g. -compresslevel */
+	FString Arguments;
+
+	/* Loose files are only packed when a mod has at least this many, a handful of config files aren't worth a pak */
+	int32 MinLooseFiles = 20;
+
+	/* Every UnrealPak run already compresses on all cores, this many at once across every mod being repacked */
+	int32 MaxConcurrentRuns = 2;
+
+	/* Repacked content is kept by content hash, older entries beyond this many are deleted */
+	int32 MaxCachedRepacks = 8;
+
+	/* Repacks made with different settings don't share a cache entry */
+	FString GetCacheKey() const;
+
+	static FWorkshopRepackSettings Load();
+};
+
+struct FWorkshopRepackReport
+{
+	FString ContentFolder;
+
+	/* What should be uploaded instead of ContentFolder, empty if nothing was repacked */
+	FString OutputFolder;
+
+	/* Cache entry OutputFolder is in, what FWorkshopRepacker::Unpin is given once the output isn't needed any more */
+	FString CacheEntryDir;
+
+	/* False if nothing needed repacking, ContentFolder is uploaded as it is then */
+	bool bRepacked = false;
+
+	/* The same content was repacked with the same settings before, nothing was run */
+	bool bFromCache = false;
+
+	int32 NumLooseFiles = 0;
+	int32 NumPaks = 0;
+
+	int64 SourceSize = 0;
+	int64 OutputSize = 0;
+	double Seconds = 0.0;
+
+	/* Empty if the repack worked, ContentFolder shouldn't be uploaded in place of a failed repack */
+	FString Error;
+
+	/* Output size over source size, 1 if nothing was repacked */
+	double GetRatio() const;
+
+	FString ToString() const;
+};
+
+/* What FWorkshopRepacker::Plan works out and Prepare leaves for UnrealPak */
+struct FWorkshopRepackJob
+{
+	FWorkshopRepackReport Report;
+
+	/* What it was planned with, it's prepared with the same */
+	FWorkshopRepackSettings Settings;
+
+	/* Relative to the content folder */
+	TArray<FString> LooseFiles;
+	TArray<FString> Paks;
+	TArray<FString> KeptFiles;
+
+	/* One UnrealPak command line per pak that's written */
+	TArray<FString> Commands;
+
+	double StartTime = 0.0;
+};
+
+/**
+ * Consolidates a mod's staged content into compressed paks before it's uploaded. Loose cooked files are packed into
+ * one pak per content root and paks stored without compression are repacked, everything else is copied across as it
+ * is. IoStore containers and signed paks are never touched, they can't be rebuilt without the cook that made them.
+ * Output is cached by the content's hash, so publishing the same build again doesn't run UnrealPak again
+ */
+class FWorkshopRepacker
+{
+public:
+
+	/* Planning, copying and measuring run on BackgroundTasks, whose owner ticks it */
+	explicit FWorkshopRepacker(TSharedRef<FWorkshopBackgroundTasks> InBackgroundTasks);
+	~FWorkshopRepacker();
+
+	FWorkshopRepackSettings Settings;
+
+	/* Saved/WorkshopUploader/Repacked */
+	static FString GetCacheDir();
+
+	/* Hashes the content and works out what needs repacking and which cache entry it goes in, without writing anything. Reads files, so call it off the game thread */
+	static TSharedRef<FWorkshopRepackJob> Plan(const FString& ContentFolder, const FWorkshopRepackSettings& Settings);
+
+	/* Copies what isn't repacked into the job's cache entry and writes UnrealPak's response files. Only run for an entry nothing else is using */
+	static void Prepare(FWorkshopRepackJob& Job);
+
+	/**
+	 * Repacks ContentFolder, or reuses the cache entry it was repacked into before, OnComplete is called from Tick.
+	 * The same content is only ever written by one repack at a time, others wait for it and then reuse its output.
+	 * A repacked report's entry is pinned, it isn't pruned from the cache until Unpin is called with its CacheEntryDir
+	 */
+	void Repack(const FString& ContentFolder, TFunction<void(const FWorkshopRepackReport& Report)> OnComplete);
+	void Unpin(const FString& CacheEntryDir);
+
+	void Tick();
+
+	bool IsRunning() const { return NumPendingTasks > 0 || QueuedRuns.Num() > 0 || ActiveRuns.Num() > 0; }
+
+private:
+
+	typedef TFunction<void(const FWorkshopRepackReport& Report)> FOnRepacked;
+
+	/* Cache entries in use, only ever touched on the game thread */
+	struct FCacheEntry
+	{
+		/* Repacks whose output is still being tested or uploaded */
+		int32 NumPins = 0;
+
+		/* Being written or deleted, nothing else can use it until it's done */
+		bool bBusy = false;
+
+		/* Repacks of the same content, resumed once the entry isn't busy */
+		TArray<TFunction<void()>> Waiting;
+	};
+
+	TMap<FString, FCacheEntry> CacheEntries;
+
+	TSharedRef<FWorkshopBackgroundTasks> BackgroundTasks;
+	int32 NumPendingTasks = 0;
+
+	/* BackgroundTasks->Run, counted so IsRunning knows about work still on the thread pool */
+	void RunOnThreadPool(TFunction<void()> Work, TFunction<void()> OnComplete);
+
+	/* Claims the job's cache entry: reuses it if it's complete, waits if another repack is writing it and writes it otherwise */
+	void Acquire(TSharedRef<FWorkshopRepackJob> Job, FOnRepacked OnComplete);
+
+	/* Complete entries beyond the newest MaxEntries that nothing is using, marked busy so nothing starts using them while they're deleted */
+	TArray<FString> ClaimPrunableEntries(int32 MaxEntries);
+
+	/* Lets the next repack waiting on the entry have it, and forgets the entry once nothing needs it */
+	void ReleaseEntry(const FString& CacheEntryDir);
+
+	/* Runs the job's UnrealPak commands, then marks the entry complete (or deletes it if they failed) and releases it */
+	void Run(TSharedRef<FWorkshopRepackJob> Job, FOnRepacked OnComplete);
+	void FinishWrite(const TSharedRef<FWorkshopRepackJob>& Job, const FOnRepacked& OnComplete);
+	void Finish(const TSharedRef<FWorkshopRepackJob>& Job, const FOnRepacked& OnComplete);
+
+	struct FRepack
+	{
+		TSharedPtr<FWorkshopRepackJob> Job;
+		FOnRepacked OnComplete;
+		int32 NumPending = 0;
+	};
+
+	struct FRun
+	{
+		TSharedPtr<FRepack> Repack;
+		FString Arguments;
+		TSharedPtr<FMonitoredProcess> Process;
+
+		/* Filled on the process' own thread */
+		FCriticalSection OutputLock;
+		TArray<FString> Output;
+	};
+
+	TArray<TSharedRef<FRun>> QueuedRuns;
+	TArray<TSharedRef<FRun>> ActiveRuns;
+
+	bool Launch(const TSharedRef<FRun>& Run);
+
+	/* Records how the run ended, then measures the output and marks the cache entry complete if it was the last run */
+	void FinishRun(const TSharedRef<FRun>& Run, int32 ReturnCode);
+};
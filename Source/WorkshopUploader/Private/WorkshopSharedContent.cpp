@@ -0,0 +1,341 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopSharedContent.h"
+#include "WorkshopUploader.h"
+#include "WorkshopContentManifest.h"
+#include "WorkshopStagedContent.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+/* Bump when the saved layout changes */
+static const int32 SharedContentFileVersion = 2;
+
+static FString GetSharedContentPlanPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("SharedContent.json");
+}
+
+FString FWorkshopDedupReport::ToString(int32 MaxFiles) const
+{
+	auto FormatBytes = [](int64 Bytes) { return FText::AsMemory(Bytes).ToString(); };
+
+	FString Report = FString::Printf(TEXT("%d mods, %s staged in total\n"), Packages.Num(), *FormatBytes(TotalBytes));
+	Report += FString::Printf(TEXT("Identical files in more than one mod: %s could be moved into a shared item (%d files)\n"), *FormatBytes(DuplicatedFileBytes), SharedFiles.Num());
+	Report += FString::Printf(TEXT("Also duplicated inside files that differ: %s (needs the shared assets cooked into their own pak first)\n"), *FormatBytes(DuplicatedChunkBytes));
+
+	if (SharedFiles.Num() > 0)
+		Report += TEXT("\nLargest duplicates:\n");
+
+	for (int32 i = 0; i < SharedFiles.Num() && i < MaxFiles; ++i)
+	{
+		const FWorkshopSharedFile& File = SharedFiles[i];
+		Report += FString::Printf(TEXT("  %s: %s x%d (%s)\n"), *File.Path, *FormatBytes(File.Size), File.Packages.Num(), *FString::Join(File.Packages, TEXT(", ")));
+	}
+
+	return Report;
+}
+
+FWorkshopDedupReport FWorkshopSharedContent::Analyze(const TArray<FString>& Packages)
+{
+	FWorkshopDedupReport Report;
+	Report.Packages = Packages;
+
+	// Each manifest already hashes its files in parallel, and only files that changed since the last run get read
+	TArray<FWorkshopContentManifest> Manifests;
+	for (const FString& Package : Packages)
+		Manifests.Add(FWorkshopContentManifest::BuildCached(FWorkshopStagedContent::GetStagedBuildsDir(Package), FWorkshopContentManifest::GetStagedManifestPath(Package)));
+
+	TMap<FString, FWorkshopSharedFile> FilesByKey;
+	TMap<uint64, int32> ChunkOwners;
+	TMap<uint64, uint32> ChunkSizes;
+
+	for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); ++PackageIndex)
+	{
+		TSet<uint64> PackageChunks;
+		const TArray<FString> Platforms = FWorkshopStagedContent::FindStagedPlatforms(FWorkshopStagedContent::GetStagedBuildsDir(Packages[PackageIndex]));
+
+		for (const FWorkshopManifestFile& File : Manifests[PackageIndex].Files)
+		{
+			Report.TotalBytes += File.Size;
+
+			// Loose files are looked up by path at runtime, so they can only be shared where the path matches too
+			FWorkshopSharedFile& SharedFile = FilesByKey.FindOrAdd(File.Path + TEXT("|") + File.Hash);
+			SharedFile.Path = File.Path;
+			SharedFile.Hash = File.Hash;
+			SharedFile.Size = File.Size;
+			SharedFile.Packages.Add(Packages[PackageIndex]);
+
+			FString Platform;
+			if (File.Path.Split(TEXT("/"), &Platform, nullptr) && Platforms.Contains(Platform))
+				SharedFile.Platform = Platform;
+
+			for (const FWorkshopChunk& Chunk : File.Chunks)
+			{
+				PackageChunks.Add(Chunk.Hash);
+				ChunkSizes.Add(Chunk.Hash, Chunk.Size);
+			}
+		}
+
+		for (uint64 Chunk : PackageChunks)
+			ChunkOwners.FindOrAdd(Chunk)++;
+	}
+
+	int64 AllDuplicatedChunkBytes = 0;
+	for (const TPair<uint64, int32>& Chunk : ChunkOwners)
+		AllDuplicatedChunkBytes += static_cast<int64>(ChunkSizes.FindRef(Chunk.Key)) * (Chunk.Value - 1);
+
+	for (TPair<FString, FWorkshopSharedFile>& Entry : FilesByKey)
+	{
+		if (Entry.Value.Packages.Num() < 2)
+			continue;
+
+		Report.DuplicatedFileBytes += Entry.Value.GetDuplicatedBytes();
+		Report.SharedFiles.Add(MoveTemp(Entry.Value));
+	}
+
+	// Whole duplicated files are made of duplicated chunks as well, don't count them twice
+	Report.DuplicatedChunkBytes = FMath::Max<int64>(0, AllDuplicatedChunkBytes - Report.DuplicatedFileBytes);
+
+	Report.SharedFiles.Sort([](const FWorkshopSharedFile& A, const FWorkshopSharedFile& B) { return A.GetDuplicatedBytes() > B.GetDuplicatedBytes(); });
+
+	return Report;
+}
+
+FWorkshopSharedContentPlan FWorkshopSharedContent::MakePlan(const FWorkshopDedupReport& Report, int64 MinFileSize)
+{
+	FWorkshopSharedContentPlan Plan;
+
+	FWorkshopSharedContentPlan PreviousPlan;
+	FWorkshopSharedContentPlan::Load(PreviousPlan);
+
+	for (const FWorkshopSharedFile& File : Report.SharedFiles)
+	{
+		if (File.Size < MinFileSize)
+			continue;
+
+		Plan.Files.Add(File);
+
+		for (const FString& Package : File.Packages)
+			Plan.Packages.AddUnique(Package);
+
+		if (Plan.FindItem(File.Platform) != nullptr)
+			continue;
+
+		// Keep the existing shared items so a new split updates them instead of creating more. They hold the old files until this plan is published
+		FWorkshopSharedItem& Item = Plan.Items.AddDefaulted_GetRef();
+		Item.Platform = File.Platform;
+
+		if (const FWorkshopSharedItem* PreviousItem = PreviousPlan.FindItem(File.Platform))
+			Item.PublishedFileId = PreviousItem->PublishedFileId;
+	}
+
+	Plan.Packages.Sort();
+	Plan.Items.Sort([](const FWorkshopSharedItem& A, const FWorkshopSharedItem& B) { return A.Platform < B.Platform; });
+
+	return Plan;
+}
+
+bool FWorkshopSharedContent::StageSharedItem(const FWorkshopSharedContentPlan& Plan, const FString& Platform)
+{
+	const FString StagingDir = FWorkshopSharedContentPlan::GetSharedStagingDir(Platform);
+	IFileManager::Get().DeleteDirectory(*StagingDir, false, true);
+
+	for (const FWorkshopSharedFile& File : Plan.Files)
+	{
+		if (File.Platform != Platform)
+			continue;
+
+		const FString SourcePath = FWorkshopStagedContent::GetStagedBuildsDir(File.Packages[0]) / File.Path;
+
+		if (IFileManager::Get().Copy(*(StagingDir / File.GetPlatformPath()), *SourcePath) != COPY_OK)
+		{
+			UE_LOG(LogWorkshopUploader, Error, TEXT("Couldn't copy %s into the shared item"), *SourcePath);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FWorkshopSharedContent::StageDependent(const FWorkshopSharedContentPlan& Plan, const FString& Package, const FString& StagedBuildsDir)
+{
+	const FString StagingDir = FWorkshopSharedContentPlan::GetStagingDir(Package);
+
+	// Shared files are matched by hash as well as path, a mod that changed its copy keeps it. So does a repacked mod for files that went into a new pak.
+	// Files whose platform's shared item never got them stay in the mod
+	const TMap<FString, uint64> PublishedItems = Plan.GetPublishedItems();
+
+	TSet<FString> SharedFiles;
+	for (const FWorkshopSharedFile& File : Plan.Files)
+	{
+		if (File.Packages.Contains(Package) && PublishedItems.Contains(File.Platform))
+			SharedFiles.Add(File.Path + TEXT("|") + File.Hash);
+	}
+
+	const bool bIsStagedBuild = FPaths::IsSamePath(StagedBuildsDir, FWorkshopStagedContent::GetStagedBuildsDir(Package));
+	const FWorkshopContentManifest Manifest = FWorkshopContentManifest::BuildCached(StagedBuildsDir, bIsStagedBuild ? FWorkshopContentManifest::GetStagedManifestPath(Package) : FWorkshopContentManifest::GetCachedManifestPath(StagedBuildsDir));
+
+	IFileManager::Get().DeleteDirectory(*StagingDir, false, true);
+
+	for (const FWorkshopManifestFile& File : Manifest.Files)
+	{
+		if (SharedFiles.Contains(File.Path + TEXT("|") + File.Hash))
+			continue;
+
+		if (IFileManager::Get().Copy(*(StagingDir / File.Path), *(StagedBuildsDir / File.Path)) != COPY_OK)
+		{
+			UE_LOG(LogWorkshopUploader, Error, TEXT("Couldn't stage %s for %s"), *File.Path, *Package);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FWorkshopSharedItem* FWorkshopSharedContentPlan::FindItem(const FString& Platform)
+{
+	return Items.FindByPredicate([&Platform](const FWorkshopSharedItem& Item) { return Item.Platform == Platform; });
+}
+
+TMap<FString, uint64> FWorkshopSharedContentPlan::GetPublishedItems() const
+{
+	TMap<FString, uint64> PublishedItems;
+
+	for (const FWorkshopSharedItem& Item : Items)
+	{
+		if (Item.bPublished && Item.PublishedFileId != 0)
+			PublishedItems.Add(Item.Platform, Item.PublishedFileId);
+	}
+
+	return PublishedItems;
+}
+
+FString FWorkshopSharedContentPlan::GetDependentContentDir(const FString& Package, const FString& StagedBuildsDir, bool bSharedItemsApp) const
+{
+	if (!bSharedItemsApp || !Packages.Contains(Package) || GetPublishedItems().Num() == 0)
+		return StagedBuildsDir;
+
+	return GetStagingDir(Package);
+}
+
+bool FWorkshopSharedContentPlan::Save() const
+{
+	TArray<TSharedPtr<FJsonValue>> FileValues;
+
+	for (const FWorkshopSharedFile& File : Files)
+	{
+		TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+		FileObject->SetStringField(TEXT("path"), File.Path);
+		FileObject->SetStringField(TEXT("hash"), File.Hash);
+		FileObject->SetStringField(TEXT("size"), LexToString(File.Size));
+		FileObject->SetStringField(TEXT("platform"), File.Platform);
+
+		TArray<TSharedPtr<FJsonValue>> PackageValues;
+		for (const FString& Package : File.Packages)
+			PackageValues.Add(MakeShared<FJsonValueString>(Package));
+		FileObject->SetArrayField(TEXT("packages"), PackageValues);
+
+		FileValues.Add(MakeShared<FJsonValueObject>(FileObject));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ItemValues;
+
+	for (const FWorkshopSharedItem& Item : Items)
+	{
+		TSharedRef<FJsonObject> ItemObject = MakeShared<FJsonObject>();
+		ItemObject->SetStringField(TEXT("platform"), Item.Platform);
+		ItemObject->SetStringField(TEXT("publishedFileId"), LexToString(Item.PublishedFileId));
+		ItemObject->SetBoolField(TEXT("published"), Item.bPublished);
+
+		ItemValues.Add(MakeShared<FJsonValueObject>(ItemObject));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> PackageValues;
+	for (const FString& Package : Packages)
+		PackageValues.Add(MakeShared<FJsonValueString>(Package));
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("version"), SharedContentFileVersion);
+	RootObject->SetArrayField(TEXT("items"), ItemValues);
+	RootObject->SetArrayField(TEXT("packages"), PackageValues);
+	RootObject->SetArrayField(TEXT("files"), FileValues);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+	return FJsonSerializer::Serialize(RootObject, Writer) && FFileHelper::SaveStringToFile(JsonString, *GetSharedContentPlanPath());
+}
+
+bool FWorkshopSharedContentPlan::Load(FWorkshopSharedContentPlan& OutPlan)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetSharedContentPlanPath()))
+		return false;
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		return false;
+
+	int32 Version = 0;
+	if (!RootObject->TryGetNumberField(TEXT("version"), Version) || Version != SharedContentFileVersion)
+		return false;
+
+	OutPlan = FWorkshopSharedContentPlan();
+	RootObject->TryGetStringArrayField(TEXT("packages"), OutPlan.Packages);
+
+	const TArray<TSharedPtr<FJsonValue>>* ItemValues = nullptr;
+	if (RootObject->TryGetArrayField(TEXT("items"), ItemValues))
+	{
+		for (const TSharedPtr<FJsonValue>& ItemValue : *ItemValues)
+		{
+			const TSharedPtr<FJsonObject>& ItemObject = ItemValue->AsObject();
+			if (!ItemObject.IsValid())
+				continue;
+
+			FWorkshopSharedItem& Item = OutPlan.Items.AddDefaulted_GetRef();
+			Item.Platform = ItemObject->GetStringField(TEXT("platform"));
+			Item.PublishedFileId = FCString::Strtoui64(*ItemObject->GetStringField(TEXT("publishedFileId")), nullptr, 10);
+			ItemObject->TryGetBoolField(TEXT("published"), Item.bPublished);
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* FileValues = nullptr;
+	if (RootObject->TryGetArrayField(TEXT("files"), FileValues))
+	{
+		for (const TSharedPtr<FJsonValue>& FileValue : *FileValues)
+		{
+			const TSharedPtr<FJsonObject>& FileObject = FileValue->AsObject();
+			if (!FileObject.IsValid())
+				continue;
+
+			FWorkshopSharedFile& File = OutPlan.Files.AddDefaulted_GetRef();
+			File.Path = FileObject->GetStringField(TEXT("path"));
+			File.Hash = FileObject->GetStringField(TEXT("hash"));
+			LexFromString(File.Size, *FileObject->GetStringField(TEXT("size")));
+			FileObject->TryGetStringField(TEXT("platform"), File.Platform);
+			FileObject->TryGetStringArrayField(TEXT("packages"), File.Packages);
+		}
+	}
+
+	return true;
+}
+
+FString FWorkshopSharedContentPlan::GetSharedStagingDir(const FString& Platform)
+{
+	// Side by side rather than nested, staging one platform deletes its folder first
+	const FString FolderName = Platform.IsEmpty() ? FString(TEXT("_Shared")) : TEXT("_Shared_") + Platform;
+
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Staging") / FolderName);
+}
+
+FString FWorkshopSharedContentPlan::GetStagingDir(const FString& Package)
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("WorkshopUploader") / TEXT("Staging") / Package);
+}
@@ -0,0 +1,100 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* A file that is byte for byte the same, at the same path, in more than one mod */
+struct FWorkshopSharedFile
+{
+	/* Relative to StagedBuilds */
+	FString Path;
+	FString Hash;
+	int64 Size = 0;
+	TArray<FString> Packages;
+
+	/* Platform folder the file is staged under, empty for mods staged without platform folders */
+	FString Platform;
+
+	/* Bytes that would no longer be uploaded and stored if this file was only in the shared item */
+	int64 GetDuplicatedBytes() const { return Size * (Packages.Num() - 1); }
+
+	/* Where the file goes in its platform's shared item, platform items are uploaded from inside their platform folder */
+	FString GetPlatformPath() const { return Platform.IsEmpty() ? Path : Path.Mid(Platform.Len() + 1); }
+};
+
+struct FWorkshopDedupReport
+{
+	TArray<FString> Packages;
+
+	int64 TotalBytes = 0;
+	int64 DuplicatedFileBytes = 0;
+
+	/* Duplicated chunks inside files that differ, typically the same assets cooked into different paks. Can't be split out without repacking */
+	int64 DuplicatedChunkBytes = 0;
+
+	/* Sorted by duplicated bytes, largest first */
+	TArray<FWorkshopSharedFile> SharedFiles;
+
+	FString ToString(int32 MaxFiles = 20) const;
+};
+
+/* The shared item for one platform, so subscribers only download the shared files for their own platform */
+struct FWorkshopSharedItem
+{
+	/* Empty for mods staged without platform folders */
+	FString Platform;
+	uint64 PublishedFileId = 0;
+
+	/* Only set once this plan's files were uploaded to the item, mods keep their own copies until then */
+	bool bPublished = false;
+};
+
+/**
+ * Files split out of a set of mods into shared items, one per platform, that they depend on.
+ * Saved to Saved/WorkshopUploader/SharedContent.json
+ */
+struct FWorkshopSharedContentPlan
+{
+	TArray<FWorkshopSharedItem> Items;
+	TArray<FString> Packages;
+	TArray<FWorkshopSharedFile> Files;
+
+	FWorkshopSharedItem* FindItem(const FString& Platform);
+
+	/* Shared item per platform, only for items this plan's files were published to */
+	TMap<FString, uint64> GetPublishedItems() const;
+
+	/**
+	 * Build a mod's item in an app is uploaded from, StageDependent's copy only for the shared items' own app.
+	 * An item can't depend on another app's items, so every other app gets the whole build in StagedBuildsDir
+	 */
+	FString GetDependentContentDir(const FString& Package, const FString& StagedBuildsDir, bool bSharedItemsApp) const;
+
+	bool Save() const;
+	static bool Load(FWorkshopSharedContentPlan& OutPlan);
+
+	/* Where each platform's shared item and the mods without their shared files are staged for upload */
+	static FString GetSharedStagingDir(const FString& Platform);
+	static FString GetStagingDir(const FString& Package);
+};
+
+class FWorkshopSharedContent
+{
+public:
+
+	/* Fingerprints the staged content of every package, reusing cached hashes for files that haven't changed. Blocking, call off the game thread */
+	static FWorkshopDedupReport Analyze(const TArray<FString>& Packages);
+
+	/* Shares every duplicated file of at least MinFileSize bytes, in one item per platform. Items of the last saved plan are reused but not yet published */
+	static FWorkshopSharedContentPlan MakePlan(const FWorkshopDedupReport& Report, int64 MinFileSize = DefaultMinSharedFileSize);
+
+	/* Copies the platform's shared files into its shared item's staging folder. Blocking */
+	static bool StageSharedItem(const FWorkshopSharedContentPlan& Plan, const FString& Platform);
+
+	/* Copies a mod's build in StagedBuildsDir, as staged or repacked, minus the files its published shared items have into its own staging folder. Blocking */
+	static bool StageDependent(const FWorkshopSharedContentPlan& Plan, const FString& Package, const FString& StagedBuildsDir);
+
+	/* Smaller files save too little to be worth a dependency */
+	static constexpr int64 DefaultMinSharedFileSize = 64 * 1024;
+};
@@ -0,0 +1,289 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopSizeBudget.h"
+#include "WorkshopContentManifest.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* SizeBudgetConfigSection = TEXT("WorkshopUploader");
+
+/* Folders are split up until there are this many per worker, so one big folder doesn't end up walked by a single thread */
+static const int32 SizeWalkItemsPerWorker = 4;
+static const int32 SizeWalkMaxSplitDepth = 8;
+
+static FString FormatSize(int64 Bytes)
+{
+	return FString::Printf(TEXT("%.1f MB"), Bytes / (1024.0 * 1024.0));
+}
+
+static FString FormatGrowth(int64 Bytes)
+{
+	return (Bytes >= 0 ? TEXT("+") : TEXT("-")) + FormatSize(FMath::Abs(Bytes));
+}
+
+/* Directory a file is counted towards, relative to the content folder */
+static FString GetSizeDirectory(const FString& RelativePath)
+{
+	TArray<FString> Parts;
+	RelativePath.ParseIntoArray(Parts, TEXT("/"));
+
+	// The last part is the file itself
+	Parts.SetNum(FMath::Clamp(Parts.Num() - 1, 0, FWorkshopSizeReport::DirectoryDepth));
+
+	return Parts.Num() > 0 ? FString::Join(Parts, TEXT("/")) : FString(TEXT("(root)"));
+}
+
+static FString GetSizeExtension(const FString& RelativePath)
+{
+	const FString Extension = FPaths::GetExtension(RelativePath).ToLower();
+	return Extension.IsEmpty() ? FString(TEXT("(none)")) : TEXT(".") + Extension;
+}
+
+/* Sizes by directory and extension, collected per worker and merged at the end */
+struct FSizeTotals
+{
+	int64 Total = 0;
+	TMap<FString, int64> Directories;
+	TMap<FString, int64> Extensions;
+
+	void Add(const FString& RelativePath, int64 Size)
+	{
+		Total += Size;
+		Directories.FindOrAdd(GetSizeDirectory(RelativePath)) += Size;
+		Extensions.FindOrAdd(GetSizeExtension(RelativePath)) += Size;
+	}
+
+	void Append(const FSizeTotals& Other)
+	{
+		Total += Other.Total;
+
+		for (const TPair<FString, int64>& Entry : Other.Directories)
+			Directories.FindOrAdd(Entry.Key) += Entry.Value;
+
+		for (const TPair<FString, int64>& Entry : Other.Extensions)
+			Extensions.FindOrAdd(Entry.Key) += Entry.Value;
+	}
+};
+
+static TArray<FWorkshopSizeEntry> MakeEntries(const TMap<FString, int64>& Sizes, const TMap<FString, int64>& PublishedSizes)
+{
+	TArray<FWorkshopSizeEntry> Entries;
+
+	for (const TPair<FString, int64>& Entry : Sizes)
+		Entries.Add({ Entry.Key, Entry.Value, PublishedSizes.FindRef(Entry.Key) });
+
+	// Whatever was removed since the last publish still shows up, as shrinkage
+	for (const TPair<FString, int64>& Entry : PublishedSizes)
+	{
+		if (!Sizes.Contains(Entry.Key))
+			Entries.Add({ Entry.Key, 0, Entry.Value });
+	}
+
+	Entries.Sort([](const FWorkshopSizeEntry& A, const FWorkshopSizeEntry& B) { return A.Size > B.Size; });
+
+	return Entries;
+}
+
+int64 FWorkshopSizeBudgets::GetBudget(const FString& Package) const
+{
+	const int32* PackageBudget = PackageBudgetsMB.Find(Package);
+	return (int64)(PackageBudget ? *PackageBudget : DefaultBudgetMB) * 1024 * 1024;
+}
+
+FString FWorkshopSizeBudgets::PackageBudgetsToString() const
+{
+	FString Lines;
+
+	for (const TPair<FString, int32>& Entry : PackageBudgetsMB)
+		Lines += FString::Printf(TEXT("%s=%d\n"), *Entry.Key, Entry.Value);
+
+	return Lines;
+}
+
+void FWorkshopSizeBudgets::PackageBudgetsFromString(const FString& Lines)
+{
+	PackageBudgetsMB.Empty();
+
+	TArray<FString> ParsedLines;
+	Lines.ParseIntoArrayLines(ParsedLines);
+
+	for (const FString& Line : ParsedLines)
+	{
+		FString Package, Budget;
+		if (Line.Split(TEXT("="), &Package, &Budget) && !Package.TrimStartAndEnd().IsEmpty())
+			PackageBudgetsMB.Add(Package.TrimStartAndEnd(), FMath::Max(0, FCString::Atoi(*Budget.TrimStartAndEnd())));
+	}
+}
+
+FWorkshopSizeBudgets FWorkshopSizeBudgets::Load()
+{
+	FWorkshopSizeBudgets Budgets;
+
+	GConfig->GetInt(SizeBudgetConfigSection, TEXT("DefaultSizeBudgetMB"), Budgets.DefaultBudgetMB, GGameIni);
+	GConfig->GetBool(SizeBudgetConfigSection, TEXT("bBlockOverBudget"), Budgets.bBlockOverBudget, GGameIni);
+
+	TArray<FString> PackageLines;
+	GConfig->GetArray(SizeBudgetConfigSection, TEXT("ModSizeBudgets"), PackageLines, GGameIni);
+	Budgets.PackageBudgetsFromString(FString::Join(PackageLines, TEXT("\n")));
+
+	return Budgets;
+}
+
+void FWorkshopSizeBudgets::Save() const
+{
+	TArray<FString> PackageLines;
+	PackageBudgetsToString().ParseIntoArrayLines(PackageLines);
+	PackageLines.Sort();
+
+	const FString DefaultGameIni = FConfigCacheIni::NormalizeConfigIniPath(FPaths::ProjectConfigDir() / TEXT("DefaultGame.ini"));
+	GConfig->LoadFile(DefaultGameIni);
+
+	// The running game config gets the same values, so they're used straight away without reloading it
+	for (const FString& ConfigFile : { GGameIni, DefaultGameIni })
+	{
+		GConfig->SetInt(SizeBudgetConfigSection, TEXT("DefaultSizeBudgetMB"), DefaultBudgetMB, ConfigFile);
+		GConfig->SetBool(SizeBudgetConfigSection, TEXT("bBlockOverBudget"), bBlockOverBudget, ConfigFile);
+		GConfig->SetArray(SizeBudgetConfigSection, TEXT("ModSizeBudgets"), PackageLines, ConfigFile);
+	}
+
+	GConfig->Flush(false, DefaultGameIni);
+}
+
+FWorkshopSizeReport FWorkshopSizeReport::Analyze(const FString& Package, const FString& ContentFolder, const FWorkshopContentManifest* Published)
+{
+	FWorkshopSizeReport Report;
+	Report.Package = Package;
+
+	const FString Root = FPaths::ConvertRelativePathToFull(ContentFolder) / TEXT("");
+
+	auto GetRelativePath = [&Root](const TCHAR* Filename) { return FString(Filename).RightChop(Root.Len()).Replace(TEXT("\\"), TEXT("/")); };
+
+	// A staged build is mostly one long chain of single folders (Platform/Project/Mods/Mod/Content), so the walk goes down
+	// level by level until there are enough folders to keep every worker busy. Files met on the way are counted here
+	FSizeTotals Totals;
+	TArray<FString> WorkDirs = { FPaths::ConvertRelativePathToFull(ContentFolder) };
+
+	const int32 MinWorkDirs = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads()) * SizeWalkItemsPerWorker;
+
+	for (int32 Depth = 0; Depth < SizeWalkMaxSplitDepth && WorkDirs.Num() > 0 && WorkDirs.Num() < MinWorkDirs; ++Depth)
+	{
+		TArray<FString> SubDirs;
+
+		for (const FString& WorkDir : WorkDirs)
+		{
+			IFileManager::Get().IterateDirectoryStat(*WorkDir, [&Totals, &SubDirs, &GetRelativePath](const TCHAR* Filename, const FFileStatData& StatData)
+			{
+				if (StatData.bIsDirectory)
+					SubDirs.Add(Filename);
+				else
+					Totals.Add(GetRelativePath(Filename), StatData.FileSize);
+
+				return true;
+			});
+		}
+
+		WorkDirs = MoveTemp(SubDirs);
+	}
+
+	TArray<FSizeTotals> DirTotals;
+	DirTotals.SetNum(WorkDirs.Num());
+
+	ParallelFor(WorkDirs.Num(), [&WorkDirs, &DirTotals, &GetRelativePath](int32 Index)
+	{
+		IFileManager::Get().IterateDirectoryStatRecursively(*WorkDirs[Index], [&DirTotals, &GetRelativePath, Index](const TCHAR* Filename, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+				DirTotals[Index].Add(GetRelativePath(Filename), StatData.FileSize);
+
+			return true;
+		});
+	});
+
+	for (const FSizeTotals& DirTotal : DirTotals)
+		Totals.Append(DirTotal);
+
+	FSizeTotals PublishedTotals;
+
+	if (Published != nullptr)
+	{
+		for (const FWorkshopManifestFile& File : Published->Files)
+			PublishedTotals.Add(File.Path, File.Size);
+
+		Report.PublishedSize = PublishedTotals.Total;
+	}
+
+	Report.TotalSize = Totals.Total;
+	Report.Directories = MakeEntries(Totals.Directories, PublishedTotals.Directories);
+	Report.Extensions = MakeEntries(Totals.Extensions, PublishedTotals.Extensions);
+
+	return Report;
+}
+
+FString FWorkshopSizeReport::Describe(int64 Budget, int32 MaxEntries) const
+{
+	FString Description = FString::Printf(TEXT("%s: %s"), *Package, *FormatSize(TotalSize));
+
+	if (PublishedSize >= 0)
+		Description += FString::Printf(TEXT(" (%s since the last publish)"), *FormatGrowth(GetGrowth()));
+
+	if (Budget > 0)
+		Description += FString::Printf(TEXT(", %d%% of its %s budget"), (int32)(TotalSize * 100 / Budget), *FormatSize(Budget));
+
+	Description += TEXT("\n");
+
+	auto DescribeEntries = [&Description, MaxEntries, this](const TArray<FWorkshopSizeEntry>& Entries)
+	{
+		for (int32 Index = 0; Index < FMath::Min(MaxEntries, Entries.Num()); ++Index)
+		{
+			const FWorkshopSizeEntry& Entry = Entries[Index];
+			Description += FString::Printf(TEXT("    %s: %s"), *Entry.Name, *FormatSize(Entry.Size));
+
+			if (PublishedSize >= 0 && Entry.Size != Entry.PublishedSize)
+				Description += FString::Printf(TEXT(" (%s)"), *FormatGrowth(Entry.Size - Entry.PublishedSize));
+
+			Description += TEXT("\n");
+		}
+	};
+
+	Description += TEXT("  Largest folders\n");
+	DescribeEntries(Directories);
+
+	Description += TEXT("  Largest file types\n");
+	DescribeEntries(Extensions);
+
+	return Description;
+}
+
+FWorkshopSizeCheck FWorkshopSizeCheck::Check(const TArray<FWorkshopSizeReport>& Reports, const FWorkshopSizeBudgets& Budgets, int64 AvailableQuota)
+{
+	FWorkshopSizeCheck Result;
+	TArray<FString> Problems;
+
+	int64 TotalGrowth = 0;
+
+	for (const FWorkshopSizeReport& Report : Reports)
+	{
+		TotalGrowth += FMath::Max<int64>(0, Report.GetGrowth());
+
+		if (Report.bQuotaOnly)
+			continue;
+
+		const int64 Budget = Budgets.GetBudget(Report.Package);
+		if (Budget > 0 && Report.TotalSize > Budget)
+			Problems.Add(FString::Printf(TEXT("%s is %s, over its %s budget"), *Report.Package, *FormatSize(Report.TotalSize), *FormatSize(Budget)));
+	}
+
+	// Only what a batch adds counts against the quota, replaced content frees its old space
+	if (AvailableQuota >= 0 && TotalGrowth > AvailableQuota)
+		Problems.Add(FString::Printf(TEXT("Uploading adds %s but only %s of the account's quota is left"), *FormatSize(TotalGrowth), *FormatSize(AvailableQuota)));
+
+	if (Budgets.bBlockOverBudget && Problems.Num() > 0)
+		Result.Error = FString::Join(Problems, TEXT("; "));
+	else
+		Result.Warnings = MoveTemp(Problems);
+
+	return Result;
+}
@@ -0,0 +1,84 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWorkshopContentManifest;
+
+/**
+ * How big each mod's upload is allowed to get, in MB, 0 for no limit. Read from the [WorkshopUploader] section of the
+ * project's game config, so the whole team works to the same budgets:
+ *
+ *   DefaultSizeBudgetMB=500
+ *   +ModSizeBudgets=DesertOutpost=1200
+ *   bBlockOverBudget=True
+ */
+struct FWorkshopSizeBudgets
+{
+	int32 DefaultBudgetMB = 0;
+	TMap<FString, int32> PackageBudgetsMB;
+
+	/* Submissions over budget or over the account quota fail before uploading instead of only warning */
+	bool bBlockOverBudget = false;
+
+	/* Bytes, 0 for no limit */
+	int64 GetBudget(const FString& Package) const;
+
+	/* "Mod=MB" per line, the format the per mod budgets are edited in */
+	FString PackageBudgetsToString() const;
+	void PackageBudgetsFromString(const FString& Lines);
+
+	static FWorkshopSizeBudgets Load();
+
+	/* Writes the budgets to the project's DefaultGame.ini, edits made in the tab are shared like any other config change */
+	void Save() const;
+};
+
+/* Size of one directory or extension now and when it was last published */
+struct FWorkshopSizeEntry
+{
+	FString Name;
+	int64 Size = 0;
+	int64 PublishedSize = 0;
+};
+
+/* Where a mod's staged size comes from */
+struct FWorkshopSizeReport
+{
+	FString Package;
+	int64 TotalSize = 0;
+
+	/* -1 if the mod was never published */
+	int64 PublishedSize = -1;
+
+	/* Another app's copy of a build that's already in the batch, it takes up quota but isn't held to the budget again */
+	bool bQuotaOnly = false;
+
+	/* Largest first */
+	TArray<FWorkshopSizeEntry> Directories;
+	TArray<FWorkshopSizeEntry> Extensions;
+
+	/* Files deeper than this are counted towards their ancestor at this depth */
+	static const int32 DirectoryDepth = 3;
+
+	int64 GetGrowth() const { return PublishedSize < 0 ? TotalSize : TotalSize - PublishedSize; }
+
+	/* Walks ContentFolder with its folders spread over the thread pool, Published (optional) is what the growth is measured against */
+	static FWorkshopSizeReport Analyze(const FString& Package, const FString& ContentFolder, const FWorkshopContentManifest* Published);
+
+	/* Totals followed by the largest MaxEntries directories and extensions */
+	FString Describe(int64 Budget, int32 MaxEntries = 10) const;
+};
+
+struct FWorkshopSizeCheck
+{
+	/* Why the submission should stop, empty if it can go ahead */
+	FString Error;
+
+	/* Over budget or quota but not blocked */
+	TArray<FString> Warnings;
+
+	/* Checks a batch of mods against their budgets and, when AvailableQuota is known (>= 0), their combined growth against the account quota */
+	static FWorkshopSizeCheck Check(const TArray<FWorkshopSizeReport>& Reports, const FWorkshopSizeBudgets& Budgets, int64 AvailableQuota);
+};
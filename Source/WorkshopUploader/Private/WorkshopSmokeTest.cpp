@@ -0,0 +1,325 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopSmokeTest.h"
+#include "WorkshopUploader.h"
+#include "WorkshopStagedContent.h"
+#include "WorkshopTagClassifier.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/MonitoredProcess.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static const TCHAR* SmokeTestConfigSection = TEXT("WorkshopUploader");
+
+/* A run fails on its first few errors, the rest are usually the same problem over again */
+static const int32 MaxErrorsPerRun = 10;
+
+FWorkshopSmokeTestSettings FWorkshopSmokeTestSettings::Load()
+{
+	FWorkshopSmokeTestSettings Settings;
+
+	GConfig->GetString(SmokeTestConfigSection, TEXT("SmokeTestExecutable"), Settings.Executable, GGameIni);
+	GConfig->GetString(SmokeTestConfigSection, TEXT("SmokeTestArguments"), Settings.Arguments, GGameIni);
+	GConfig->GetFloat(SmokeTestConfigSection, TEXT("SmokeTestTimeoutSeconds"), Settings.TimeoutSeconds, GGameIni);
+	GConfig->GetInt(SmokeTestConfigSection, TEXT("MaxConcurrentSmokeTests"), Settings.MaxConcurrentRuns, GGameIni);
+	GConfig->GetInt(SmokeTestConfigSection, TEXT("SmokeTestMaxMaps"), Settings.MaxMapsPerMod, GGameIni);
+	GConfig->GetFloat(SmokeTestConfigSection, TEXT("SmokeTestSlowLoadSeconds"), Settings.SlowLoadSeconds, GGameIni);
+	GConfig->GetArray(SmokeTestConfigSection, TEXT("SmokeTestIgnoredErrors"), Settings.IgnoredErrors, GGameIni);
+
+	if (!Settings.Executable.IsEmpty() && FPaths::IsRelative(Settings.Executable))
+		Settings.Executable = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Settings.Executable);
+
+	return Settings;
+}
+
+bool FWorkshopSmokeTestReport::HasFailed() const
+{
+	return Runs.ContainsByPredicate([](const FWorkshopSmokeTestRun& Run) { return !Run.bPassed; });
+}
+
+TArray<FString> FWorkshopSmokeTestReport::GetSlowLoads(float SlowLoadSeconds) const
+{
+	TArray<FString> SlowLoads;
+
+	for (const FWorkshopSmokeTestRun& Run : Runs)
+	{
+		if (Run.bPassed && Run.LoadSeconds > SlowLoadSeconds)
+			SlowLoads.Add(FString::Printf(TEXT("%s took %.1fs to load"), *Run.Map, Run.LoadSeconds));
+	}
+
+	return SlowLoads;
+}
+
+FString FWorkshopSmokeTestReport::ToString() const
+{
+	if (bSkipped)
+		return TEXT("Not smoke tested, the mod wasn't staged for the platform the game executable runs on");
+
+	FString Description;
+
+	for (const FWorkshopSmokeTestRun& Run : Runs)
+	{
+		const FString Name = Run.Map.IsEmpty() ? TEXT("Startup") : Run.Map;
+		const FString LoadTime = Run.LoadSeconds >= 0.0 ? FString::Printf(TEXT(", loaded in %.2fs"), Run.LoadSeconds) : FString();
+
+		Description += FString::Printf(TEXT("%s: %s, %d mounted%s, %.1fs in total\n"), *Name, Run.bPassed ? TEXT("passed") : TEXT("FAILED"), Run.NumMounted, *LoadTime, Run.ProcessSeconds);
+
+		for (const FString& Error : Run.Errors)
+			Description += FString::Printf(TEXT("    %s\n"), *Error);
+	}
+
+	return Description;
+}
+
+FWorkshopSmokeTester::FWorkshopSmokeTester()
+	: Settings(FWorkshopSmokeTestSettings::Load())
+{
+}
+
+FWorkshopSmokeTester::~FWorkshopSmokeTester()
+{
+	// The processes' output callbacks point at their runs
+	for (const TSharedRef<FRun>& Run : ActiveRuns)
+		Run->Process->Cancel(true);
+
+	ActiveRuns.Empty();
+}
+
+FString FWorkshopSmokeTester::FindTestableContent(const FString& StagedBuildsDir)
+{
+	// Only content for the platform the executable was built for can be tested with it
+	const FString HostPlatform = FPlatformProperties::IniPlatformName();
+
+	for (const FString& Platform : FWorkshopStagedContent::FindStagedPlatforms(StagedBuildsDir))
+	{
+		if (Platform.StartsWith(HostPlatform))
+			return StagedBuildsDir / Platform;
+	}
+
+	return FString();
+}
+
+TArray<FString> FWorkshopSmokeTester::FindMaps(const FString& ContentFolder)
+{
+	TArray<FString> Maps;
+
+	for (const FString& File : FWorkshopTagClassifier::ListStagedFiles(ContentFolder))
+	{
+		if (!File.EndsWith(TEXT(".umap")))
+			continue;
+
+		// Cooked content keeps its layout, <Root>/Content/<Path>.umap is /<Root>/<Path> and the project's own content is /Game
+		const FString Path = FPaths::ChangeExtension(File.Replace(TEXT("\\"), TEXT("/")), FString());
+
+		const int32 ContentIndex = Path.Find(TEXT("/Content/"), ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+		if (ContentIndex == INDEX_NONE)
+			continue;
+
+		FString Root = FPaths::GetCleanFilename(Path.Left(ContentIndex));
+		if (Root == FApp::GetProjectName())
+			Root = TEXT("Game");
+
+		Maps.AddUnique(FString::Printf(TEXT("/%s/%s"), *Root, *Path.Mid(ContentIndex + 9)));
+	}
+
+	Maps.Sort();
+
+	return Maps;
+}
+
+void FWorkshopSmokeTester::Test(const FString& ContentFolder, const TArray<FString>& Maps, TFunction<void(const FWorkshopSmokeTestReport& Report)> OnComplete)
+{
+	TSharedPtr<FTest> Test = MakeShared<FTest>();
+	Test->Report.ContentFolder = ContentFolder;
+	Test->OnComplete = MoveTemp(OnComplete);
+
+	if (ContentFolder.IsEmpty())
+	{
+		Test->Report.bSkipped = true;
+		Test->OnComplete(Test->Report);
+		return;
+	}
+
+	TArray<FString> PakDirs;
+	TArray<FString> PakFiles;
+	IFileManager::Get().FindFilesRecursive(PakFiles, *ContentFolder, TEXT("*.pak"), true, false);
+
+	for (const FString& PakFile : PakFiles)
+		PakDirs.AddUnique(FPaths::GetPath(PakFile));
+
+	TArray<FString> RunMaps = Maps;
+
+	if (RunMaps.Num() > Settings.MaxMapsPerMod)
+	{
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("%s has %d maps, only the first %d are smoke tested"), *ContentFolder, RunMaps.Num(), Settings.MaxMapsPerMod);
+		RunMaps.SetNum(FMath::Max(1, Settings.MaxMapsPerMod));
+	}
+
+	// A mod without maps still gets started once with its content mounted
+	if (RunMaps.Num() == 0)
+		RunMaps.Add(FString());
+
+	Test->NumPending = RunMaps.Num();
+
+	for (const FString& Map : RunMaps)
+	{
+		FWorkshopSmokeTestRun& Result = Test->Report.Runs.AddDefaulted_GetRef();
+		Result.Map = Map;
+
+		TSharedRef<FRun> Run = MakeShared<FRun>();
+		Run->Test = Test;
+		Run->RunIndex = Test->Report.Runs.Num() - 1;
+		Run->Arguments = Settings.Arguments
+			.Replace(TEXT("{Map}"), *Map)
+			.Replace(TEXT("{PakDirs}"), *FString::Join(PakDirs, TEXT("*")))
+			.Replace(TEXT("{ContentFolder}"), *ContentFolder);
+
+		QueuedRuns.Add(Run);
+	}
+
+	Tick();
+}
+
+void FWorkshopSmokeTester::Tick()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Completing a test can queue more, so collect the finished runs first
+	TArray<TSharedRef<FRun>> FinishedRuns;
+
+	for (int32 RunIndex = ActiveRuns.Num() - 1; RunIndex >= 0; --RunIndex)
+	{
+		const TSharedRef<FRun>& Run = ActiveRuns[RunIndex];
+
+		if (Run->Process->IsRunning())
+		{
+			if (!Run->bTimedOut && Now - Run->StartTime > Settings.TimeoutSeconds)
+			{
+				Run->bTimedOut = true;
+				Run->Process->Cancel(true);
+			}
+
+			continue;
+		}
+
+		FinishedRuns.Insert(Run, 0);
+		ActiveRuns.RemoveAt(RunIndex);
+	}
+
+	while (QueuedRuns.Num() > 0 && ActiveRuns.Num() < FMath::Max(1, Settings.MaxConcurrentRuns))
+	{
+		TSharedRef<FRun> Run = QueuedRuns[0];
+		QueuedRuns.RemoveAt(0);
+
+		if (Launch(Run))
+		{
+			ActiveRuns.Add(Run);
+		}
+		else
+		{
+			Run->Test->Report.Runs[Run->RunIndex].Errors.Add(FString::Printf(TEXT("Couldn't launch %s"), *Settings.Executable));
+			FinishedRuns.Add(Run);
+		}
+	}
+
+	for (const TSharedRef<FRun>& Run : FinishedRuns)
+		FinishRun(Run, Run->Process.IsValid() ? Run->Process->GetReturnCode() : 0);
+}
+
+bool FWorkshopSmokeTester::Launch(const TSharedRef<FRun>& Run)
+{
+	if (!FPaths::FileExists(Settings.Executable))
+		return false;
+
+	Run->Process = MakeShared<FMonitoredProcess>(Settings.Executable, Run->Arguments, true);
+
+	FRun* RunPtr = &Run.Get();
+	Run->Process->OnOutput().BindLambda([RunPtr](FString Output)
+	{
+		UE_LOG(LogWorkshopUploader, Verbose, TEXT("[Smoke test] %s"), *Output);
+
+		FScopeLock Lock(&RunPtr->OutputLock);
+		RunPtr->Output.Add(MoveTemp(Output));
+	});
+
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Smoke testing %s: %s %s"), *Run->Test->Report.ContentFolder, *Settings.Executable, *Run->Arguments);
+
+	if (!Run->Process->Launch())
+	{
+		Run->Process.Reset();
+		return false;
+	}
+
+	Run->StartTime = FPlatformTime::Seconds();
+	return true;
+}
+
+void FWorkshopSmokeTester::FinishRun(const TSharedRef<FRun>& Run, int32 ReturnCode)
+{
+	FWorkshopSmokeTestRun& Result = Run->Test->Report.Runs[Run->RunIndex];
+
+	TArray<FString> Output;
+	{
+		FScopeLock Lock(&Run->OutputLock);
+		Output = MoveTemp(Run->Output);
+	}
+
+	// Only the engine's own log lines are read, so any game can be tested without code of its own
+	for (const FString& Line : Output)
+	{
+		if (Line.Contains(TEXT("Mounted Pak file")) || Line.Contains(TEXT("Mounted IoStore container")))
+		{
+			++Result.NumMounted;
+			continue;
+		}
+
+		const int32 LoadMapIndex = Line.Find(TEXT("seconds to LoadMap("));
+		if (LoadMapIndex != INDEX_NONE && !Result.Map.IsEmpty() && Line.Contains(Result.Map))
+		{
+			// "Took 1.234 seconds to LoadMap(/Mod/Maps/Arena)"
+			const int32 TookIndex = Line.Find(TEXT("Took "));
+			if (TookIndex != INDEX_NONE && TookIndex < LoadMapIndex)
+				LexFromString(Result.LoadSeconds, *Line.Mid(TookIndex + 5, LoadMapIndex - TookIndex - 5).TrimStartAndEnd());
+
+			continue;
+		}
+
+		const bool bError = Line.Contains(TEXT("Error:")) || Line.Contains(TEXT("Fatal error")) || Line.Contains(TEXT("Assertion failed"))
+			|| Line.Contains(TEXT("Failed to mount")) || Line.Contains(TEXT("Failed to load package"));
+
+		if (!bError || Result.Errors.Num() >= MaxErrorsPerRun)
+			continue;
+
+		if (Settings.IgnoredErrors.ContainsByPredicate([&Line](const FString& Pattern) { return Line.MatchesWildcard(Pattern); }))
+			continue;
+
+		Result.Errors.AddUnique(Line.TrimStartAndEnd());
+	}
+
+	if (Run->StartTime > 0.0)
+		Result.ProcessSeconds = FPlatformTime::Seconds() - Run->StartTime;
+
+	if (Run->bTimedOut)
+		Result.Errors.Add(FString::Printf(TEXT("Still running after %.0fs, killed"), Settings.TimeoutSeconds));
+	else if (ReturnCode != 0)
+		Result.Errors.Add(FString::Printf(TEXT("The game crashed or exited with code %d"), ReturnCode));
+	else if (!Result.Map.IsEmpty() && Result.LoadSeconds < 0.0)
+		Result.Errors.Add(TEXT("The map never finished loading"));
+
+	Result.bPassed = Result.Errors.Num() == 0;
+
+	TSharedPtr<FTest> Test = Run->Test;
+	Run->Process.Reset();
+	Run->Test.Reset();
+
+	if (--Test->NumPending > 0)
+		return;
+
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Smoke test of %s %s\n%s"), *Test->Report.ContentFolder, Test->Report.HasFailed() ? TEXT("failed") : TEXT("passed"), *Test->Report.ToString());
+
+	Test->OnComplete(Test->Report);
+}
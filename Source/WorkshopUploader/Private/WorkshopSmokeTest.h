@@ -0,0 +1,141 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class FMonitoredProcess;
+
+/**
+ * How mods are smoke tested before they're uploaded, read from the [WorkshopUploader] section of the project's game config:
+ *
+ *   SmokeTestExecutable=../Builds/WindowsNoEditor/MyGame.exe
+ *   SmokeTestArguments={Map} -pakdir="{PakDirs}" -nullrhi -unattended -stdout -ExecCmds="quit"
+ *   +SmokeTestIgnoredErrors=*LogOnline*
+ *
+ * Testing is off until an executable is set. It should be a Development build of the release the mods are cooked
+ * against, Shipping builds ignore -pakdir and the console commands the default arguments rely on
+ */
+struct FWorkshopSmokeTestSettings
+{
+	/* Relative paths are relative to the project folder */
+	FString Executable;
+
+	/* {Map} is the map's package name (empty for a mod without maps), {PakDirs} the folders with the mod's paks joined by *, {ContentFolder} the staged platform folder */
+	FString Arguments = TEXT("{Map} -pakdir=\"{PakDirs}\" -nullrhi -nosound -nosplash -unattended -stdout -FullStdOutLogOutput -ExecCmds=\"quit\"");
+
+	/* Runs still going after this long are killed and count as hung */
+	float TimeoutSeconds = 300.0f;
+
+	/* Every run is a whole game process, this many at once across every mod being tested */
+	int32 MaxConcurrentRuns = 2;
+
+	/* Mods with more maps than this only have the first ones opened */
+	int32 MaxMapsPerMod = 16;
+
+	/* Maps that pass but take longer than this to load are reported as slow */
+	float SlowLoadSeconds = 30.0f;
+
+	/* Logged errors matching any of these (wildcards against the whole line) don't fail a run */
+	TArray<FString> IgnoredErrors;
+
+	bool IsEnabled() const { return !Executable.IsEmpty(); }
+
+	static FWorkshopSmokeTestSettings Load();
+};
+
+/* One process, opening one map or just starting up with the mod mounted */
+struct FWorkshopSmokeTestRun
+{
+	/* Empty for a mod without maps */
+	FString Map;
+
+	bool bPassed = false;
+	int32 NumMounted = 0;
+
+	/* From the engine's LoadMap log line, negative if the map never finished loading */
+	double LoadSeconds = -1.0;
+	double ProcessSeconds = 0.0;
+
+	/* Errors the process logged, then how it ended if it crashed or hung */
+	TArray<FString> Errors;
+};
+
+struct FWorkshopSmokeTestReport
+{
+	FString ContentFolder;
+
+	/* Nothing was run, the mod wasn't staged for the platform the executable runs on */
+	bool bSkipped = false;
+
+	TArray<FWorkshopSmokeTestRun> Runs;
+
+	bool HasFailed() const;
+
+	/* Maps that passed but loaded slower than SlowLoadSeconds */
+	TArray<FString> GetSlowLoads(float SlowLoadSeconds) const;
+
+	/* One line per run with its timings, followed by the errors of the ones that failed */
+	FString ToString() const;
+};
+
+/**
+ * Launches the game headless against a mod's staged content before it's uploaded, mounting its paks and opening each
+ * of its maps in a process of its own, so content that doesn't mount, fails to load or crashes the game is caught
+ * before subscribers get it. Only the process is ever at risk, the editor just reads its log output
+ */
+class FWorkshopSmokeTester
+{
+public:
+
+	FWorkshopSmokeTester();
+	~FWorkshopSmokeTester();
+
+	FWorkshopSmokeTestSettings Settings;
+
+	/* The platform folder under a mod's StagedBuilds folder the executable can run, empty if there's none */
+	static FString FindTestableContent(const FString& StagedBuildsDir);
+
+	/* Package names of the maps in the staged content, from the pak indices and loose files. Reads pak indices, so call it off the game thread */
+	static TArray<FString> FindMaps(const FString& ContentFolder);
+
+	/* Queues a run for each of Maps (or a single startup run if there are none), OnComplete is called from Tick once they've all finished. An empty ContentFolder is reported as skipped */
+	void Test(const FString& ContentFolder, const TArray<FString>& Maps, TFunction<void(const FWorkshopSmokeTestReport& Report)> OnComplete);
+
+	void Tick();
+
+	bool IsRunning() const { return QueuedRuns.Num() > 0 || ActiveRuns.Num() > 0; }
+
+private:
+
+	struct FTest
+	{
+		FWorkshopSmokeTestReport Report;
+		TFunction<void(const FWorkshopSmokeTestReport& Report)> OnComplete;
+		int32 NumPending = 0;
+	};
+
+	struct FRun
+	{
+		TSharedPtr<FTest> Test;
+		int32 RunIndex = 0;
+		FString Arguments;
+
+		TSharedPtr<FMonitoredProcess> Process;
+		double StartTime = 0.0;
+		bool bTimedOut = false;
+
+		/* Filled on the process' own thread */
+		FCriticalSection OutputLock;
+		TArray<FString> Output;
+	};
+
+	TArray<TSharedRef<FRun>> QueuedRuns;
+	TArray<TSharedRef<FRun>> ActiveRuns;
+
+	bool Launch(const TSharedRef<FRun>& Run);
+
+	/* Reads the run's output into its result, then completes the test if it was the last run */
+	void FinishRun(const TSharedRef<FRun>& Run, int32 ReturnCode);
+};
@@ -0,0 +1,69 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopStagedContent.h"
+#include "WorkshopModDiscovery.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static bool IsPlatformFolderName(const FString& FolderName)
+{
+	return FolderName.StartsWith(TEXT("Windows")) || FolderName.StartsWith(TEXT("Mac")) || FolderName.StartsWith(TEXT("Linux"));
+}
+
+struct FPlatformFolderVisitor : public IPlatformFile::FDirectoryVisitor
+{
+	TArray<FString> PlatformFolders;
+
+	virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+	{
+		if (bIsDirectory)
+		{
+			FString FolderName = FPaths::GetCleanFilename(FilenameOrDirectory);
+
+			if (IsPlatformFolderName(FolderName))
+				PlatformFolders.Add(FolderName);
+		}
+		return true;
+	}
+};
+
+FString FWorkshopStagedContent::GetStagedBuildsDir(const FString& Package)
+{
+	return FWorkshopModDiscovery::Get().GetModDir(Package) / TEXT("Saved/StagedBuilds");
+}
+
+TArray<FString> FWorkshopStagedContent::FindStagedPlatforms(const FString& StagedBuildsDir)
+{
+	FPlatformFolderVisitor Visitor;
+	IFileManager::Get().IterateDirectory(*StagedBuildsDir, Visitor);
+
+	// Windows is where most subscribers are, so it gets the primary item
+	Visitor.PlatformFolders.Sort([](const FString& A, const FString& B)
+	{
+		const bool bAIsWindows = A.StartsWith(TEXT("Windows"));
+		const bool bBIsWindows = B.StartsWith(TEXT("Windows"));
+
+		return bAIsWindows != bBIsWindows ? bAIsWindows : A < B;
+	});
+
+	return Visitor.PlatformFolders;
+}
+
+TArray<FString> FWorkshopStagedContent::GetContentPlatforms(const FString& ContentFolder)
+{
+	TArray<FString> Platforms = FindStagedPlatforms(ContentFolder);
+
+	const FString FolderName = FPaths::GetCleanFilename(ContentFolder);
+	if (Platforms.Num() == 0 && IsPlatformFolderName(FolderName))
+		Platforms.Add(FolderName);
+
+	return Platforms;
+}
+
+FString FWorkshopStagedContent::GetPrimaryContentFolder(const FString& Package)
+{
+	const FString StagedBuildsDir = GetStagedBuildsDir(Package);
+	const TArray<FString> Platforms = FindStagedPlatforms(StagedBuildsDir);
+
+	return Platforms.Num() > 1 ? StagedBuildsDir / Platforms[0] : StagedBuildsDir;
+}
@@ -0,0 +1,21 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Where packaged mods are staged and which platforms were staged for them */
+struct FWorkshopStagedContent
+{
+	/* Absolute path of a mod's Saved/StagedBuilds folder, under the folder discovery found it in */
+	static FString GetStagedBuildsDir(const FString& Package);
+
+	/* Names of the platform folders (WindowsNoEditor, LinuxNoEditor, Mac...) under StagedBuildsDir, Windows first */
+	static TArray<FString> FindStagedPlatforms(const FString& StagedBuildsDir);
+
+	/* Platforms in a content folder, either the platform folders inside it or the folder itself if it's a platform folder */
+	static TArray<FString> GetContentPlatforms(const FString& ContentFolder);
+
+	/* Folder the primary item's content comes from, the first platform's folder when more than one platform was staged */
+	static FString GetPrimaryContentFolder(const FString& Package);
+};
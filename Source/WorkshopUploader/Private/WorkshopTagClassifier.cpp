@@ -0,0 +1,156 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopTagClassifier.h"
+#include "WorkshopUploader.h"
+#include "IPlatformFilePak.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* TagConfigSection = TEXT("WorkshopUploader");
+
+/* Used for configured tags that have no TagRules of their own, cooked content keeps its folder layout so folder names say a lot */
+static const TArray<FWorkshopTagRule>& GetBuiltInRules()
+{
+	static const TArray<FWorkshopTagRule> BuiltInRules = {
+		{ TEXT("Map"), { TEXT("*.umap") } },
+		{ TEXT("Maps"), { TEXT("*.umap") } },
+		{ TEXT("Characters"), { TEXT("*/Characters/*"), TEXT("*/Character/*"), TEXT("*/Skins/*") } },
+		{ TEXT("Weapons"), { TEXT("*/Weapons/*"), TEXT("*/Weapon/*") } },
+		{ TEXT("Vehicles"), { TEXT("*/Vehicles/*"), TEXT("*/Vehicle/*") } },
+		{ TEXT("Audio"), { TEXT("*/Audio/*"), TEXT("*/Sounds/*"), TEXT("*/Sound/*"), TEXT("*/Music/*"), TEXT("*.bnk"), TEXT("*.wem") } },
+		{ TEXT("UI"), { TEXT("*/UI/*"), TEXT("*/Widgets/*"), TEXT("*/HUD/*") } },
+		{ TEXT("Blueprints"), { TEXT("*/Blueprints/*") } },
+	};
+	return BuiltInRules;
+}
+
+FWorkshopTagSettings FWorkshopTagSettings::Load()
+{
+	FWorkshopTagSettings Settings;
+
+	GConfig->GetArray(TagConfigSection, TEXT("Tags"), Settings.Tags, GGameIni);
+	GConfig->GetInt(TagConfigSection, TEXT("MinTagMatches"), Settings.MinMatches, GGameIni);
+
+	if (Settings.Tags.Num() == 0)
+		Settings.Tags = { TEXT("Map"), TEXT("Mod") };
+
+	TArray<FString> RuleLines;
+	GConfig->GetArray(TagConfigSection, TEXT("TagRules"), RuleLines, GGameIni);
+
+	for (const FString& Line : RuleLines)
+	{
+		FWorkshopTagRule Rule;
+		FString Patterns;
+
+		if (!Line.Split(TEXT("="), &Rule.Tag, &Patterns) || !Settings.Tags.Contains(Rule.Tag.TrimStartAndEnd()))
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Ignoring tag rule \"%s\", it should be one of the configured Tags followed by =Pattern;Pattern"), *Line);
+			continue;
+		}
+
+		Rule.Tag.TrimStartAndEndInline();
+		Patterns.ParseIntoArray(Rule.Patterns, TEXT(";"));
+
+		Settings.Rules.Add(MoveTemp(Rule));
+	}
+
+	for (const FString& Tag : Settings.Tags)
+	{
+		if (Settings.Rules.ContainsByPredicate([&Tag](const FWorkshopTagRule& Rule) { return Rule.Tag == Tag; }))
+			continue;
+
+		if (const FWorkshopTagRule* BuiltInRule = GetBuiltInRules().FindByPredicate([&Tag](const FWorkshopTagRule& Rule) { return Rule.Tag == Tag; }))
+			Settings.Rules.Add({ Tag, BuiltInRule->Patterns });
+	}
+
+	return Settings;
+}
+
+TArray<FString> FWorkshopTagClassification::GetSuggestedTags(const FWorkshopTagSettings& Settings) const
+{
+	TArray<FString> Tags;
+
+	for (const FString& Tag : Settings.Tags)
+	{
+		if (Matches.FindRef(Tag) >= FMath::Max(1, Settings.MinMatches))
+			Tags.Add(Tag);
+	}
+
+	return Tags;
+}
+
+FString FWorkshopTagClassification::Describe() const
+{
+	TArray<FString> Parts;
+
+	for (const TPair<FString, int32>& Entry : Matches)
+		Parts.Add(FString::Printf(TEXT("%s (%d files)"), *Entry.Key, Entry.Value));
+
+	return FString::Printf(TEXT("%d files scanned, %s"), NumFiles, Parts.Num() > 0 ? *FString::Join(Parts, TEXT(", ")) : TEXT("no tags matched"));
+}
+
+TArray<FString> FWorkshopTagClassifier::ListStagedFiles(const FString& StagedBuildsDir)
+{
+	TArray<FString> Files;
+
+	TArray<FString> StagedFiles;
+	IFileManager::Get().FindFilesRecursive(StagedFiles, *StagedBuildsDir, TEXT("*"), true, false);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const FString& StagedFile : StagedFiles)
+	{
+		if (!StagedFile.EndsWith(TEXT(".pak")))
+		{
+			Files.Add(StagedFile);
+			continue;
+		}
+
+		// Only the index is read, not the packed files themselves
+		TRefCountPtr<FPakFile> PakFile = new FPakFile(&PlatformFile, *StagedFile, false);
+		if (!PakFile->IsValid())
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't read the index of %s, its files won't be used to suggest tags"), *StagedFile);
+			continue;
+		}
+
+		const FString MountPoint = PakFile->GetMountPoint();
+
+		for (FPakFile::FFilenameIterator It(*PakFile); It; ++It)
+			Files.Add(MountPoint / It.Filename());
+	}
+
+	return Files;
+}
+
+FWorkshopTagClassification FWorkshopTagClassifier::Classify(const FString& StagedBuildsDir, const FWorkshopTagSettings& Settings)
+{
+	FWorkshopTagClassification Classification;
+
+	const TArray<FString> Files = ListStagedFiles(StagedBuildsDir);
+	Classification.NumFiles = Files.Num();
+
+	for (const FWorkshopTagRule& Rule : Settings.Rules)
+	{
+		int32 NumMatches = 0;
+
+		for (const FString& File : Files)
+		{
+			for (const FString& Pattern : Rule.Patterns)
+			{
+				if (File.MatchesWildcard(Pattern))
+				{
+					++NumMatches;
+					break;
+				}
+			}
+		}
+
+		if (NumMatches > 0)
+			Classification.Matches.FindOrAdd(Rule.Tag) += NumMatches;
+	}
+
+	return Classification;
+}
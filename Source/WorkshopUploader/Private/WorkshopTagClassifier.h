@@ -0,0 +1,54 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Staged files matching any of Patterns (wildcards against the full path, case insensitive, separated by ; in config) suggest Tag */
+struct FWorkshopTagRule
+{
+	FString Tag;
+	TArray<FString> Patterns;
+};
+
+/**
+ * The game's Workshop tags, read from the [WorkshopUploader] section of the project's game config:
+ *
+ *   +Tags=Map
+ *   +Tags=Weapons
+ *   +TagRules=Weapons=*Weapons*;*Guns*
+ *
+ * Tags without a TagRules entry fall back to the built in rules for common ones (Map, Characters, Weapons, Audio...)
+ */
+struct FWorkshopTagSettings
+{
+	/* Set these to what the game's Workshop tags are set to in Steamworks */
+	TArray<FString> Tags;
+	TArray<FWorkshopTagRule> Rules;
+
+	/* A tag needs this many matching files to be suggested */
+	int32 MinMatches = 1;
+
+	static FWorkshopTagSettings Load();
+};
+
+/* How many of a mod's staged files each tag's rules matched */
+struct FWorkshopTagClassification
+{
+	int32 NumFiles = 0;
+	TMap<FString, int32> Matches;
+
+	/* Tags with at least MinMatches files, in the order the settings list them */
+	TArray<FString> GetSuggestedTags(const FWorkshopTagSettings& Settings) const;
+
+	FString Describe() const;
+};
+
+/* Suggests tags for a mod from the file names in its staged pak indices, or its loose files if it wasn't staged into paks */
+struct FWorkshopTagClassifier
+{
+	/* Every file in the paks under StagedBuildsDir, with their mount points, followed by the loose files that aren't paks */
+	static TArray<FString> ListStagedFiles(const FString& StagedBuildsDir);
+
+	static FWorkshopTagClassification Classify(const FString& StagedBuildsDir, const FWorkshopTagSettings& Settings);
+};
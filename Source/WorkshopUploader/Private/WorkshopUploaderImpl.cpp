@@ -0,0 +1,1951 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopUploaderImpl.h"
+#include "WorkshopUploader.h"
+#include "CoreMinimal.h"
+#include "Misc/MessageDialog.h"
+#include "WorkshopUploaderViewModel.h"
+#include "SWorkshopUploaderPanel.h"
+#include "WorkshopPatchAnalyzer.h"
+#include "WorkshopPackagePipeline.h"
+#include "WorkshopBulkEditor.h"
+#include "WorkshopCallScheduler.h"
+#include "WorkshopWatchMode.h"
+#include "WorkshopStagedContent.h"
+#include "WorkshopSharedContent.h"
+#include "WorkshopSizeBudget.h"
+#include "WorkshopTagClassifier.h"
+#include "WorkshopItemMetadata.h"
+#include "WorkshopLocalization.h"
+#include "WorkshopPreviewImages.h"
+#include "WorkshopSmokeTest.h"
+#include "WorkshopRepack.h"
+#include "WorkshopBackgroundTasks.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Layout/SBox.h"
+
+#define LOCTEXT_NAMESPACE "FWorkshopUploaderModule"
+
+FWorkshopUploaderImpl::FWorkshopUploaderImpl()
+	: CallScheduler(MakeShared<FWorkshopCallScheduler>(IWorkshopBackend::Create(), FWorkshopCallSchedulerSettings::Load()))
+	, Backend(CallScheduler)
+	, BackgroundTasks(MakeShared<FWorkshopBackgroundTasks>())
+	, ViewModel(MakeShared<FWorkshopUploaderViewModel>(BackgroundTasks))
+{
+	Pipeline = MakeUnique<FWorkshopPackagePipeline>([this](const FString& Package, TFunction<void(bool, const FString&)> OnComplete)
+	{
+		PublishPackagedMod(Package, ViewModel->PipelineChangeNote, MoveTemp(OnComplete));
+	});
+
+	Pipeline->OnJobsChanged.AddRaw(this, &FWorkshopUploaderImpl::HandlePipelineJobsChanged);
+
+	BulkEditor = MakeUnique<FWorkshopBulkEditor>(Backend);
+	BulkEditor->OnResultsChanged.AddRaw(this, &FWorkshopUploaderImpl::HandleBulkEditResultsChanged);
+
+	WatchMode = MakeUnique<FWorkshopWatchMode>([this](const FString& Package, uint64 PublishedFileId, TFunction<void(bool, const FString&)> OnComplete)
+	{
+		PublishWatchedMod(Package, PublishedFileId, MoveTemp(OnComplete));
+	});
+
+	WatchMode->OnWatchesChanged.AddRaw(this, &FWorkshopUploaderImpl::HandleWatchesChanged);
+
+	ViewModel->OnDraftPackageChanged.AddRaw(this, &FWorkshopUploaderImpl::HandleDraftPackageChanged);
+
+	SmokeTester = MakeUnique<FWorkshopSmokeTester>();
+	Repacker = MakeUnique<FWorkshopRepacker>(BackgroundTasks);
+}
+
+FWorkshopUploaderImpl::~FWorkshopUploaderImpl()
+{
+	Pipeline.Reset();
+	WatchMode.Reset();
+	SmokeTester.Reset();
+	Repacker.Reset();
+
+	ViewModel->SaveDrafts();
+}
+
+bool FWorkshopUploaderImpl::Tick(float DeltaTime)
+{
+	Backend->Tick();
+	Pipeline->Tick();
+	WatchMode->Tick();
+	SmokeTester->Tick();
+	Repacker->Tick();
+	ViewModel->Tick(DeltaTime);
+
+	if (CallScheduler->IsBusy() && FPlatformTime::Seconds() >= NextCallStatsRefreshTime)
+	{
+		NextCallStatsRefreshTime = FPlatformTime::Seconds() + 1.0;
+
+		if (Pipeline->IsRunning())
+			HandlePipelineJobsChanged();
+		if (BulkEditor->IsRunning())
+			HandleBulkEditResultsChanged();
+	}
+
+	BackgroundTasks->Tick();
+
+	return true;
+}
+
+bool FWorkshopUploaderImpl::TryInitializeWorkshop()
+{
+	return Backend->TryInitialize();
+}
+
+TSharedRef<SDockTab> FWorkshopUploaderImpl::SpawnTab()
+{
+	// The workshop uploader can't function without SteamUGC which requires steam to be running
+	if (!Backend->IsAvailable())
+	{
+		FText WidgetText = LOCTEXT("SteamNotRunning", "Steam needs to be running in order for the workshop uploader to function, please make sure Steam is running and then restart the editor.");
+
+		return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SBox)
+			.HAlign(HAlign_Center)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(WidgetText)
+				.AutoWrapText(true)
+				.Font(FCoreStyle::GetDefaultFontStyle("Bold", 13))
+			]
+		];
+	}
+
+	// Build the panel once and reuse it, reopening the tab keeps everything that was entered
+	if (!Panel.IsValid())
+	{
+		Panel = SNew(SWorkshopUploaderPanel)
+			.ViewModel(ViewModel)
+			.OnPublishNewMod_Raw(this, &FWorkshopUploaderImpl::OnPublishNewModClicked)
+			.OnPublishUpdateMod_Raw(this, &FWorkshopUploaderImpl::OnPublishUpdateModClicked)
+			.OnAnalyzePatch_Raw(this, &FWorkshopUploaderImpl::OnAnalyzePatchClicked)
+			.OnPackageAndPublish_Raw(this, &FWorkshopUploaderImpl::OnPackageAndPublishClicked)
+			.OnCancelPipeline_Raw(this, &FWorkshopUploaderImpl::OnCancelPipelineClicked)
+			.OnAnalyzeSharedContent_Raw(this, &FWorkshopUploaderImpl::OnAnalyzeSharedContentClicked)
+			.OnSplitSharedContent_Raw(this, &FWorkshopUploaderImpl::OnSplitSharedContentClicked)
+			.OnLoadPublishedItems_Raw(this, &FWorkshopUploaderImpl::OnLoadPublishedItemsClicked)
+			.OnApplyBulkEdit_Raw(this, &FWorkshopUploaderImpl::OnApplyBulkEditClicked)
+			.OnCancelBulkEdit_Raw(this, &FWorkshopUploaderImpl::OnCancelBulkEditClicked)
+			.OnWatchUpdateMod_Raw(this, &FWorkshopUploaderImpl::OnWatchUpdateModClicked)
+			.OnStopWatching_Raw(this, &FWorkshopUploaderImpl::OnStopWatchingClicked)
+			.OnAnalyzeSizes_Raw(this, &FWorkshopUploaderImpl::OnAnalyzeSizesClicked);
+	}
+
+	return SNew(SDockTab)
+	.TabRole(ETabRole::NomadTab)
+	[
+		Panel.ToSharedRef()
+	];
+}
+
+/* FReply events */
+
+FReply FWorkshopUploaderImpl::OnPublishNewModClicked()
+{
+	FString MissingFields = ViewModel->GetDraft(false).GetMissingFields(false);
+
+	if (!MissingFields.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("These fields must be filled in order to publish: %s"), *MissingFields)));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetStatus(false, EWorkshopUploadState::InProgress, FText::FromString("Publishing to Steam Workshop, please wait..."));
+
+	Backend->CreateItem(Backend->GetAppId(), [this](const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+	{
+		onItemCreated(Result, PublishedFileId, bNeedsLegalAgreement);
+	});
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnPublishUpdateModClicked()
+{
+	const FWorkshopItemDraft& Draft = ViewModel->GetDraft(true);
+	FString MissingFields = Draft.GetMissingFields(true);
+
+	if (!MissingFields.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("These fields must be filled in order to publish: %s"), *MissingFields)));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetStatus(true, EWorkshopUploadState::InProgress, FText::FromString("Publishing to Steam Workshop, please wait..."));
+
+	UpdateWorkshopItem(Backend->GetAppId(), Draft.GetWorkshopId(), true);
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnAnalyzePatchClicked()
+{
+	const FWorkshopItemDraft& Draft = ViewModel->GetDraft(true);
+
+	if (Draft.WorkshopId.IsEmpty() || Draft.Package.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("AnalyzePatchMissingFields", "Fill in the Workshop ID and select the packaged mod before analyzing the patch size."));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetPatchReport(true, LOCTEXT("AnalyzingPatch", "Hashing staged content, please wait..."));
+
+	const FString ContentFolder = FWorkshopStagedContent::GetPrimaryContentFolder(Draft.Package);
+	const uint64 PublishedFileId = Draft.GetWorkshopId();
+	TSharedRef<FWorkshopPatchReport> Report = MakeShared<FWorkshopPatchReport>();
+
+	BackgroundTasks->Run([ContentFolder, PublishedFileId, Report]()
+	{
+		*Report = FWorkshopPatchAnalyzer::AnalyzeFolder(ContentFolder, PublishedFileId);
+	},
+	[this, Report]()
+	{
+		ViewModel->SetPatchReport(false, FText::FromString(Report->ToString()));
+	});
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnPackageAndPublishClicked()
+{
+	if (ViewModel->PipelineSelection.Num() == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("PipelineNothingSelected", "Select at least one mod to package and publish."));
+
+		return FReply::Handled();
+	}
+
+	// Dependencies come from each mod's .uplugin, the pipeline publishes them in that order
+	TMap<FString, TArray<FString>> PackageDependencies;
+	for (const FString& Package : ViewModel->PipelineSelection)
+		PackageDependencies.Add(Package, ViewModel->GetModDependencies(Package));
+
+	Pipeline->Enqueue(PackageDependencies);
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnCancelPipelineClicked()
+{
+	Pipeline->Cancel();
+
+	return FReply::Handled();
+}
+
+TArray<FString> FWorkshopUploaderImpl::GetSharedContentPackages() const
+{
+	if (ViewModel->PipelineSelection.Num() > 0)
+	{
+		TArray<FString> Packages = ViewModel->PipelineSelection.Array();
+		Packages.Sort();
+		return Packages;
+	}
+
+	TArray<FString> Packages;
+	for (const FString& Package : ViewModel->GetProjectMods())
+	{
+		if (FWorkshopStagedContent::FindStagedPlatforms(FWorkshopStagedContent::GetStagedBuildsDir(Package)).Num() > 0)
+			Packages.Add(Package);
+	}
+	return Packages;
+}
+
+FReply FWorkshopUploaderImpl::OnAnalyzeSharedContentClicked()
+{
+	const TArray<FString> Packages = GetSharedContentPackages();
+
+	if (Packages.Num() < 2)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("SharedContentNeedsMods", "At least two packaged mods are needed to look for shared content."));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetSharedContentReport(true, LOCTEXT("AnalyzingSharedContent", "Fingerprinting staged content, please wait..."));
+
+	TSharedRef<FWorkshopDedupReport> Report = MakeShared<FWorkshopDedupReport>();
+
+	BackgroundTasks->Run([Packages, Report]()
+	{
+		*Report = FWorkshopSharedContent::Analyze(Packages);
+	},
+	[this, Report]()
+	{
+		LastDedupReport = Report;
+		ViewModel->SetSharedContentReport(false, FText::FromString(Report->ToString()));
+	});
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnAnalyzeSizesClicked()
+{
+	const TArray<FString> Packages = GetSharedContentPackages();
+
+	if (Packages.Num() == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("SizeBudgetNeedsMods", "Package a mod before analyzing its size."));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetSizeReport(true, LOCTEXT("AnalyzingSizes", "Measuring staged content, please wait..."));
+
+	MeasureStagedSizes(Packages, [this](const TArray<FWorkshopSizeReport>& Reports, const TArray<FString>& Platforms)
+	{
+		const FWorkshopSizeBudgets& Budgets = ViewModel->GetSizeBudgets();
+
+		FString Report;
+		int64 TotalSize = 0;
+
+		for (int32 Index = 0; Index < Reports.Num(); ++Index)
+		{
+			const FWorkshopSizeReport& SizeReport = Reports[Index];
+			TotalSize += SizeReport.TotalSize;
+
+			if (!Platforms[Index].IsEmpty())
+				Report += FString::Printf(TEXT("[%s] "), *Platforms[Index]);
+
+			Report += SizeReport.Describe(Budgets.GetBudget(SizeReport.Package)) + TEXT("\n");
+		}
+
+		uint64 TotalQuota = 0, AvailableQuota = 0;
+		const bool bHasQuota = Backend->GetStorageQuota(TotalQuota, AvailableQuota);
+
+		Report += FString::Printf(TEXT("%d staged builds, %.1f MB in total"), Reports.Num(), TotalSize / (1024.0 * 1024.0));
+
+		if (bHasQuota)
+			Report += FString::Printf(TEXT(", %.1f MB of the account's %.1f MB quota left"), AvailableQuota / (1024.0 * 1024.0), TotalQuota / (1024.0 * 1024.0));
+
+		Report += TEXT("\n");
+
+		const FWorkshopSizeCheck SizeCheck = FWorkshopSizeCheck::Check(Reports, Budgets, bHasQuota ? (int64)AvailableQuota : -1);
+
+		if (!SizeCheck.Error.IsEmpty())
+			Report += FString::Printf(TEXT("Publishing would be blocked: %s\n"), *SizeCheck.Error);
+
+		for (const FString& Warning : SizeCheck.Warnings)
+			Report += FString::Printf(TEXT("Warning: %s\n"), *Warning);
+
+		ViewModel->SetSizeReport(false, FText::FromString(Report));
+	});
+
+	return FReply::Handled();
+}
+
+void FWorkshopUploaderImpl::MeasureStagedSizes(const TArray<FString>& Packages, TFunction<void(const TArray<FWorkshopSizeReport>& Reports, const TArray<FString>& Platforms)> OnComplete)
+{
+	// Every staged platform is measured on its own against the staged build its item was last published from
+	struct FSizeTarget
+	{
+		FString Package;
+		FString Platform;
+		FString ContentFolder;
+		uint64 PublishedFileId = 0;
+	};
+
+	TArray<FSizeTarget> Targets;
+
+	for (const FString& Package : Packages)
+	{
+		const FString StagedBuildsDir = FWorkshopStagedContent::GetStagedBuildsDir(Package);
+		const TArray<FString> Platforms = FWorkshopStagedContent::FindStagedPlatforms(StagedBuildsDir);
+		const uint64 PrimaryItem = ViewModel->FindWorkshopIdForPackage(Package);
+
+		if (Platforms.Num() <= 1)
+		{
+			Targets.Add({ Package, FString(), StagedBuildsDir, PrimaryItem });
+			continue;
+		}
+
+		for (int32 PlatformIndex = 0; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+		{
+			const uint64 PlatformItem = (PlatformIndex == 0 || PrimaryItem == 0) ? PrimaryItem : ViewModel->FindPlatformItem(PrimaryItem, Platforms[PlatformIndex]);
+			Targets.Add({ Package, Platforms[PlatformIndex], StagedBuildsDir / Platforms[PlatformIndex], PlatformItem });
+		}
+	}
+
+	TSharedRef<TArray<FWorkshopSizeReport>> Reports = MakeShared<TArray<FWorkshopSizeReport>>();
+	Reports->SetNum(Targets.Num());
+
+	BackgroundTasks->Run([Targets, Reports]()
+	{
+		// Each mod and platform is its own folder, so they're all measured at once
+		ParallelFor(Targets.Num(), [&Targets, &Reports](int32 Index)
+		{
+			const FSizeTarget& Target = Targets[Index];
+
+			// Not what was uploaded, which repacking or the shared item split changes, so growth compares staged build with staged build
+			FWorkshopContentManifest Published;
+			const bool bPublished = Target.PublishedFileId != 0 && FWorkshopContentManifest::LoadSource(Target.PublishedFileId, Published);
+
+			(*Reports)[Index] = FWorkshopSizeReport::Analyze(Target.Package, Target.ContentFolder, bPublished ? &Published : nullptr);
+		});
+	},
+	[Targets, Reports, OnComplete]()
+	{
+		TArray<FString> Platforms;
+		for (const FSizeTarget& Target : Targets)
+			Platforms.Add(Target.Platform);
+
+		OnComplete(*Reports, Platforms);
+	});
+}
+
+FReply FWorkshopUploaderImpl::OnSplitSharedContentClicked()
+{
+	if (!LastDedupReport.IsValid())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("SharedContentNotAnalyzed", "Analyze the mods for shared content first."));
+
+		return FReply::Handled();
+	}
+
+	const FWorkshopSharedContentPlan Plan = FWorkshopSharedContent::MakePlan(*LastDedupReport);
+
+	if (Plan.Files.Num() == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("NoSharedContent", "None of the duplicated files are big enough to be worth moving into a shared item."));
+
+		return FReply::Handled();
+	}
+
+	ViewModel->SetSharedContentReport(true, LOCTEXT("StagingSharedContent", "Staging and publishing the shared items, please wait..."));
+
+	TSharedRef<bool> bStaged = MakeShared<bool>(true);
+
+	BackgroundTasks->Run([Plan, bStaged]()
+	{
+		for (const FWorkshopSharedItem& Item : Plan.Items)
+			*bStaged &= FWorkshopSharedContent::StageSharedItem(Plan, Item.Platform);
+	},
+	[this, Plan, bStaged]()
+	{
+		if (!*bStaged)
+		{
+			ViewModel->SetSharedContentReport(false, LOCTEXT("StagingSharedContentFailed", "Couldn't stage the shared items, see the output log."));
+			return;
+		}
+
+		// Every platform's shared item is checked as one batch, before any of them is created
+		TArray<FSizedUpload> Uploads;
+		for (const FWorkshopSharedItem& Item : Plan.Items)
+		{
+			const FString Name = Item.Platform.IsEmpty() ? FString(TEXT("Shared Content")) : FString::Printf(TEXT("Shared Content (%s)"), *Item.Platform);
+			Uploads.Add({ Name, FWorkshopSharedContentPlan::GetSharedStagingDir(Item.Platform), Item.PublishedFileId, false });
+		}
+
+		CheckUploadSizes(Uploads, [this, Plan](const FString& Error)
+		{
+			if (!Error.IsEmpty())
+			{
+				ViewModel->SetSharedContentReport(false, FText::FromString(FString::Printf(TEXT("The shared items weren't published! %s"), *Error)));
+				return;
+			}
+
+			PublishSharedItems(Plan);
+		});
+	});
+
+	return FReply::Handled();
+}
+
+void FWorkshopUploaderImpl::PublishSharedItems(const FWorkshopSharedContentPlan& Plan)
+{
+	// Every platform's shared item is created if it has to be and uploaded alongside the others
+	struct FSharedSubmission
+	{
+		FWorkshopSharedContentPlan Plan;
+		TArray<FString> ItemResults;
+		int32 NumPending = 0;
+	};
+
+	TSharedRef<FSharedSubmission> Submission = MakeShared<FSharedSubmission>();
+	Submission->Plan = Plan;
+	Submission->ItemResults.SetNum(Plan.Items.Num());
+	Submission->NumPending = Plan.Items.Num();
+
+	auto OnItemSubmitted = [this, Submission](int32 ItemIndex, const FWorkshopResult& Result)
+	{
+		FWorkshopSharedItem& Item = Submission->Plan.Items[ItemIndex];
+		const FString ItemName = Item.Platform.IsEmpty() ? FString(TEXT("Shared item")) : FString::Printf(TEXT("%s shared item"), *Item.Platform);
+
+		// Dependents only drop their copies of a platform's files once they're really in its shared item
+		Item.bPublished = Result.bSuccess;
+		Submission->ItemResults[ItemIndex] = Result.bSuccess ? FString::Printf(TEXT("%s %llu published."), *ItemName, Item.PublishedFileId) : FString::Printf(TEXT("%s submission failed! %s"), *ItemName, *Result.Message);
+
+		if (--Submission->NumPending > 0)
+			return;
+
+		// Saved whatever happened, so items that were created are updated next time rather than created again
+		Submission->Plan.Save();
+
+		FString Report = FString::Join(Submission->ItemResults, TEXT("\n"));
+		if (Submission->Plan.GetPublishedItems().Num() > 0)
+			Report += FString::Printf(TEXT("\nPublish %s again to drop their copies and depend on them."), *FString::Join(Submission->Plan.Packages, TEXT(", ")));
+
+		ViewModel->SetSharedContentReport(false, FText::FromString(Report));
+	};
+
+	for (int32 ItemIndex = 0; ItemIndex < Plan.Items.Num(); ++ItemIndex)
+	{
+		const FString Platform = Plan.Items[ItemIndex].Platform;
+
+		auto SubmitToItem = [this, Submission, ItemIndex, Platform, OnItemSubmitted](uint64 ItemId)
+		{
+			Submission->Plan.Items[ItemIndex].PublishedFileId = ItemId;
+
+			FWorkshopItemUpdate Update;
+			Update.ConsumerAppId = Backend->GetAppId();
+			Update.PublishedFileId = ItemId;
+			Update.Title = Platform.IsEmpty() ? FString(TEXT("Shared Content")) : FString::Printf(TEXT("Shared Content (%s)"), *Platform);
+			Update.Description = FString::Printf(TEXT("Content shared by %s."), *FString::Join(Submission->Plan.Packages, TEXT(", ")));
+			Update.KeyValueTags.Emplace(TEXT("shared_content"), TEXT("1"));
+			Update.ContentFolder = FWorkshopSharedContentPlan::GetSharedStagingDir(Platform);
+			Update.ChangeNote = TEXT("Updated shared content.");
+
+			if (!Platform.IsEmpty())
+				Update.KeyValueTags.Emplace(TEXT("platform"), Platform);
+
+			SubmitItemContent(Update, FString(), FString(), [ItemIndex, OnItemSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+			{
+				OnItemSubmitted(ItemIndex, Result);
+			});
+		};
+
+		if (Plan.Items[ItemIndex].PublishedFileId != 0)
+		{
+			SubmitToItem(Plan.Items[ItemIndex].PublishedFileId);
+			continue;
+		}
+
+		Backend->CreateItem(Backend->GetAppId(), [this, ItemIndex, SubmitToItem, OnItemSubmitted](const FWorkshopResult& Result, uint64 NewPublishedFileId, bool bNeedsLegalAgreement)
+		{
+			if (!Result.bSuccess)
+			{
+				FWorkshopResult CreateResult = Result;
+				CreateResult.Message = FString::Printf(TEXT("Couldn't create it: %s"), *Result.Message);
+
+				OnItemSubmitted(ItemIndex, CreateResult);
+				return;
+			}
+
+			if (bNeedsLegalAgreement)
+				Backend->ShowLegalAgreement(NewPublishedFileId);
+
+			SubmitToItem(NewPublishedFileId);
+		});
+	}
+}
+
+void FWorkshopUploaderImpl::HandlePipelineJobsChanged()
+{
+	ViewModel->SetPipelineStatus(Pipeline->IsRunning(), FText::FromString(Pipeline->Describe() + DescribeCallStats()));
+}
+
+FReply FWorkshopUploaderImpl::OnLoadPublishedItemsClicked()
+{
+	ViewModel->SetBulkEditStatus(true, LOCTEXT("LoadingPublishedItems", "Loading your published items..."));
+
+	Backend->QueryPublishedItems(Backend->GetAppId(), [this](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Items)
+	{
+		if (!Result.bSuccess)
+		{
+			ViewModel->SetBulkEditStatus(false, FText::FromString(FString::Printf(TEXT("Couldn't load your published items! %s"), *Result.Message)));
+			return;
+		}
+
+		// Titles are only there to make the list readable, the IDs are what's used
+		FString ItemList;
+		for (const FWorkshopItemDetails& Item : Items)
+			ItemList += FString::Printf(TEXT("%llu %s\n"), Item.PublishedFileId, *Item.Title);
+
+		ViewModel->SetBulkItems(FText::FromString(ItemList), true);
+		ViewModel->SetBulkEditStatus(false, FText::FromString(FString::Printf(TEXT("Loaded %d published items, remove the lines of the ones to leave alone."), Items.Num())));
+	});
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnApplyBulkEditClicked()
+{
+	TArray<FString> Lines;
+	ViewModel->GetBulkItems().ToString().ParseIntoArrayLines(Lines);
+
+	TArray<uint64> PublishedFileIds;
+	for (const FString& Line : Lines)
+	{
+		if (const uint64 PublishedFileId = FCString::Strtoui64(*Line.TrimStart(), nullptr, 10))
+			PublishedFileIds.AddUnique(PublishedFileId);
+	}
+
+	auto ParseTags = [](const FText& Tags)
+	{
+		TArray<FString> ParsedTags;
+		Tags.ToString().ParseIntoArray(ParsedTags, TEXT(","), true);
+
+		for (FString& Tag : ParsedTags)
+			Tag.TrimStartAndEndInline();
+
+		ParsedTags.RemoveAll([](const FString& Tag) { return Tag.IsEmpty(); });
+		return ParsedTags;
+	};
+
+	FWorkshopBulkEdit Edit;
+	if (ViewModel->BulkVisibilityIndex > 0)
+		Edit.Visibility = static_cast<EWorkshopVisibility>(ViewModel->BulkVisibilityIndex - 1);
+	Edit.AddTags = ParseTags(ViewModel->BulkAddTags);
+	Edit.RemoveTags = ParseTags(ViewModel->BulkRemoveTags);
+	Edit.DescriptionTemplate = ViewModel->BulkDescriptionTemplate.ToString();
+
+	if (PublishedFileIds.Num() == 0 || Edit.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("BulkEditNothingToDo", "List at least one item ID and pick something to change."));
+
+		return FReply::Handled();
+	}
+
+	BulkEditor->Start(Backend->GetAppId(), PublishedFileIds, Edit);
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnCancelBulkEditClicked()
+{
+	BulkEditor->Cancel();
+
+	return FReply::Handled();
+}
+
+void FWorkshopUploaderImpl::HandleBulkEditResultsChanged()
+{
+	ViewModel->SetBulkEditStatus(BulkEditor->IsRunning(), FText::FromString(BulkEditor->Describe() + DescribeCallStats()));
+}
+
+FReply FWorkshopUploaderImpl::OnWatchUpdateModClicked()
+{
+	const FWorkshopItemDraft& Draft = ViewModel->GetDraft(true);
+
+	if (Draft.WorkshopId.IsEmpty() || Draft.Package.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("WatchMissingFields", "Fill in the Workshop ID and select the packaged mod to watch."));
+
+		return FReply::Handled();
+	}
+
+	if (WatchMode->IsWatching(Draft.Package))
+		WatchMode->Unwatch(Draft.Package);
+
+	if (!WatchMode->Watch(Draft.Package, Draft.GetWorkshopId()))
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("Couldn't watch %s, see the output log."), *Draft.Package)));
+
+	return FReply::Handled();
+}
+
+FReply FWorkshopUploaderImpl::OnStopWatchingClicked()
+{
+	WatchMode->UnwatchAll();
+
+	return FReply::Handled();
+}
+
+void FWorkshopUploaderImpl::HandleDraftPackageChanged(bool IsUpdateMod)
+{
+	// Blank tags on the update form keep the item's current ones, so only new items get suggestions
+	if (IsUpdateMod)
+		return;
+
+	const FString Package = ViewModel->GetDraft(false).Package;
+
+	SuggestTags(Package, [this, Package](const TArray<FString>& Tags)
+	{
+		FWorkshopItemDraft& Draft = ViewModel->GetDraft(false);
+
+		// Another mod may have been picked while this one was being scanned
+		if (Tags.Num() == 0 || Draft.Package != Package)
+			return;
+
+		Draft.Tags = Tags;
+		ViewModel->MarkDraftsDirty();
+	});
+}
+
+void FWorkshopUploaderImpl::SuggestTags(const FString& Package, TFunction<void(const TArray<FString>& Tags)> OnComplete)
+{
+	TSharedRef<FWorkshopTagClassification> Classification = MakeShared<FWorkshopTagClassification>();
+	const FString StagedBuildsDir = FWorkshopStagedContent::GetStagedBuildsDir(Package);
+	const FWorkshopTagSettings TagSettings = ViewModel->GetTagSettings();
+
+	BackgroundTasks->Run([Classification, StagedBuildsDir, TagSettings]()
+	{
+		*Classification = FWorkshopTagClassifier::Classify(StagedBuildsDir, TagSettings);
+	},
+	[this, Package, Classification, OnComplete]()
+	{
+		const TArray<FString> Tags = Classification->GetSuggestedTags(ViewModel->GetTagSettings());
+
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Suggested tags for %s: %s (%s)"), *Package, Tags.Num() > 0 ? *FString::Join(Tags, TEXT(", ")) : TEXT("none"), *Classification->Describe());
+
+		OnComplete(Tags);
+	});
+}
+
+void FWorkshopUploaderImpl::HandleWatchesChanged()
+{
+	ViewModel->SetWatchStatus(WatchMode->IsWatchingAny(), FText::FromString(WatchMode->Describe()));
+}
+
+FString FWorkshopUploaderImpl::DescribeCallStats() const
+{
+	const FString Stats = CallScheduler->Describe();
+
+	return Stats.IsEmpty() ? Stats : TEXT("\nSteam calls\n") + Stats;
+}
+
+/* Workshop functions */
+
+void FWorkshopUploaderImpl::UpdateWorkshopItem(uint32 ConsumerAppId, uint64 PublishedFileID, bool IsUpdateMod)
+{
+	SubmitDraft(ViewModel->GetDraft(IsUpdateMod), ConsumerAppId, PublishedFileID, IsUpdateMod, [this, IsUpdateMod](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		onItemSubmitted(Result, bNeedsLegalAgreement, IsUpdateMod);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitDraft(const FWorkshopItemDraft& Draft, uint32 ConsumerAppId, uint64 PublishedFileID, bool IsUpdateMod, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// This is where the draft's text finally becomes strings, optional fields left blank on an update keep their current value
+	FWorkshopItemUpdate Update;
+	Update.ConsumerAppId = ConsumerAppId;
+	Update.PublishedFileId = PublishedFileID;
+
+	for (uint32 AppId : Draft.TargetAppIds)
+	{
+		if (AppId != 0 && AppId != ConsumerAppId)
+			Update.AdditionalAppIds.AddUnique(AppId);
+	}
+
+	if (!Draft.Title.IsEmpty() || !IsUpdateMod) { Update.Title = Draft.Title.ToString(); }
+	if (!Draft.Description.IsEmpty() || !IsUpdateMod) { Update.Description = Draft.Description.ToString(); }
+	if (Draft.Tags.Num() > 0 || !IsUpdateMod) { Update.Tags = Draft.Tags; }
+
+	if (!Draft.Thumbnail.IsEmpty() || !IsUpdateMod) { Update.PreviewFile = Draft.Thumbnail.ToString(); }
+	if (!IsUpdateMod && Draft.bIsVisible) { Update.Visibility = EWorkshopVisibility::Public; }
+
+	Update.ChangeNote = IsUpdateMod ? Draft.ChangeNote.ToString() : FString("Initial creation.");
+
+	// The draft's own text is the main language, a translation file for it would only overwrite that
+	Update.Localizations = FWorkshopLocalization::LoadPackageLocalizations(Draft.Package);
+	Update.Localizations.Remove(Update.Language);
+
+	const TArray<FString> Gallery = Draft.Gallery;
+	const bool bSendGallery = Gallery.Num() > 0 || !IsUpdateMod;
+	const FString Package = Draft.Package;
+
+	TSharedRef<FWorkshopItemUpdate> ProcessedUpdate = MakeShared<FWorkshopItemUpdate>(Update);
+	TSharedRef<TArray<FString>> PreviewErrors = MakeShared<TArray<FString>>();
+
+	// Loaded here, worker threads can't load modules
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	// Every image is checked and brought within Steam's limits before anything is uploaded
+	BackgroundTasks->Run([ImageWrapperModule, ProcessedUpdate, Gallery, bSendGallery, PreviewErrors]()
+	{
+		if (!ProcessedUpdate->PreviewFile.IsEmpty())
+		{
+			FWorkshopPreview Thumbnail;
+			FString Error;
+
+			if (FWorkshopPreviewImages::ProcessImage(*ImageWrapperModule, ProcessedUpdate->PreviewFile, Thumbnail, Error))
+				ProcessedUpdate->PreviewFile = Thumbnail.Value;
+			else
+				PreviewErrors->Add(Error);
+		}
+
+		if (bSendGallery)
+		{
+			TArray<FWorkshopPreview> ProcessedGallery;
+			FWorkshopPreviewImages::ProcessGallery(*ImageWrapperModule, Gallery, ProcessedGallery, *PreviewErrors);
+			ProcessedUpdate->Gallery = MoveTemp(ProcessedGallery);
+		}
+	},
+	[this, ProcessedUpdate, Package, PreviewErrors, OnSubmitted]()
+	{
+		if (PreviewErrors->Num() > 0)
+		{
+			FWorkshopResult Result;
+			Result.Message = FString::Printf(TEXT("Preview images need fixing: %s"), *FString::Join(*PreviewErrors, TEXT("; ")));
+
+			OnSubmitted(Result, false);
+			return;
+		}
+
+		SubmitDraftContent(*ProcessedUpdate, Package, OnSubmitted);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// Once the items are up, bring their Workshop dependencies in line with the mod's .uplugin. Drafts and watch mode both come through here
+	if (Update.PublishedFileId != 0)
+	{
+		const uint64 PrimaryItemId = Update.PublishedFileId;
+		OnSubmitted = [this, Package, PrimaryItemId, OnSubmitted = MoveTemp(OnSubmitted)](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			if (!Result.bSuccess)
+			{
+				OnSubmitted(Result, bNeedsLegalAgreement);
+				return;
+			}
+
+			SyncModDependencies(Package, PrimaryItemId, [OnSubmitted, Result, bNeedsLegalAgreement]()
+			{
+				OnSubmitted(Result, bNeedsLegalAgreement);
+			});
+		};
+	}
+
+	if (Package.IsEmpty() || Update.PublishedFileId == 0)
+	{
+		RepackDraftContent(Update, Package, MoveTemp(OnSubmitted));
+		return;
+	}
+
+	// Hashed before anything is uploaded, so a build staged while the upload runs isn't taken for the one that was published
+	const FString SourceFolder = FWorkshopStagedContent::GetPrimaryContentFolder(Package);
+	const uint64 PublishedFileId = Update.PublishedFileId;
+	TSharedRef<FWorkshopContentManifest> SourceManifest = MakeShared<FWorkshopContentManifest>();
+
+	BackgroundTasks->Run([SourceFolder, SourceManifest]()
+	{
+		*SourceManifest = FWorkshopContentManifest::BuildCached(SourceFolder, FWorkshopContentManifest::GetCachedManifestPath(SourceFolder));
+	},
+	[this, Update, Package, PublishedFileId, SourceManifest, OnSubmitted]()
+	{
+		RepackDraftContent(Update, Package, [this, PublishedFileId, SourceManifest, OnSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			if (!Result.bSuccess)
+			{
+				OnSubmitted(Result, bNeedsLegalAgreement);
+				return;
+			}
+
+			// Saved before the caller hears about it, watch mode can check the mod again straight after
+			BackgroundTasks->Run([PublishedFileId, SourceManifest]()
+			{
+				SourceManifest->PublishedFileId = PublishedFileId;
+
+				if (!SourceManifest->Save(FWorkshopContentManifest::GetSourceManifestPath(PublishedFileId)))
+					UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't save the source manifest for item %llu"), PublishedFileId);
+			},
+			[Result, bNeedsLegalAgreement, OnSubmitted]()
+			{
+				OnSubmitted(Result, bNeedsLegalAgreement);
+			});
+		});
+	});
+}
+
+void FWorkshopUploaderImpl::RepackDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	const FString StagedBuildsDir = FWorkshopStagedContent::GetStagedBuildsDir(Package);
+
+	// Only a mod's own staged build is repacked, shared items are uploaded as they were split out
+	if (Package.IsEmpty() || !Repacker->Settings.bEnabled)
+	{
+		SmokeTestDraftContent(Update, Package, StagedBuildsDir, MoveTemp(OnSubmitted));
+		return;
+	}
+
+	// Every platform is repacked together before the smoke test, so the paks that are tested are the paks that are uploaded
+	Repacker->Repack(StagedBuildsDir, [this, Update, Package, StagedBuildsDir, OnSubmitted](const FWorkshopRepackReport& Report)
+	{
+		if (!Report.Error.IsEmpty())
+		{
+			FWorkshopResult Result;
+			Result.Message = FString::Printf(TEXT("%s couldn't be repacked, nothing was uploaded:\n%s"), *Package, *Report.Error);
+
+			OnSubmitted(Result, false);
+			return;
+		}
+
+		if (!Report.bRepacked)
+		{
+			SmokeTestDraftContent(Update, Package, StagedBuildsDir, OnSubmitted);
+			return;
+		}
+
+		// The cache entry stays pinned until the upload is done with it, so another mod's repack can't prune it mid-upload
+		const FString CacheEntryDir = Report.CacheEntryDir;
+
+		SmokeTestDraftContent(Update, Package, Report.OutputFolder, [this, CacheEntryDir, OnSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			if (Repacker.IsValid())
+				Repacker->Unpin(CacheEntryDir);
+
+			OnSubmitted(Result, bNeedsLegalAgreement);
+		});
+	});
+}
+
+void FWorkshopUploaderImpl::SmokeTestDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	if (Package.IsEmpty() || !SmokeTester->Settings.IsEnabled())
+	{
+		SubmitTestedContent(Update, Package, StagedBuildsDir, MoveTemp(OnSubmitted));
+		return;
+	}
+
+	// Content that doesn't mount or load is turned away before it costs an upload. It's tested as it will be uploaded, before any of it moves to the shared item
+	SmokeTestStagedContent(StagedBuildsDir, [this, Update, Package, StagedBuildsDir, OnSubmitted](const FWorkshopSmokeTestReport& Report)
+	{
+		if (Report.HasFailed())
+		{
+			FWorkshopResult Result;
+			Result.Message = FString::Printf(TEXT("%s failed its smoke test, nothing was uploaded:\n%s"), *Package, *Report.ToString());
+
+			OnSubmitted(Result, false);
+			return;
+		}
+
+		SubmitTestedContent(Update, Package, StagedBuildsDir, OnSubmitted);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitTestedContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// The shared items are only in the editor's app, copies of the mod in other apps keep their whole build
+	FWorkshopSharedContentPlan SharedPlan;
+	FWorkshopSharedContentPlan::Load(SharedPlan);
+
+	const FString StagingDir = SharedPlan.GetDependentContentDir(Package, StagedBuildsDir, Update.ConsumerAppId == Backend->GetAppId());
+
+	if (StagingDir != StagedBuildsDir)
+	{
+		// Upload the mod without the files that now live in the shared items, then make each platform's item depend on that platform's shared item
+		const TMap<FString, uint64> SharedItems = SharedPlan.GetPublishedItems();
+		TSharedRef<bool> bStaged = MakeShared<bool>(false);
+
+		BackgroundTasks->Run([SharedPlan, Package, StagedBuildsDir, bStaged]()
+		{
+			*bStaged = FWorkshopSharedContent::StageDependent(SharedPlan, Package, StagedBuildsDir);
+		},
+		[this, Update, Package, StagedBuildsDir, StagingDir, SharedItems, bStaged, OnSubmitted]()
+		{
+			if (!*bStaged)
+			{
+				FWorkshopResult Result;
+				Result.Message = FString::Printf(TEXT("Couldn't stage %s without its shared content, see the output log."), *Package);
+
+				OnSubmitted(Result, false);
+				return;
+			}
+
+			SubmitStagedContent(Update, Package, StagingDir, StagedBuildsDir, [this, Update, StagingDir, SharedItems, OnSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+			{
+				if (!Result.bSuccess)
+				{
+					OnSubmitted(Result, bNeedsLegalAgreement);
+					return;
+				}
+
+				// A build staged for one platform goes up whole as the draft's item, more than one is split into an item per platform
+				const TArray<FString> Platforms = FWorkshopStagedContent::FindStagedPlatforms(StagingDir);
+
+				TArray<TPair<uint64, uint64>> Links;
+				if (Platforms.Num() <= 1)
+				{
+					Links.Emplace(Update.PublishedFileId, SharedItems.FindRef(Platforms.Num() == 1 ? Platforms[0] : FString()));
+				}
+				else
+				{
+					for (int32 PlatformIndex = 0; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+					{
+						const uint64 ItemId = PlatformIndex == 0 ? Update.PublishedFileId : ViewModel->FindPlatformItem(Update.PublishedFileId, Platforms[PlatformIndex]);
+						Links.Emplace(ItemId, SharedItems.FindRef(Platforms[PlatformIndex]));
+					}
+				}
+
+				Links.RemoveAll([](const TPair<uint64, uint64>& Link) { return Link.Key == 0 || Link.Value == 0; });
+
+				if (Links.Num() == 0)
+				{
+					OnSubmitted(Result, bNeedsLegalAgreement);
+					return;
+				}
+
+				TSharedRef<int32> NumPending = MakeShared<int32>(Links.Num());
+
+				for (const TPair<uint64, uint64>& Link : Links)
+				{
+					const uint64 ItemId = Link.Key;
+					const uint64 SharedItemId = Link.Value;
+
+					Backend->AddDependency(ItemId, SharedItemId, [Result, bNeedsLegalAgreement, OnSubmitted, NumPending, ItemId, SharedItemId](const FWorkshopResult& DependencyResult)
+					{
+						// Already depending on it isn't worth failing the whole submission over
+						if (!DependencyResult.bSuccess)
+							UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't make item %llu depend on shared item %llu: %s"), ItemId, SharedItemId, *DependencyResult.Message);
+
+						if (--(*NumPending) == 0)
+							OnSubmitted(Result, bNeedsLegalAgreement);
+					});
+				}
+			});
+		});
+
+		return;
+	}
+
+	SubmitStagedContent(Update, Package, StagedBuildsDir, StagedBuildsDir, MoveTemp(OnSubmitted));
+}
+
+TArray<uint64> FWorkshopUploaderImpl::ResolveModDependencies(const FString& Package, const FString& Platform, uint32 AppId) const
+{
+	TArray<uint64> Dependencies;
+
+	for (const FString& Dependency : ViewModel->GetModDependencies(Package))
+	{
+		const uint64 DependencyId = ViewModel->FindWorkshopIdForPackage(Dependency);
+
+		if (DependencyId == 0)
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("%s depends on %s, which hasn't been published yet, so the Workshop won't know about it"), *Package, *Dependency);
+			continue;
+		}
+
+		// The dependency's build for the same platform. Its primary item carries the first platform it was staged for, or every platform if it has no platform folders
+		uint64 ItemId = DependencyId;
+		if (!Platform.IsEmpty())
+		{
+			const TArray<FString> DependencyPlatforms = FWorkshopStagedContent::FindStagedPlatforms(FWorkshopStagedContent::GetStagedBuildsDir(Dependency));
+			if (DependencyPlatforms.Num() > 0 && DependencyPlatforms[0] != Platform)
+				ItemId = ViewModel->FindPlatformItem(DependencyId, Platform);
+		}
+
+		// And that build's copy in the same app
+		if (ItemId != 0 && AppId != 0)
+			ItemId = ViewModel->FindAppItem(ItemId, AppId);
+
+		if (ItemId != 0)
+		{
+			Dependencies.AddUnique(ItemId);
+		}
+		else
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("%s depends on %s, which has no item for %s%s yet, so that item of %s won't link to it"),
+				*Package, *Dependency, *Platform, AppId != 0 ? *FString::Printf(TEXT(" in app %u"), AppId) : TEXT(""), *Package);
+		}
+	}
+
+	return Dependencies;
+}
+
+void FWorkshopUploaderImpl::SyncModDependencies(const FString& Package, uint64 PublishedFileId, TFunction<void()> OnComplete)
+{
+	// Every item the mod is published as links to the matching item of each dependency: same platform, same app
+	TArray<TPair<uint64, TArray<uint64>>> Items;
+
+	auto AddItem = [this, &Package, &Items](uint64 ItemId, const FString& Platform)
+	{
+		if (ItemId == 0)
+			return;
+
+		Items.Emplace(ItemId, ResolveModDependencies(Package, Platform));
+
+		for (uint32 AppId : ViewModel->GetAppsWithItem(ItemId))
+		{
+			if (const uint64 AppItemId = ViewModel->FindAppItem(ItemId, AppId))
+				Items.Emplace(AppItemId, ResolveModDependencies(Package, Platform, AppId));
+		}
+	};
+
+	const TArray<FString> Platforms = FWorkshopStagedContent::FindStagedPlatforms(FWorkshopStagedContent::GetStagedBuildsDir(Package));
+
+	if (Platforms.Num() <= 1)
+	{
+		AddItem(PublishedFileId, Platforms.Num() == 1 ? Platforms[0] : FString());
+	}
+	else
+	{
+		for (int32 PlatformIndex = 0; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+			AddItem(PlatformIndex == 0 ? PublishedFileId : ViewModel->FindPlatformItem(PublishedFileId, Platforms[PlatformIndex]), Platforms[PlatformIndex]);
+	}
+
+	struct FDependencyChange
+	{
+		uint64 ItemId;
+		uint64 Dependency;
+		bool bAdd;
+	};
+
+	TArray<FDependencyChange> Changes;
+
+	for (const TPair<uint64, TArray<uint64>>& Item : Items)
+	{
+		// Only links this tool made are removed, anything added on the Workshop page is left alone
+		const TArray<uint64> PreviousDependencies = ViewModel->GetItemDependencies(Item.Key);
+
+		for (uint64 Dependency : Item.Value)
+		{
+			if (!PreviousDependencies.Contains(Dependency))
+				Changes.Add({ Item.Key, Dependency, true });
+		}
+		for (uint64 Dependency : PreviousDependencies)
+		{
+			if (!Item.Value.Contains(Dependency))
+				Changes.Add({ Item.Key, Dependency, false });
+		}
+	}
+
+	if (Changes.Num() == 0)
+	{
+		OnComplete();
+		return;
+	}
+
+	TSharedRef<int32> NumPending = MakeShared<int32>(Changes.Num());
+
+	for (const FDependencyChange& Change : Changes)
+	{
+		const uint64 ItemId = Change.ItemId;
+		const uint64 Dependency = Change.Dependency;
+		const bool bAdd = Change.bAdd;
+
+		auto OnChanged = [this, NumPending, OnComplete, ItemId, Dependency, bAdd](const FWorkshopResult& Result)
+		{
+			// Each link is only recorded once Steam has it, one that failed is tried again on the next publish
+			if (Result.bSuccess)
+			{
+				TArray<uint64> SyncedDependencies = ViewModel->GetItemDependencies(ItemId);
+
+				if (bAdd)
+					SyncedDependencies.AddUnique(Dependency);
+				else
+					SyncedDependencies.Remove(Dependency);
+
+				ViewModel->SetItemDependencies(ItemId, SyncedDependencies);
+			}
+			else
+			{
+				UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't %s dependency %llu on item %llu: %s"), bAdd ? TEXT("add") : TEXT("remove"), Dependency, ItemId, *Result.Message);
+			}
+
+			if (--(*NumPending) == 0)
+				OnComplete();
+		};
+
+		if (bAdd)
+			Backend->AddDependency(ItemId, Dependency, OnChanged);
+		else
+			Backend->RemoveDependency(ItemId, Dependency, OnChanged);
+	}
+}
+
+void FWorkshopUploaderImpl::CheckUploadSizes(const TArray<FSizedUpload>& Uploads, TFunction<void(const FString& Error)> OnChecked)
+{
+	TSharedRef<TArray<FWorkshopSizeReport>> Reports = MakeShared<TArray<FWorkshopSizeReport>>();
+	Reports->SetNum(Uploads.Num());
+
+	BackgroundTasks->Run([Uploads, Reports]()
+	{
+		// App copies share their folder with the build they copy, which is only hashed once. The hashes are cached for when it's submitted
+		TMap<FString, int64> FolderSizes;
+
+		for (int32 Index = 0; Index < Uploads.Num(); ++Index)
+		{
+			const FSizedUpload& Upload = Uploads[Index];
+
+			if (!FolderSizes.Contains(Upload.ContentFolder))
+				FolderSizes.Add(Upload.ContentFolder, FWorkshopContentManifest::BuildCached(Upload.ContentFolder, FWorkshopContentManifest::GetCachedManifestPath(Upload.ContentFolder)).GetTotalSize());
+
+			FWorkshopSizeReport& Report = (*Reports)[Index];
+			Report.Package = Upload.Name.IsEmpty() ? FString::Printf(TEXT("Item %llu"), Upload.PublishedFileId) : Upload.Name;
+			Report.TotalSize = FolderSizes[Upload.ContentFolder];
+			Report.bQuotaOnly = Upload.bAppCopy;
+
+			FWorkshopContentManifest Published;
+			if (Upload.PublishedFileId != 0 && FWorkshopContentManifest::Load(FWorkshopContentManifest::GetManifestPath(Upload.PublishedFileId), Published))
+				Report.PublishedSize = Published.GetTotalSize();
+		}
+	},
+	[this, Reports, OnChecked]()
+	{
+		uint64 TotalQuota = 0, AvailableQuota = 0;
+		const bool bHasQuota = Backend->GetStorageQuota(TotalQuota, AvailableQuota);
+
+		const FWorkshopSizeCheck SizeCheck = FWorkshopSizeCheck::Check(*Reports, ViewModel->GetSizeBudgets(), bHasQuota ? (int64)AvailableQuota : -1);
+
+		for (const FString& Warning : SizeCheck.Warnings)
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("%s"), *Warning);
+
+		OnChecked(SizeCheck.Error);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitStagedContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, const FString& AppCopiesBuildsDir, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	const TArray<FString> Platforms = FWorkshopStagedContent::FindStagedPlatforms(StagedBuildsDir);
+
+	// Budgets and quota are checked before anything is sent, an upload Steam would reject for its size can take a long time to fail
+	TArray<FSizedUpload> Uploads;
+
+	if (Platforms.Num() > 1)
+	{
+		for (int32 PlatformIndex = 0; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+		{
+			const uint64 ItemId = (PlatformIndex == 0 || Update.PublishedFileId == 0) ? Update.PublishedFileId : ViewModel->FindPlatformItem(Update.PublishedFileId, Platforms[PlatformIndex]);
+			Uploads.Add({ Package, StagedBuildsDir / Platforms[PlatformIndex], ItemId, false });
+		}
+	}
+	else
+	{
+		Uploads.Add({ Package, StagedBuildsDir, Update.PublishedFileId, false });
+	}
+
+	// Every app's copy is a whole upload of its own as far as the quota goes
+	const int32 NumBuilds = Uploads.Num();
+	for (int32 BuildIndex = 0; BuildIndex < NumBuilds; ++BuildIndex)
+	{
+		const FSizedUpload Build = Uploads[BuildIndex];
+		const FString AppCopyFolder = Platforms.Num() > 1 ? AppCopiesBuildsDir / Platforms[BuildIndex] : AppCopiesBuildsDir;
+
+		for (uint32 AppId : Update.AdditionalAppIds)
+			Uploads.Add({ Build.Name, AppCopyFolder, Build.PublishedFileId != 0 ? ViewModel->FindAppItem(Build.PublishedFileId, AppId) : 0, true });
+	}
+
+	CheckUploadSizes(Uploads, [this, Update, Package, StagedBuildsDir, AppCopiesBuildsDir, Platforms, OnSubmitted](const FString& Error)
+	{
+		if (!Error.IsEmpty())
+		{
+			FWorkshopResult SizeResult;
+			SizeResult.bSuccess = false;
+			SizeResult.Message = Error;
+
+			OnSubmitted(SizeResult, false);
+			return;
+		}
+
+		if (Platforms.Num() > 1)
+		{
+			SubmitPlatformItems(Update, Package, StagedBuildsDir, AppCopiesBuildsDir, Platforms, OnSubmitted);
+			return;
+		}
+
+		FWorkshopItemUpdate SingleUpdate = Update;
+		SingleUpdate.ContentFolder = StagedBuildsDir;
+		SubmitItemContent(SingleUpdate, Package, AppCopiesBuildsDir, OnSubmitted);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitPlatformItems(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, const FString& AppCopiesBuildsDir, const TArray<FString>& Platforms, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// Every platform gets its own item so subscribers only download their own build, the draft's item carries the first platform
+	struct FPlatformSubmission
+	{
+		FWorkshopItemUpdate Update;
+		FString Package;
+		FString StagedBuildsDir;
+		FString AppCopiesBuildsDir;
+		TArray<FString> Platforms;
+		TArray<uint64> ItemIds;
+		TArray<bool> bCreatedItems;
+
+		int32 NumPending = 0;
+		FWorkshopResult Result;
+		bool bNeedsLegalAgreement = false;
+		FOnWorkshopItemSubmitted OnSubmitted;
+	};
+
+	TSharedRef<FPlatformSubmission> Submission = MakeShared<FPlatformSubmission>();
+	Submission->Update = Update;
+	Submission->Package = Package;
+	Submission->StagedBuildsDir = StagedBuildsDir;
+	Submission->AppCopiesBuildsDir = AppCopiesBuildsDir;
+	Submission->Platforms = Platforms;
+	Submission->Result.bSuccess = true;
+	Submission->OnSubmitted = MoveTemp(OnSubmitted);
+
+	Submission->ItemIds.Add(Update.PublishedFileId);
+	for (int32 PlatformIndex = 1; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+		Submission->ItemIds.Add(ViewModel->FindPlatformItem(Update.PublishedFileId, Platforms[PlatformIndex]));
+
+	Submission->bCreatedItems.SetNumZeroed(Platforms.Num());
+
+	// Each platform's content is hashed and uploaded alongside the others
+	auto SubmitAll = [this, Submission]()
+	{
+		const int32 NumPlatforms = Submission->Platforms.Num();
+		Submission->NumPending = NumPlatforms;
+
+		for (int32 PlatformIndex = 0; PlatformIndex < NumPlatforms; ++PlatformIndex)
+		{
+			const FString& Platform = Submission->Platforms[PlatformIndex];
+
+			FWorkshopItemUpdate PlatformUpdate = Submission->Update;
+			PlatformUpdate.PublishedFileId = Submission->ItemIds[PlatformIndex];
+			PlatformUpdate.ContentFolder = Submission->StagedBuildsDir / Platform;
+
+			if (PlatformIndex == 0)
+			{
+				for (int32 OtherIndex = 1; OtherIndex < NumPlatforms; ++OtherIndex)
+					PlatformUpdate.KeyValueTags.Emplace(TEXT("platform_item"), FString::Printf(TEXT("%s:%llu"), *Submission->Platforms[OtherIndex], Submission->ItemIds[OtherIndex]));
+			}
+			else
+			{
+				PlatformUpdate.KeyValueTags.Emplace(TEXT("primary_item"), LexToString(Submission->ItemIds[0]));
+
+				// Items created during an update still need a title even if the draft left it blank
+				if (PlatformUpdate.Title.IsSet())
+					PlatformUpdate.Title = FString::Printf(TEXT("%s (%s)"), *PlatformUpdate.Title.GetValue(), *Platform);
+				else if (Submission->bCreatedItems[PlatformIndex])
+					PlatformUpdate.Title = FString::Printf(TEXT("%s (%s)"), *Submission->Package, *Platform);
+
+				for (TPair<FString, FWorkshopLocalizedText>& Localization : PlatformUpdate.Localizations)
+				{
+					if (Localization.Value.Title.IsSet())
+						Localization.Value.Title = FString::Printf(TEXT("%s (%s)"), *Localization.Value.Title.GetValue(), *Platform);
+				}
+			}
+
+			SubmitItemContent(PlatformUpdate, Submission->Package, Submission->AppCopiesBuildsDir / Platform, [Submission, Platform](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+			{
+				if (!Result.bSuccess && Submission->Result.bSuccess)
+				{
+					Submission->Result = Result;
+					Submission->Result.Message = FString::Printf(TEXT("%s: %s"), *Platform, *Result.Message);
+				}
+				else if (Result.bSuccess)
+				{
+					for (const FString& Warning : Result.Warnings)
+						Submission->Result.Warnings.Add(FString::Printf(TEXT("%s: %s"), *Platform, *Warning));
+				}
+
+				Submission->bNeedsLegalAgreement |= bNeedsLegalAgreement;
+
+				if (--Submission->NumPending == 0)
+					Submission->OnSubmitted(Submission->Result, Submission->bNeedsLegalAgreement);
+			});
+		}
+	};
+
+	int32 NumMissingItems = 0;
+	for (uint64 ItemId : Submission->ItemIds)
+	{
+		if (ItemId == 0)
+			++NumMissingItems;
+	}
+
+	if (NumMissingItems == 0)
+	{
+		SubmitAll();
+		return;
+	}
+
+	// Platforms published for the first time need their items before anything is submitted, so the primary item can list them
+	Submission->NumPending = NumMissingItems;
+
+	for (int32 PlatformIndex = 1; PlatformIndex < Platforms.Num(); ++PlatformIndex)
+	{
+		if (Submission->ItemIds[PlatformIndex] != 0)
+			continue;
+
+		Backend->CreateItem(Update.ConsumerAppId, [this, Submission, PlatformIndex, SubmitAll](const FWorkshopResult& Result, uint64 NewPublishedFileId, bool bNeedsLegalAgreement)
+		{
+			if (Result.bSuccess)
+			{
+				if (bNeedsLegalAgreement)
+					Backend->ShowLegalAgreement(NewPublishedFileId);
+
+				Submission->ItemIds[PlatformIndex] = NewPublishedFileId;
+				Submission->bCreatedItems[PlatformIndex] = true;
+				ViewModel->SetPlatformItem(Submission->ItemIds[0], Submission->Platforms[PlatformIndex], NewPublishedFileId);
+			}
+			else if (Submission->Result.bSuccess)
+			{
+				Submission->Result = Result;
+				Submission->Result.Message = FString::Printf(TEXT("Couldn't create the %s item: %s"), *Submission->Platforms[PlatformIndex], *Result.Message);
+			}
+
+			if (--Submission->NumPending > 0)
+				return;
+
+			if (Submission->Result.bSuccess)
+			{
+				SubmitAll();
+			}
+			else
+			{
+				Submission->OnSubmitted(Submission->Result, false);
+			}
+		});
+	}
+}
+
+void FWorkshopUploaderImpl::SubmitItemContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& AppCopiesFolder, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// The metadata needs the content hash, so the content is hashed before uploading. Cached hashes keep that quick for files that haven't changed
+	TSharedRef<FWorkshopContentManifest> Manifest = MakeShared<FWorkshopContentManifest>();
+	const FString ContentFolder = Update.ContentFolder;
+
+	// Other apps' copies are uploaded from their own folder when they can't share the first app's stripped build
+	const bool bSeparateAppCopies = Update.AdditionalAppIds.Num() > 0 && !AppCopiesFolder.IsEmpty() && AppCopiesFolder != ContentFolder;
+	TSharedRef<FWorkshopContentManifest> AppCopiesManifest = bSeparateAppCopies ? MakeShared<FWorkshopContentManifest>() : Manifest;
+
+	BackgroundTasks->Run([Manifest, ContentFolder, AppCopiesManifest, AppCopiesFolder, bSeparateAppCopies]()
+	{
+		*Manifest = FWorkshopContentManifest::BuildCached(ContentFolder, FWorkshopContentManifest::GetCachedManifestPath(ContentFolder));
+
+		if (bSeparateAppCopies)
+			*AppCopiesManifest = FWorkshopContentManifest::BuildCached(AppCopiesFolder, FWorkshopContentManifest::GetCachedManifestPath(AppCopiesFolder));
+	},
+	[this, Update, Package, Manifest, AppCopiesManifest, AppCopiesFolder, bSeparateAppCopies, OnSubmitted]()
+	{
+		const TArray<uint64> Dependencies = ResolveModDependencies(Package);
+
+		auto WithMetadata = [&Package, &Dependencies](const FWorkshopItemUpdate& ContentUpdate, const FWorkshopContentManifest& ContentManifest)
+		{
+			const FWorkshopItemMetadata Metadata = FWorkshopItemMetadata::Generate(Package, ContentManifest, FWorkshopStagedContent::GetContentPlatforms(ContentUpdate.ContentFolder), Dependencies);
+
+			FWorkshopItemUpdate MetadataUpdate = ContentUpdate;
+			MetadataUpdate.Metadata = Metadata.ToJson();
+			Metadata.GetKeyValueTags(MetadataUpdate.KeyValueTags);
+
+			return MetadataUpdate;
+		};
+
+		const FWorkshopItemUpdate MetadataUpdate = WithMetadata(Update, *Manifest);
+
+		if (MetadataUpdate.AdditionalAppIds.Num() > 0)
+		{
+			FWorkshopItemUpdate AppCopiesUpdate = Update;
+			if (bSeparateAppCopies)
+				AppCopiesUpdate.ContentFolder = AppCopiesFolder;
+
+			SubmitAppItems(MetadataUpdate, Manifest, WithMetadata(AppCopiesUpdate, *AppCopiesManifest), AppCopiesManifest, Package, OnSubmitted);
+			return;
+		}
+
+		SubmitHashedItem(MetadataUpdate, Manifest, true, OnSubmitted);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitAppItems(const FWorkshopItemUpdate& Update, TSharedRef<FWorkshopContentManifest> Manifest, const FWorkshopItemUpdate& AppCopiesUpdate, TSharedRef<FWorkshopContentManifest> AppCopiesManifest, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	// The content was hashed and checked once, every app then gets the same update on its own copy of the item, all at once
+	struct FAppSubmission
+	{
+		TArray<uint32> AppIds;
+		TArray<uint64> ItemIds;
+		TArray<FString> AppResults;
+
+		int32 NumPending = 0;
+		FWorkshopResult Result;
+		bool bNeedsLegalAgreement = false;
+		FOnWorkshopItemSubmitted OnSubmitted;
+	};
+
+	TSharedRef<FAppSubmission> Submission = MakeShared<FAppSubmission>();
+	Submission->AppIds.Add(Update.ConsumerAppId);
+	Submission->ItemIds.Add(Update.PublishedFileId);
+
+	for (uint32 AppId : Update.AdditionalAppIds)
+	{
+		Submission->AppIds.Add(AppId);
+		Submission->ItemIds.Add(ViewModel->FindAppItem(Update.PublishedFileId, AppId));
+	}
+
+	Submission->AppResults.SetNum(Submission->AppIds.Num());
+	Submission->NumPending = Submission->AppIds.Num();
+	Submission->Result.bSuccess = true;
+	Submission->OnSubmitted = MoveTemp(OnSubmitted);
+
+	auto OnAppSubmitted = [Submission](int32 AppIndex, const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		const FString Published = Result.Warnings.Num() > 0 ? TEXT("published, but ") + FString::Join(Result.Warnings, TEXT(" ")) : TEXT("published");
+		Submission->AppResults[AppIndex] = FString::Printf(TEXT("App %u, item %llu: %s"), Submission->AppIds[AppIndex], Submission->ItemIds[AppIndex], Result.bSuccess ? *Published : *Result.Message);
+
+		if (!Result.bSuccess && Submission->Result.bSuccess)
+			Submission->Result = Result;
+		else if (Result.bSuccess)
+			Submission->Result.Warnings.Append(Result.Warnings);
+
+		Submission->bNeedsLegalAgreement |= bNeedsLegalAgreement;
+
+		if (--Submission->NumPending > 0)
+			return;
+
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Published to %d apps:\n%s"), Submission->AppIds.Num(), *FString::Join(Submission->AppResults, TEXT("\n")));
+
+		FWorkshopResult AppsResult = Submission->Result;
+		AppsResult.Message = FString::Join(Submission->AppResults, TEXT("\n"));
+
+		Submission->OnSubmitted(AppsResult, Submission->bNeedsLegalAgreement);
+	};
+
+	for (int32 AppIndex = 0; AppIndex < Submission->AppIds.Num(); ++AppIndex)
+	{
+		const uint32 AppId = Submission->AppIds[AppIndex];
+
+		// The first app's update may be the build without shared files, the copies always get one that's whole
+		FWorkshopItemUpdate AppUpdate = AppIndex == 0 ? Update : AppCopiesUpdate;
+		AppUpdate.ConsumerAppId = AppId;
+		AppUpdate.AdditionalAppIds.Empty();
+
+		TSharedRef<FWorkshopContentManifest> AppManifest = AppIndex == 0 ? Manifest : AppCopiesManifest;
+
+		// Only the editor's own app is verified, downloading another app's items needs a session running as that app
+		auto SubmitToItem = [this, AppUpdate, Package, AppManifest, AppIndex, OnAppSubmitted](uint64 ItemId, bool bCreated) mutable
+		{
+			AppUpdate.PublishedFileId = ItemId;
+
+			// Items created during an update still need a title even if the draft left it blank
+			if (bCreated && !AppUpdate.Title.IsSet())
+				AppUpdate.Title = Package;
+
+			SubmitHashedItem(AppUpdate, AppManifest, AppIndex == 0, [AppIndex, OnAppSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+			{
+				OnAppSubmitted(AppIndex, Result, bNeedsLegalAgreement);
+			});
+		};
+
+		if (Submission->ItemIds[AppIndex] != 0)
+		{
+			SubmitToItem(Submission->ItemIds[AppIndex], false);
+			continue;
+		}
+
+		Backend->CreateItem(AppId, [this, Submission, AppIndex, AppId, SubmitToItem, OnAppSubmitted](const FWorkshopResult& Result, uint64 NewPublishedFileId, bool bNeedsLegalAgreement) mutable
+		{
+			if (!Result.bSuccess)
+			{
+				FWorkshopResult CreateResult = Result;
+				CreateResult.Message = FString::Printf(TEXT("Couldn't create the item: %s"), *Result.Message);
+
+				OnAppSubmitted(AppIndex, CreateResult, false);
+				return;
+			}
+
+			if (bNeedsLegalAgreement)
+				Backend->ShowLegalAgreement(NewPublishedFileId);
+
+			Submission->ItemIds[AppIndex] = NewPublishedFileId;
+			ViewModel->SetAppItem(Submission->ItemIds[0], AppId, NewPublishedFileId);
+
+			SubmitToItem(NewPublishedFileId, true);
+		});
+	}
+}
+
+void FWorkshopUploaderImpl::SubmitHashedItem(const FWorkshopItemUpdate& Update, TSharedRef<FWorkshopContentManifest> Manifest, bool bVerify, FOnWorkshopItemSubmitted OnSubmitted)
+{
+	const uint64 PublishedFileID = Update.PublishedFileId;
+
+	// Only previews that moved or changed since the last publish are uploaded
+	FWorkshopItemUpdate GalleryUpdate = Update;
+	if (Update.Gallery.IsSet())
+		GalleryUpdate.PreviewChanges = FWorkshopPreviewImages::DiffGallery(ViewModel->GetPublishedGallery(PublishedFileID), Update.Gallery.GetValue());
+
+	Backend->SubmitItemUpdate(GalleryUpdate, [this, Update, PublishedFileID, Manifest, bVerify, OnSubmitted](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		if (!Result.bSuccess)
+		{
+			OnSubmitted(Result, bNeedsLegalAgreement);
+			return;
+		}
+
+		if (Update.Gallery.IsSet())
+			ViewModel->SetPublishedGallery(PublishedFileID, Update.Gallery.GetValue());
+
+		// Kept as what the next update's patch size gets estimated against. Tracked like any other task, so nothing reads it half written
+		BackgroundTasks->Run([Manifest, PublishedFileID]()
+		{
+			FWorkshopContentManifest PublishedManifest = *Manifest;
+			PublishedManifest.PublishedFileId = PublishedFileID;
+
+			if (!PublishedManifest.Save(FWorkshopContentManifest::GetManifestPath(PublishedFileID)))
+				UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't save the content manifest for item %llu"), PublishedFileID);
+		},
+		[]() {});
+
+		SubmitLocalizedText(Update, [this, Result, bNeedsLegalAgreement, PublishedFileID, Manifest, bVerify, OnSubmitted](const TArray<FString>& FailedLanguages)
+		{
+			// The content is up either way, missing translations are reported without failing the submission
+			FWorkshopResult LocalizedResult = Result;
+			if (FailedLanguages.Num() > 0)
+				LocalizedResult.Message += FString::Printf(TEXT(" Couldn't update the text for: %s, see the output log."), *FString::Join(FailedLanguages, TEXT(", ")));
+
+			if (!bVerify || !ViewModel->bVerifyAfterPublish)
+			{
+				OnSubmitted(LocalizedResult, bNeedsLegalAgreement);
+				return;
+			}
+
+			VerifyPublishedItem(PublishedFileID, Manifest, [LocalizedResult, bNeedsLegalAgreement, OnSubmitted](bool bVerified, const FString& Report)
+			{
+				// The item is live whatever the download shows, so a failed check is a warning rather than a failed submission
+				FWorkshopResult VerifiedResult = LocalizedResult;
+
+				if (bVerified)
+				{
+					VerifiedResult.Message += TEXT(" The published content was verified.");
+				}
+				else
+				{
+					VerifiedResult.Warnings.Add(Report);
+					VerifiedResult.Message += TEXT(" ") + Report;
+				}
+
+				OnSubmitted(VerifiedResult, bNeedsLegalAgreement);
+			});
+		});
+	});
+}
+
+void FWorkshopUploaderImpl::VerifyPublishedItem(uint64 PublishedFileId, TSharedRef<FWorkshopContentManifest> Expected, TFunction<void(bool bVerified, const FString& Report)> OnComplete)
+{
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Downloading item %llu to verify its content"), PublishedFileId);
+
+	Backend->DownloadItem(PublishedFileId, [this, PublishedFileId, Expected, OnComplete](const FWorkshopResult& Result, const FString& InstallFolder)
+	{
+		if (!Result.bSuccess)
+		{
+			OnComplete(false, FString::Printf(TEXT("The item was published but couldn't be downloaded to verify it! %s"), *Result.Message));
+			return;
+		}
+
+		// Hashing the download is the slow part, files are hashed in parallel
+		TSharedRef<FWorkshopManifestDiff> Diff = MakeShared<FWorkshopManifestDiff>();
+
+		BackgroundTasks->Run([Diff, Expected, InstallFolder]()
+		{
+			*Diff = FWorkshopManifestDiff::Compare(*Expected, FWorkshopContentManifest::Build(InstallFolder));
+		},
+		[PublishedFileId, Diff, InstallFolder, OnComplete]()
+		{
+			if (Diff->IsEmpty())
+			{
+				UE_LOG(LogWorkshopUploader, Log, TEXT("Item %llu matches what was uploaded"), PublishedFileId);
+				OnComplete(true, FString());
+				return;
+			}
+
+			const FString Report = Diff->Describe();
+			UE_LOG(LogWorkshopUploader, Error, TEXT("Item %llu as downloaded to %s doesn't match what was uploaded:\n%s"), PublishedFileId, *InstallFolder, *Report);
+
+			OnComplete(false, FString::Printf(TEXT("The item was published but its content doesn't match what was uploaded (%d missing, %d unexpected, %d different)!\n%s"),
+				Diff->Missing.Num(), Diff->Unexpected.Num(), Diff->Changed.Num(), *Report));
+		});
+	});
+}
+
+void FWorkshopUploaderImpl::PublishWatchedMod(const FString& Package, uint64 PublishedFileId, TFunction<void(bool bSuccess, const FString& Message)> OnComplete)
+{
+	// Uses the same hash cache as the upload itself, so only files that were written since the last publish are read, and only once.
+	// Every platform comes out of the same UAT run, so the primary one stands in for the rest
+	const FString ContentFolder = FWorkshopStagedContent::GetPrimaryContentFolder(Package);
+	TSharedRef<FWorkshopManifestDiff> Diff = MakeShared<FWorkshopManifestDiff>();
+
+	BackgroundTasks->Run([ContentFolder, PublishedFileId, Diff]()
+	{
+		const FWorkshopContentManifest Staged = FWorkshopContentManifest::BuildCached(ContentFolder, FWorkshopContentManifest::GetCachedManifestPath(ContentFolder));
+
+		// Compared with the staged build the item was last published from, not what was uploaded, which repacking or the shared item split changes
+		FWorkshopContentManifest Published;
+		FWorkshopContentManifest::LoadSource(PublishedFileId, Published);
+
+		*Diff = FWorkshopManifestDiff::Compare(Published, Staged);
+	},
+	[this, Package, PublishedFileId, Diff, OnComplete]()
+	{
+		if (Diff->IsEmpty())
+		{
+			OnComplete(true, TEXT("Nothing changed since the last publish, skipped"));
+			return;
+		}
+
+		FWorkshopItemUpdate Update;
+		Update.ConsumerAppId = Backend->GetAppId();
+		Update.PublishedFileId = PublishedFileId;
+
+		// Copies in other apps are kept in step with the item they were made from
+		Update.AdditionalAppIds = ViewModel->GetAppsWithItem(PublishedFileId);
+
+		// Compared to what was published, Unexpected is what was added
+		Update.ChangeNote = FString::Printf(TEXT("Automatic update: %d files changed, %d added, %d removed."), Diff->Changed.Num(), Diff->Unexpected.Num(), Diff->Missing.Num());
+
+		const FString ChangeNote = Update.ChangeNote;
+
+		SubmitDraftContent(Update, Package, [OnComplete, ChangeNote](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			OnComplete(Result.bSuccess, Result.bSuccess ? ChangeNote : FString::Printf(TEXT("Failed! %s"), *Result.Message));
+		});
+	});
+}
+
+/* Text only updates for one item, sent one after another */
+struct FLocalizedTextBatch
+{
+	TArray<FWorkshopItemUpdate> Updates;
+	int32 NextIndex = 0;
+	TArray<FString> FailedLanguages;
+	TFunction<void(const TArray<FString>&)> OnComplete;
+};
+
+static void SubmitNextLocalizedText(const TSharedRef<IWorkshopBackend>& Backend, const TSharedRef<FLocalizedTextBatch>& Batch)
+{
+	if (!Batch->Updates.IsValidIndex(Batch->NextIndex))
+	{
+		Batch->OnComplete(Batch->FailedLanguages);
+		return;
+	}
+
+	const FWorkshopItemUpdate& Update = Batch->Updates[Batch->NextIndex++];
+	const FString Language = Update.Language;
+	const uint64 PublishedFileId = Update.PublishedFileId;
+
+	Backend->SubmitItemUpdate(Update, [Backend, Batch, Language, PublishedFileId](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+	{
+		if (!Result.bSuccess)
+		{
+			UE_LOG(LogWorkshopUploader, Warning, TEXT("Couldn't update the %s text of item %llu: %s"), *Language, PublishedFileId, *Result.Message);
+			Batch->FailedLanguages.Add(Language);
+		}
+
+		SubmitNextLocalizedText(Backend, Batch);
+	});
+}
+
+void FWorkshopUploaderImpl::SubmitLocalizedText(const FWorkshopItemUpdate& Update, TFunction<void(const TArray<FString>& FailedLanguages)> OnComplete)
+{
+	// Content, tags and metadata already went up with the main update, so each language is a quick text only round trip.
+	// Steam locks an item while it's being updated, the next language is started as soon as the previous one finishes
+	TSharedRef<FLocalizedTextBatch> Batch = MakeShared<FLocalizedTextBatch>();
+	Batch->OnComplete = MoveTemp(OnComplete);
+
+	for (const TPair<FString, FWorkshopLocalizedText>& Localization : Update.Localizations)
+	{
+		if (Localization.Key == Update.Language)
+			continue;
+
+		FWorkshopItemUpdate& TextUpdate = Batch->Updates.AddDefaulted_GetRef();
+		TextUpdate.ConsumerAppId = Update.ConsumerAppId;
+		TextUpdate.PublishedFileId = Update.PublishedFileId;
+		TextUpdate.Language = Localization.Key;
+		TextUpdate.Title = Localization.Value.Title;
+		TextUpdate.Description = Localization.Value.Description;
+	}
+
+	SubmitNextLocalizedText(Backend, Batch);
+}
+
+void FWorkshopUploaderImpl::PublishPackagedMod(const FString& Package, const FText& ChangeNote, TFunction<void(bool bSuccess, const FString& Message)> OnComplete)
+{
+	FWorkshopItemDraft& Draft = ViewModel->GetPackageDraft(Package);
+	const uint64 PublishedFileId = Draft.GetWorkshopId();
+
+	if (PublishedFileId != 0)
+	{
+		Draft.ChangeNote = ChangeNote;
+
+		SubmitDraft(Draft, Backend->GetAppId(), PublishedFileId, true, [OnComplete](const FWorkshopResult& Result, bool bNeedsLegalAgreement)
+		{
+			OnComplete(Result.bSuccess, Result.Message);
+		});
+
+		return;
+	}
+
+	// A mod published for the first time without tags gets the ones its content suggests, the pipeline would otherwise publish it untagged
+	if (Draft.Tags.Num() == 0)
+	{
+		SuggestTags(Package, [this, Package, OnComplete](const TArray<FString>& Tags)
+		{
+			ViewModel->GetPackageDraft(Package).Tags = Tags;
+			ViewModel->MarkDraftsDirty();
+
+			CreatePackagedModItem(Package, OnComplete);
+		});
+
+		return;
+	}
+
+	CreatePackagedModItem(Package, MoveTemp(OnComplete));
+}
+
+void FWorkshopUploaderImpl::CreatePackagedModItem(const FString& Package, TFunction<void(bool bSuccess, const FString& Message)> OnComplete)
+{
+	// First publish of this mod, remember the new item so later runs update it
+	Backend->CreateItem(Backend->GetAppId(), [this, Package, OnComplete](const FWorkshopResult& Result, uint64 NewPublishedFileId, bool bNeedsLegalAgreement)
+	{
+		if (!Result.bSuccess)
+		{
+			OnComplete(false, Result.Message);
+			return;
+		}
+
+		if (bNeedsLegalAgreement)
+			Backend->ShowLegalAgreement(NewPublishedFileId);
+
+		FWorkshopItemDraft& NewDraft = ViewModel->GetPackageDraft(Package);
+		NewDraft.WorkshopId = FText::FromString(LexToString(NewPublishedFileId));
+		ViewModel->MarkDraftsDirty();
+
+		SubmitDraft(NewDraft, Backend->GetAppId(), NewPublishedFileId, false, [OnComplete](const FWorkshopResult& SubmitResult, bool bSubmitNeedsLegalAgreement)
+		{
+			OnComplete(SubmitResult.bSuccess, SubmitResult.Message);
+		});
+	});
+}
+
+/* Scripting */
+
+TArray<TSharedPtr<FWorkshopModEntry>> FWorkshopUploaderImpl::GetPackagedMods()
+{
+	ViewModel->RefreshPackagedModsNow();
+
+	return ViewModel->GetModIndex().GetEntries();
+}
+
+uint64 FWorkshopUploaderImpl::FindWorkshopIdForPackage(const FString& Package) const
+{
+	return ViewModel->FindWorkshopIdForPackage(Package);
+}
+
+void FWorkshopUploaderImpl::ValidatePackagedMod(const FString& Package, TFunction<void(const TArray<FString>& Errors, const TArray<FString>& Warnings)> OnComplete)
+{
+	FWorkshopDiscoveredMod DiscoveredMod;
+	if (!FWorkshopModDiscovery::Get().FindMod(Package, DiscoveredMod))
+	{
+		OnComplete({ FString::Printf(TEXT("%s isn't in any of the mod folders"), *Package) }, {});
+		return;
+	}
+
+	if (FWorkshopStagedContent::FindStagedPlatforms(FWorkshopStagedContent::GetStagedBuildsDir(Package)).Num() == 0)
+	{
+		OnComplete({ FString::Printf(TEXT("%s hasn't been packaged, there's nothing staged to publish"), *Package) }, {});
+		return;
+	}
+
+	// The same budget and quota check publishing makes, without waiting for the content to be hashed
+	MeasureStagedSizes({ Package }, [this, Package, OnComplete](const TArray<FWorkshopSizeReport>& Reports, const TArray<FString>& Platforms)
+	{
+		uint64 TotalQuota = 0, AvailableQuota = 0;
+		const bool bHasQuota = Backend->GetStorageQuota(TotalQuota, AvailableQuota);
+
+		const FWorkshopSizeCheck SizeCheck = FWorkshopSizeCheck::Check(Reports, ViewModel->GetSizeBudgets(), bHasQuota ? (int64)AvailableQuota : -1);
+
+		TArray<FString> Errors;
+		if (!SizeCheck.Error.IsEmpty())
+			Errors.Add(SizeCheck.Error);
+
+		TArray<FString> Warnings = SizeCheck.Warnings;
+
+		const FWorkshopItemDraft& Draft = ViewModel->GetPackageDraft(Package);
+		if (Draft.GetWorkshopId() == 0 && Draft.Tags.Num() == 0)
+			Warnings.Add(FString::Printf(TEXT("%s has no tags yet, it will be given the ones its content suggests"), *Package));
+
+		if (!SmokeTester->Settings.IsEnabled())
+		{
+			OnComplete(Errors, Warnings);
+			return;
+		}
+
+		SmokeTestStagedContent(FWorkshopStagedContent::GetStagedBuildsDir(Package), [this, Package, Errors, Warnings, OnComplete](const FWorkshopSmokeTestReport& Report) mutable
+		{
+			if (Report.HasFailed())
+				Errors.Add(FString::Printf(TEXT("%s failed its smoke test:\n%s"), *Package, *Report.ToString()));
+
+			Warnings.Append(Report.GetSlowLoads(SmokeTester->Settings.SlowLoadSeconds));
+
+			OnComplete(Errors, Warnings);
+		});
+	});
+}
+
+void FWorkshopUploaderImpl::SmokeTestStagedContent(const FString& StagedBuildsDir, TFunction<void(const FWorkshopSmokeTestReport& Report)> OnComplete)
+{
+	const FString ContentFolder = FWorkshopSmokeTester::FindTestableContent(StagedBuildsDir);
+	TSharedRef<TArray<FString>> Maps = MakeShared<TArray<FString>>();
+
+	BackgroundTasks->Run([ContentFolder, Maps]()
+	{
+		if (!ContentFolder.IsEmpty())
+			*Maps = FWorkshopSmokeTester::FindMaps(ContentFolder);
+	},
+	[this, ContentFolder, Maps, OnComplete]()
+	{
+		SmokeTester->Test(ContentFolder, *Maps, OnComplete);
+	});
+}
+
+void FWorkshopUploaderImpl::SetPackageTargetApps(const FString& Package, const TArray<uint32>& AppIds)
+{
+	ViewModel->GetPackageDraft(Package).TargetAppIds = AppIds;
+	ViewModel->MarkDraftsDirty();
+}
+
+void FWorkshopUploaderImpl::QueryItems(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete)
+{
+	Backend->QueryItemDetails(PublishedFileIds, MoveTemp(OnComplete));
+}
+
+void FWorkshopUploaderImpl::QueryPublishedItems(FOnWorkshopItemsQueried OnComplete)
+{
+	Backend->QueryPublishedItems(Backend->GetAppId(), MoveTemp(OnComplete));
+}
+
+void FWorkshopUploaderImpl::onItemCreated(const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement)
+{
+	if (Result.bSuccess)
+	{
+		if (bNeedsLegalAgreement)
+			Backend->ShowLegalAgreement(PublishedFileId);
+
+		UE_LOG(LogWorkshopUploader, Log, TEXT("Created Workshop item %llu"), PublishedFileId);
+
+		// The New Mod form is reused for the next mod, so the item is remembered on the mod's own draft, where mods that depend on it look it up
+		const FString Package = ViewModel->GetDraft(false).Package;
+		if (!Package.IsEmpty())
+		{
+			ViewModel->GetPackageDraft(Package).WorkshopId = FText::FromString(LexToString(PublishedFileId));
+			ViewModel->MarkDraftsDirty();
+		}
+
+		UpdateWorkshopItem(Backend->GetAppId(), PublishedFileId);
+	}
+	else
+	{
+		// Backend callbacks are already dispatched on the game thread
+		ViewModel->SetStatus(false, EWorkshopUploadState::Failed, FText::FromString(FString::Printf(TEXT("Workshop creation failed! %s"), *Result.Message)));
+
+		UE_LOG(LogWorkshopUploader, Warning, TEXT("Failed to create Workshop item: %s"), *Result.Message);
+	}
+}
+
+void FWorkshopUploaderImpl::onItemSubmitted(const FWorkshopResult& Result, bool bNeedsLegalAgreement, bool IsUpdateMod)
+{
+	if (Result.bSuccess && Result.Warnings.Num() > 0)
+		ViewModel->SetStatus(IsUpdateMod, EWorkshopUploadState::Succeeded, FText::FromString(FString::Printf(TEXT("Workshop submission successful, but: %s"), *FString::Join(Result.Warnings, TEXT("\n")))));
+	else if (Result.bSuccess)
+		ViewModel->SetStatus(IsUpdateMod, EWorkshopUploadState::Succeeded, FText::FromString("Workshop submission successful!"));
+	else
+		ViewModel->SetStatus(IsUpdateMod, EWorkshopUploadState::Failed, FText::FromString(FString::Printf(TEXT("Workshop submission failed! %s"), *Result.Message)));
+}
+
+#undef LOCTEXT_NAMESPACE
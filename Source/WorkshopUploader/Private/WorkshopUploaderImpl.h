@@ -0,0 +1,198 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Input/Reply.h"
+#include "WorkshopBackend.h"
+#include "WorkshopContentManifest.h"
+
+class SDockTab;
+class SWorkshopUploaderPanel;
+class FWorkshopUploaderViewModel;
+class FWorkshopPackagePipeline;
+class FWorkshopBulkEditor;
+class FWorkshopCallScheduler;
+class FWorkshopWatchMode;
+class FWorkshopSmokeTester;
+class FWorkshopRepacker;
+class FWorkshopBackgroundTasks;
+struct FWorkshopItemDraft;
+struct FWorkshopDedupReport;
+struct FWorkshopSharedContentPlan;
+struct FWorkshopSizeReport;
+struct FWorkshopModEntry;
+struct FWorkshopSmokeTestReport;
+struct FWorkshopRepackReport;
+
+/* Uploader tab and publishing logic, owned by FWorkshopUploaderModule and created the first time it's used */
+class FWorkshopUploaderImpl
+{
+public:
+
+	FWorkshopUploaderImpl();
+	~FWorkshopUploaderImpl();
+
+	/* Tick function for periodic updates */
+	bool Tick(float DeltaTime);
+
+	/* Attempts to get the Workshop backend ready, returns false if it isn't available */
+	bool TryInitializeWorkshop();
+
+	TSharedRef<SDockTab> SpawnTab();
+
+	/* What UWorkshopUploaderSubsystem scripts against, the same work the tab does without building any of its widgets */
+
+	/* Rescans the mod folders and returns every mod with a staged build, sorted by name */
+	TArray<TSharedPtr<FWorkshopModEntry>> GetPackagedMods();
+
+	/* Item the mod is published to from here, 0 if it never was */
+	uint64 FindWorkshopIdForPackage(const FString& Package) const;
+
+	/* Whether the mod can be published as it's staged now, OnComplete gets what would stop it (nothing if it can be) and what's only worth knowing */
+	void ValidatePackagedMod(const FString& Package, TFunction<void(const TArray<FString>& Errors, const TArray<FString>& Warnings)> OnComplete);
+
+	/* Other apps a packaged mod is published to as well, saved with its draft */
+	void SetPackageTargetApps(const FString& Package, const TArray<uint32>& AppIds);
+
+	/* Publishes a packaged mod, creating its item the first time. ChangeNote is only used for mods that are already on the Workshop */
+	void PublishPackagedMod(const FString& Package, const FText& ChangeNote, TFunction<void(bool bSuccess, const FString& Message)> OnComplete);
+
+	void QueryItems(const TArray<uint64>& PublishedFileIds, FOnWorkshopItemsQueried OnComplete);
+
+	/* Items the logged in user has published for the running app */
+	void QueryPublishedItems(FOnWorkshopItemsQueried OnComplete);
+
+private:
+
+	/* Rate limits every Workshop call, Backend is this same object */
+	TSharedRef<FWorkshopCallScheduler> CallScheduler;
+	TSharedRef<IWorkshopBackend> Backend;
+
+	/* Queue stats are refreshed in the status texts while calls are waiting */
+	double NextCallStatsRefreshTime = 0.0;
+
+	/* Hashing, measuring and other file work on the thread pool, shared with everything else that needs it and ticked here */
+	TSharedRef<FWorkshopBackgroundTasks> BackgroundTasks;
+
+	/* Form state and upload status, outlives the tab */
+	TSharedRef<FWorkshopUploaderViewModel> ViewModel;
+
+	/* Tab contents, built on first spawn and reused after that */
+	TSharedPtr<SWorkshopUploaderPanel> Panel;
+
+	/* Packages mods in the background and publishes them as they finish */
+	TUniquePtr<FWorkshopPackagePipeline> Pipeline;
+
+	/* Metadata only changes to many published items at once */
+	TUniquePtr<FWorkshopBulkEditor> BulkEditor;
+	void HandleBulkEditResultsChanged();
+
+	/* Publishes mods whenever their staged build changes */
+	TUniquePtr<FWorkshopWatchMode> WatchMode;
+	void HandleWatchesChanged();
+	void HandleDraftPackageChanged(bool IsUpdateMod);
+
+	/* Runs the game against staged content before it's uploaded, when a game executable is configured */
+	TUniquePtr<FWorkshopSmokeTester> SmokeTester;
+
+	/* Finds the maps in a mod's build for this platform (as staged, or repacked) on the thread pool, then opens each of them in the game */
+	void SmokeTestStagedContent(const FString& StagedBuildsDir, TFunction<void(const FWorkshopSmokeTestReport& Report)> OnComplete);
+
+	/* Packs loose and uncompressed staged content into compressed paks before it's uploaded, when enabled in config */
+	TUniquePtr<FWorkshopRepacker> Repacker;
+
+	/* Measures each staged platform of the mods on the thread pool, Platforms holds each report's platform (empty for a mod staged for only one) */
+	void MeasureStagedSizes(const TArray<FString>& Packages, TFunction<void(const TArray<FWorkshopSizeReport>& Reports, const TArray<FString>& Platforms)> OnComplete);
+
+	/* Classifies the mod's staged content on the thread pool, OnComplete gets the tags it matched (possibly none) */
+	void SuggestTags(const FString& Package, TFunction<void(const TArray<FString>& Tags)> OnComplete);
+
+	/* Content only update of a watched mod, with a change note listing what changed since it was last published */
+	void PublishWatchedMod(const FString& Package, uint64 PublishedFileId, TFunction<void(bool bSuccess, const FString& Message)> OnComplete);
+
+	/* Rate limiter queues and throttling, appended to the pipeline and bulk edit status */
+	FString DescribeCallStats() const;
+
+	void onItemCreated(const FWorkshopResult& Result, uint64 PublishedFileId, bool bNeedsLegalAgreement);
+	void onItemSubmitted(const FWorkshopResult& Result, bool bNeedsLegalAgreement, bool IsUpdateMod);
+
+	void UpdateWorkshopItem(uint32 ConsumerAppId, uint64 PublishedFileID, bool IsUpdateMod = false);
+
+	/* Uploads a draft's content and fields to an existing item, fanning out to one item per platform when several were staged */
+	void SubmitDraft(const FWorkshopItemDraft& Draft, uint32 ConsumerAppId, uint64 PublishedFileID, bool IsUpdateMod, FOnWorkshopItemSubmitted OnSubmitted);
+	/* Rest of SubmitDraft once the draft's preview images have been processed, saving the source manifest of the mod's staged build once it's published */
+	void SubmitDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted);
+	/* Rest of SubmitDraftContent, repacks the mod's whole staged build when repacking is enabled */
+	void RepackDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted);
+	/* Rest of RepackDraftContent, the build that's uploaded (StagedBuildsDir) has to pass its smoke test first */
+	void SmokeTestDraftContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, FOnWorkshopItemSubmitted OnSubmitted);
+	/* Rest of SmokeTestDraftContent once the content has passed its smoke test, or didn't need one */
+	void SubmitTestedContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, FOnWorkshopItemSubmitted OnSubmitted);
+
+	/* Workshop items of the mods a mod depends on, leaving out ones that were never published. With a platform or app, the items for that platform in that app (0 for the editor's own) */
+	TArray<uint64> ResolveModDependencies(const FString& Package, const FString& Platform = FString(), uint32 AppId = 0) const;
+
+	/* Adds and removes Workshop dependency links on every platform and app item of the mod so they match its .uplugin */
+	void SyncModDependencies(const FString& Package, uint64 PublishedFileId, TFunction<void()> OnComplete);
+
+	/* One item a submission uploads to */
+	struct FSizedUpload
+	{
+		FString Name;
+		FString ContentFolder;
+		uint64 PublishedFileId = 0;
+
+		/* Another app's copy of an upload already in the batch */
+		bool bAppCopy = false;
+	};
+
+	/* Checks everything a submission uploads against the budgets, and its combined growth against the quota, before any of it is sent. Error is empty if it can go ahead */
+	void CheckUploadSizes(const TArray<FSizedUpload>& Uploads, TFunction<void(const FString& Error)> OnChecked);
+
+	/* Size checks every platform's item and each app's copy of it as one batch, then submits them. Other apps' copies are uploaded from AppCopiesBuildsDir */
+	void SubmitStagedContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, const FString& AppCopiesBuildsDir, FOnWorkshopItemSubmitted OnSubmitted);
+	void SubmitPlatformItems(const FWorkshopItemUpdate& Update, const FString& Package, const FString& StagedBuildsDir, const FString& AppCopiesBuildsDir, const TArray<FString>& Platforms, FOnWorkshopItemSubmitted OnSubmitted);
+
+	/* Submits a single item with metadata generated from its content, saving its content manifest if it succeeds. Its size has already been checked. Empty AppCopiesFolder for other apps to get the same content */
+	void SubmitItemContent(const FWorkshopItemUpdate& Update, const FString& Package, const FString& AppCopiesFolder, FOnWorkshopItemSubmitted OnSubmitted);
+
+	/* Submits the hashed update to the item's copy in every app it targets at the same time, creating the copies the first time. Apps after the first get AppCopiesUpdate */
+	void SubmitAppItems(const FWorkshopItemUpdate& Update, TSharedRef<FWorkshopContentManifest> Manifest, const FWorkshopItemUpdate& AppCopiesUpdate, TSharedRef<FWorkshopContentManifest> AppCopiesManifest, const FString& Package, FOnWorkshopItemSubmitted OnSubmitted);
+
+	/* Last step for a single item once its content has been hashed, sending its other languages and verifying it if bVerify */
+	void SubmitHashedItem(const FWorkshopItemUpdate& Update, TSharedRef<FWorkshopContentManifest> Manifest, bool bVerify, FOnWorkshopItemSubmitted OnSubmitted);
+
+	/* Downloads a just published item and checks every file against the manifest it was published with */
+	void VerifyPublishedItem(uint64 PublishedFileId, TSharedRef<FWorkshopContentManifest> Expected, TFunction<void(bool bVerified, const FString& Report)> OnComplete);
+
+	/* Sends the update's other languages after its content has gone up, one text only update each */
+	void SubmitLocalizedText(const FWorkshopItemUpdate& Update, TFunction<void(const TArray<FString>& FailedLanguages)> OnComplete);
+
+	/* First publish of a packaged mod, remembering the new item so later publishes update it */
+	void CreatePackagedModItem(const FString& Package, TFunction<void(bool bSuccess, const FString& Message)> OnComplete);
+	void HandlePipelineJobsChanged();
+
+	/* Last duplicate analysis, what Split Into Shared Item works from */
+	TSharedPtr<FWorkshopDedupReport> LastDedupReport;
+
+	/* Mods ticked in the package pipeline, or every packaged mod if none are */
+	TArray<FString> GetSharedContentPackages() const;
+	/* Creates and uploads each platform's shared item, then saves the plan with the items whose content made it up marked published */
+	void PublishSharedItems(const FWorkshopSharedContentPlan& Plan);
+
+	/* Button click events */
+	FReply OnPublishNewModClicked();
+	FReply OnPublishUpdateModClicked();
+	FReply OnAnalyzePatchClicked();
+	FReply OnPackageAndPublishClicked();
+	FReply OnCancelPipelineClicked();
+	FReply OnAnalyzeSharedContentClicked();
+	FReply OnSplitSharedContentClicked();
+	FReply OnLoadPublishedItemsClicked();
+	FReply OnApplyBulkEditClicked();
+	FReply OnCancelBulkEditClicked();
+	FReply OnWatchUpdateModClicked();
+	FReply OnStopWatchingClicked();
+	FReply OnAnalyzeSizesClicked();
+};
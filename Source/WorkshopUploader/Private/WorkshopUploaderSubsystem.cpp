@@ -0,0 +1,231 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopUploaderSubsystem.h"
+#include "WorkshopUploader.h"
+#include "WorkshopUploaderImpl.h"
+#include "WorkshopModIndex.h"
+#include "Modules/ModuleManager.h"
+
+static FWorkshopUploaderImpl& GetUploaderImpl()
+{
+	return FModuleManager::GetModuleChecked<FWorkshopUploaderModule>(TEXT("WorkshopUploader")).GetImpl();
+}
+
+static FWorkshopScriptItem MakeScriptItem(const FWorkshopItemDetails& Details)
+{
+	FWorkshopScriptItem Item;
+	Item.PublishedFileId = LexToString(Details.PublishedFileId);
+	Item.Title = Details.Title;
+	Item.Description = Details.Description;
+	Item.Tags = Details.Tags;
+	Item.Visibility = static_cast<EWorkshopScriptVisibility>(Details.Visibility);
+	return Item;
+}
+
+static FOnWorkshopItemsQueried MakeQueryCallback(const FOnWorkshopScriptItemsQueried& OnQueried)
+{
+	return [OnQueried](const FWorkshopResult& Result, const TArray<FWorkshopItemDetails>& Details)
+	{
+		TArray<FWorkshopScriptItem> Items;
+		for (const FWorkshopItemDetails& ItemDetails : Details)
+			Items.Add(MakeScriptItem(ItemDetails));
+
+		OnQueried.ExecuteIfBound(Result.bSuccess, Items, Result.Message);
+	};
+}
+
+bool UWorkshopUploaderSubsystem::IsWorkshopAvailable()
+{
+	return GetUploaderImpl().TryInitializeWorkshop();
+}
+
+TArray<FWorkshopPackagedMod> UWorkshopUploaderSubsystem::GetPackagedMods()
+{
+	TArray<FWorkshopPackagedMod> Mods;
+
+	for (const TSharedPtr<FWorkshopModEntry>& Entry : GetUploaderImpl().GetPackagedMods())
+	{
+		FWorkshopPackagedMod& Mod = Mods.AddDefaulted_GetRef();
+		Mod.Package = Entry->Package;
+		Mod.FriendlyName = Entry->FriendlyName;
+		Mod.Tags = Entry->Tags;
+		Mod.Platforms = Entry->Platforms;
+		Mod.StagedSize = Entry->StagedSize;
+		Mod.PublishedFileId = Entry->PublishedFileId != 0 ? LexToString(Entry->PublishedFileId) : FString();
+		Mod.LastPublished = Entry->LastPublished;
+	}
+
+	return Mods;
+}
+
+void UWorkshopUploaderSubsystem::ValidateMod(const FString& Package, const FOnWorkshopModValidated& OnValidated)
+{
+	GetUploaderImpl().ValidatePackagedMod(Package, [OnValidated](const TArray<FString>& Errors, const TArray<FString>& Warnings)
+	{
+		OnValidated.ExecuteIfBound(Errors, Warnings);
+	});
+}
+
+void UWorkshopUploaderSubsystem::SetModTargetApps(const FString& Package, const TArray<int32>& AppIds)
+{
+	TArray<uint32> TargetAppIds;
+	for (int32 AppId : AppIds)
+	{
+		if (AppId > 0)
+			TargetAppIds.AddUnique((uint32)AppId);
+	}
+
+	GetUploaderImpl().SetPackageTargetApps(Package, TargetAppIds);
+}
+
+void UWorkshopUploaderSubsystem::PublishMod(const FString& Package, const FString& ChangeNote, const FOnWorkshopModPublished& OnPublished)
+{
+	if (IsQueuedOrPublishing(Package))
+	{
+		OnPublished.ExecuteIfBound(false, FString(), FString::Printf(TEXT("%s is already queued for publishing"), *Package));
+		return;
+	}
+
+	PublishQueue.Add({ Package, FText::FromString(ChangeNote), OnPublished });
+	++NumQueued;
+
+	StartQueuedPublishes();
+}
+
+int32 UWorkshopUploaderSubsystem::PublishMods(const TArray<FString>& Packages, const FString& ChangeNote)
+{
+	int32 NumAdded = 0;
+
+	for (const FString& Package : Packages)
+	{
+		if (IsQueuedOrPublishing(Package))
+			continue;
+
+		PublishQueue.Add({ Package, FText::FromString(ChangeNote), FOnWorkshopModPublished() });
+		++NumQueued;
+		++NumAdded;
+	}
+
+	StartQueuedPublishes();
+
+	return NumAdded;
+}
+
+void UWorkshopUploaderSubsystem::CancelQueuedPublishes()
+{
+	// Callbacks can queue more publishes
+	TArray<FQueuedPublish> Cancelled = MoveTemp(PublishQueue);
+	PublishQueue.Reset();
+
+	NumFailed += Cancelled.Num();
+
+	for (const FQueuedPublish& Queued : Cancelled)
+	{
+		Queued.OnPublished.ExecuteIfBound(false, FString(), TEXT("Cancelled"));
+		BroadcastProgress(Queued.Package, EWorkshopPublishStage::Failed, TEXT("Cancelled"));
+	}
+
+	StartQueuedPublishes();
+}
+
+bool UWorkshopUploaderSubsystem::IsPublishing() const
+{
+	return PublishingPackages.Num() > 0 || PublishQueue.Num() > 0;
+}
+
+void UWorkshopUploaderSubsystem::QueryItems(const TArray<FString>& PublishedFileIds, const FOnWorkshopScriptItemsQueried& OnQueried)
+{
+	TArray<uint64> Ids;
+
+	for (const FString& PublishedFileId : PublishedFileIds)
+	{
+		uint64 Id = 0;
+		LexFromString(Id, *PublishedFileId);
+
+		if (Id != 0)
+			Ids.Add(Id);
+	}
+
+	if (Ids.Num() == 0)
+	{
+		OnQueried.ExecuteIfBound(true, TArray<FWorkshopScriptItem>(), FString());
+		return;
+	}
+
+	GetUploaderImpl().QueryItems(Ids, MakeQueryCallback(OnQueried));
+}
+
+void UWorkshopUploaderSubsystem::QueryPublishedItems(const FOnWorkshopScriptItemsQueried& OnQueried)
+{
+	GetUploaderImpl().QueryPublishedItems(MakeQueryCallback(OnQueried));
+}
+
+void UWorkshopUploaderSubsystem::StartQueuedPublishes()
+{
+	while (PublishQueue.Num() > 0 && PublishingPackages.Num() < FMath::Max(1, MaxConcurrentPublishes))
+	{
+		FQueuedPublish Publish = PublishQueue[0];
+		PublishQueue.RemoveAt(0);
+
+		PublishingPackages.Add(Publish.Package);
+		BroadcastProgress(Publish.Package, EWorkshopPublishStage::Started, FString());
+
+		TWeakObjectPtr<UWorkshopUploaderSubsystem> WeakThis(this);
+
+		GetUploaderImpl().PublishPackagedMod(Publish.Package, Publish.ChangeNote, [WeakThis, Publish](bool bSuccess, const FString& Message)
+		{
+			const uint64 PublishedFileId = GetUploaderImpl().FindWorkshopIdForPackage(Publish.Package);
+			const FString PublishedFileIdString = PublishedFileId != 0 ? LexToString(PublishedFileId) : FString();
+
+			UE_LOG(LogWorkshopUploader, Log, TEXT("Scripted publish of %s %s %s"), *Publish.Package, bSuccess ? TEXT("succeeded,") : TEXT("failed:"), bSuccess ? *PublishedFileIdString : *Message);
+
+			// Counts are updated before anything is called, so callbacks that queue more see the queue as it is
+			UWorkshopUploaderSubsystem* This = WeakThis.Get();
+			if (This != nullptr)
+			{
+				This->PublishingPackages.Remove(Publish.Package);
+
+				if (bSuccess)
+					++This->NumSucceeded;
+				else
+					++This->NumFailed;
+			}
+
+			Publish.OnPublished.ExecuteIfBound(bSuccess, PublishedFileIdString, Message);
+
+			if (WeakThis.IsValid())
+			{
+				This->BroadcastProgress(Publish.Package, bSuccess ? EWorkshopPublishStage::Succeeded : EWorkshopPublishStage::Failed, bSuccess ? PublishedFileIdString : Message);
+				This->StartQueuedPublishes();
+			}
+		});
+	}
+
+	if (PublishingPackages.Num() == 0 && PublishQueue.Num() == 0 && NumQueued > 0)
+	{
+		const int32 Succeeded = NumSucceeded;
+		const int32 Failed = NumFailed;
+
+		NumQueued = NumSucceeded = NumFailed = 0;
+
+		OnPublishQueueEmptied.Broadcast(Succeeded, Failed);
+	}
+}
+
+bool UWorkshopUploaderSubsystem::IsQueuedOrPublishing(const FString& Package) const
+{
+	// The same mod twice at once would race to create its item
+	return PublishingPackages.Contains(Package) || PublishQueue.ContainsByPredicate([&Package](const FQueuedPublish& Queued) { return Queued.Package == Package; });
+}
+
+void UWorkshopUploaderSubsystem::BroadcastProgress(const FString& Package, EWorkshopPublishStage Stage, const FString& Message)
+{
+	FWorkshopPublishProgress Progress;
+	Progress.Package = Package;
+	Progress.Stage = Stage;
+	Progress.Message = Message;
+	Progress.NumFinished = NumSucceeded + NumFailed;
+	Progress.NumTotal = NumQueued;
+
+	OnPublishProgress.Broadcast(Progress);
+}
@@ -0,0 +1,280 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopUploaderViewModel.h"
+#include "WorkshopModDiscovery.h"
+#include "WorkshopBackgroundTasks.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* NewModDraftKey = TEXT("NewMod");
+static const TCHAR* UpdateModDraftKey = TEXT("UpdateMod");
+
+/* Package pipeline drafts are keyed by the mod's plugin name */
+static const TCHAR* PackageDraftKeyPrefix = TEXT("Package:");
+
+FWorkshopUploaderViewModel::FWorkshopUploaderViewModel(TSharedRef<FWorkshopBackgroundTasks> InBackgroundTasks)
+	: BackgroundTasks(InBackgroundTasks)
+	, ModIndex(MakeShared<FWorkshopModIndex>())
+	, TagSettings(FWorkshopTagSettings::Load())
+	, SizeBudgets(FWorkshopSizeBudgets::Load())
+{
+	Drafts.Load();
+
+	// Default values
+	FWorkshopItemDraft NewModDefault;
+	NewModDefault.Title = FText::FromString("My Mod Title");
+	NewModDefault.Description = FText::FromString("My Mod Description");
+
+	FWorkshopItemDraft UpdateModDefault;
+	UpdateModDefault.ChangeNote = FText::FromString("Updated.");
+
+	// Adding can move the map's elements, so don't hold on to the first reference while adding the second
+	Drafts.FindOrAdd(NewModDraftKey, NewModDefault);
+	Drafts.FindOrAdd(UpdateModDraftKey, UpdateModDefault);
+}
+
+FWorkshopItemDraft& FWorkshopUploaderViewModel::GetDraft(bool IsUpdateMod)
+{
+	return Drafts.FindOrAdd(IsUpdateMod ? UpdateModDraftKey : NewModDraftKey);
+}
+
+void FWorkshopUploaderViewModel::SetDraftPackage(bool IsUpdateMod, const FString& Package)
+{
+	GetDraft(IsUpdateMod).Package = Package;
+	MarkDraftsDirty();
+
+	OnDraftPackageChanged.Broadcast(IsUpdateMod);
+}
+
+void FWorkshopUploaderViewModel::Tick(float DeltaTime)
+{
+	Drafts.Tick(DeltaTime);
+}
+
+void FWorkshopUploaderViewModel::SaveDrafts()
+{
+	Drafts.Save();
+}
+
+void FWorkshopUploaderViewModel::RefreshPackagedMods()
+{
+	if (bIsRefreshingMods)
+	{
+		bRefreshModsAgain = true;
+		return;
+	}
+
+	bIsRefreshingMods = true;
+
+	// The pickers keep searching the current index while the new one is built from a copy of it
+	const TSharedRef<FWorkshopModIndex> Previous = ModIndex;
+	const TMap<FString, FWorkshopModEntry> DraftInfo = GatherDraftInfo();
+	TSharedRef<TSharedPtr<FWorkshopModIndex>> Rebuilt = MakeShared<TSharedPtr<FWorkshopModIndex>>();
+
+	BackgroundTasks->Run([Previous, DraftInfo, Rebuilt]()
+	{
+		*Rebuilt = BuildModIndex(*Previous, DraftInfo);
+	},
+	[this, Rebuilt]()
+	{
+		ModIndex = Rebuilt->ToSharedRef();
+		bIsRefreshingMods = false;
+
+		OnPackagedModsChanged.Broadcast();
+
+		// Mods staged while that scan ran
+		if (bRefreshModsAgain)
+		{
+			bRefreshModsAgain = false;
+			RefreshPackagedMods();
+		}
+	});
+}
+
+void FWorkshopUploaderViewModel::RefreshPackagedModsNow()
+{
+	ModIndex = BuildModIndex(*ModIndex, GatherDraftInfo());
+
+	OnPackagedModsChanged.Broadcast();
+}
+
+TMap<FString, FWorkshopModEntry> FWorkshopUploaderViewModel::GatherDraftInfo() const
+{
+	// One pass over the drafts for every mod's tags and item, rather than one per mod
+	TMap<FString, FWorkshopModEntry> DraftInfo;
+
+	for (const TPair<FString, FWorkshopItemDraft>& Entry : Drafts.GetDrafts())
+	{
+		const FWorkshopItemDraft& Draft = Entry.Value;
+		if (Draft.Package.IsEmpty())
+			continue;
+
+		FWorkshopModEntry& Info = DraftInfo.FindOrAdd(Draft.Package);
+
+		for (const FString& Tag : Draft.Tags)
+			Info.Tags.AddUnique(Tag);
+
+		if (Info.PublishedFileId == 0)
+			Info.PublishedFileId = Draft.GetWorkshopId();
+	}
+
+	return DraftInfo;
+}
+
+TSharedRef<FWorkshopModIndex> FWorkshopUploaderViewModel::BuildModIndex(const FWorkshopModIndex& Previous, const TMap<FString, FWorkshopModEntry>& DraftInfo)
+{
+	// Mods packaged or copied in since the last refresh show up without restarting the editor
+	FWorkshopModDiscovery& Discovery = FWorkshopModDiscovery::Get();
+	Discovery.Rescan();
+
+	TArray<FWorkshopModEntry> Mods;
+
+	for (const FString& Package : Discovery.GetPackages())
+	{
+		FWorkshopDiscoveredMod DiscoveredMod;
+		if (!Discovery.FindMod(Package, DiscoveredMod))
+			continue;
+
+		FWorkshopModEntry Mod = DraftInfo.FindRef(Package);
+		Mod.Package = Package;
+		Mod.FriendlyName = DiscoveredMod.Descriptor.FriendlyName;
+
+		if (!DiscoveredMod.Descriptor.Category.IsEmpty())
+			Mod.Tags.AddUnique(DiscoveredMod.Descriptor.Category);
+
+		Mods.Add(MoveTemp(Mod));
+	}
+
+	// Rebuilt from a copy so what was measured before is reused, without touching the index in use
+	TSharedRef<FWorkshopModIndex> Index = MakeShared<FWorkshopModIndex>(Previous);
+	Index->Rebuild(MoveTemp(Mods));
+
+	return Index;
+}
+
+void FWorkshopUploaderViewModel::ApplyDiscoverySettings(const FWorkshopModDiscoverySettings& Settings)
+{
+	FWorkshopModDiscovery::Get().SetSettings(Settings);
+	RefreshPackagedMods();
+}
+
+void FWorkshopUploaderViewModel::SetStatus(bool IsUpdateMod, EWorkshopUploadState State, const FText& Message)
+{
+	FWorkshopUploadStatus& Status = IsUpdateMod ? UpdateModStatus : NewModStatus;
+	Status.State = State;
+	Status.Message = Message;
+
+	OnStatusChanged.Broadcast(IsUpdateMod);
+}
+
+bool FWorkshopUploaderViewModel::IsPublishing() const
+{
+	return NewModStatus.State == EWorkshopUploadState::InProgress || UpdateModStatus.State == EWorkshopUploadState::InProgress;
+}
+
+void FWorkshopUploaderViewModel::SetPatchReport(bool bInProgress, const FText& Report)
+{
+	bIsAnalyzingPatch = bInProgress;
+	PatchReport = Report;
+
+	OnPatchReportChanged.Broadcast();
+}
+
+FWorkshopItemDraft& FWorkshopUploaderViewModel::GetPackageDraft(const FString& Package)
+{
+	const FString Key = PackageDraftKeyPrefix + Package;
+
+	FWorkshopItemDraft Default;
+	Default.Package = Package;
+	Default.Title = FText::FromString(Package);
+	Default.ChangeNote = FText::FromString(TEXT("Initial creation."));
+
+	FWorkshopDiscoveredMod Mod;
+	if (FWorkshopModDiscovery::Get().FindMod(Package, Mod))
+	{
+		const FPluginDescriptor& Descriptor = Mod.Descriptor;
+
+		if (!Descriptor.FriendlyName.IsEmpty())
+			Default.Title = FText::FromString(Descriptor.FriendlyName);
+
+		Default.Description = FText::FromString(Descriptor.Description);
+
+		const FString IconPath = Mod.BaseDir / TEXT("Resources/Icon128.png");
+		if (FPaths::FileExists(IconPath))
+			Default.Thumbnail = FText::FromString(IconPath);
+	}
+
+	return Drafts.FindOrAdd(Key, Default);
+}
+
+TArray<FString> FWorkshopUploaderViewModel::GetProjectMods() const
+{
+	return FWorkshopModDiscovery::Get().GetPackages();
+}
+
+TArray<FString> FWorkshopUploaderViewModel::GetModDependencies(const FString& Package) const
+{
+	TArray<FString> Dependencies;
+
+	FWorkshopDiscoveredMod Mod;
+	if (!FWorkshopModDiscovery::Get().FindMod(Package, Mod))
+		return Dependencies;
+
+	const TArray<FString> ProjectMods = GetProjectMods();
+
+	for (const FPluginReferenceDescriptor& Reference : Mod.Descriptor.Plugins)
+	{
+		if (Reference.bEnabled && Reference.Name != Package && ProjectMods.Contains(Reference.Name))
+			Dependencies.AddUnique(Reference.Name);
+	}
+
+	return Dependencies;
+}
+
+void FWorkshopUploaderViewModel::SetPipelineStatus(bool bRunning, const FText& Status)
+{
+	bIsPipelineRunning = bRunning;
+	PipelineStatus = Status;
+
+	OnPipelineStatusChanged.Broadcast();
+}
+
+void FWorkshopUploaderViewModel::SetSharedContentReport(bool bInProgress, const FText& Report)
+{
+	bIsProcessingSharedContent = bInProgress;
+	SharedContentReport = Report;
+
+	OnSharedContentReportChanged.Broadcast();
+}
+
+void FWorkshopUploaderViewModel::SetBulkItems(const FText& Items, bool bNotify)
+{
+	BulkItems = Items;
+
+	// Typing into the list shouldn't reset the box it's typed into
+	if (bNotify)
+		OnBulkItemsChanged.Broadcast();
+}
+
+void FWorkshopUploaderViewModel::SetBulkEditStatus(bool bRunning, const FText& Status)
+{
+	bIsBulkEditing = bRunning;
+	BulkEditStatus = Status;
+
+	OnBulkEditStatusChanged.Broadcast();
+}
+
+void FWorkshopUploaderViewModel::SetWatchStatus(bool bWatching, const FText& Status)
+{
+	bIsWatching = bWatching;
+	WatchStatus = Status;
+
+	OnWatchStatusChanged.Broadcast();
+}
+
+void FWorkshopUploaderViewModel::SetSizeReport(bool bInProgress, const FText& Report)
+{
+	bIsAnalyzingSizes = bInProgress;
+	SizeReport = Report;
+
+	OnSizeReportChanged.Broadcast();
+}
@@ -0,0 +1,227 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkshopItemDraft.h"
+#include "WorkshopModIndex.h"
+#include "WorkshopModDiscovery.h"
+#include "WorkshopSizeBudget.h"
+#include "WorkshopTagClassifier.h"
+
+class FWorkshopBackgroundTasks;
+
+enum class EWorkshopUploadState : uint8
+{
+	Idle,
+	InProgress,
+	Succeeded,
+	Failed,
+};
+
+struct FWorkshopUploadStatus
+{
+	EWorkshopUploadState State = EWorkshopUploadState::Idle;
+	FText Message;
+};
+
+/**
+ * State behind the uploader tab. Outlives the widgets so closing and reopening the tab keeps everything,
+ * and the widgets only get told about the bits that changed
+ */
+class FWorkshopUploaderViewModel
+{
+public:
+
+	/* Mods are rescanned on BackgroundTasks, which the uploader ticks */
+	explicit FWorkshopUploaderViewModel(TSharedRef<FWorkshopBackgroundTasks> InBackgroundTasks);
+
+	/* Workshop tags and the rules that suggest them, from the project's game config */
+	const FWorkshopTagSettings& GetTagSettings() const { return TagSettings; }
+
+	/* Drafts behind the two forms, saved to disk as they change */
+	FWorkshopItemDraft& GetDraft(bool IsUpdateMod);
+	void MarkDraftsDirty() { Drafts.MarkDirty(); }
+
+	/* Picks the mod a form publishes */
+	void SetDraftPackage(bool IsUpdateMod, const FString& Package);
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnDraftPackageChanged, bool /*IsUpdateMod*/);
+	FOnDraftPackageChanged OnDraftPackageChanged;
+
+	/* Per platform items of a multi-platform item, saved along with the drafts */
+	uint64 FindPlatformItem(uint64 PrimaryItemId, const FString& Platform) const { return Drafts.FindPlatformItem(PrimaryItemId, Platform); }
+	void SetPlatformItem(uint64 PrimaryItemId, const FString& Platform, uint64 PlatformItemId) { Drafts.SetPlatformItem(PrimaryItemId, Platform, PlatformItemId); }
+
+	/* Copies of an item published to other apps, also saved with the drafts */
+	uint64 FindAppItem(uint64 PrimaryItemId, uint32 AppId) const { return Drafts.FindAppItem(PrimaryItemId, AppId); }
+	void SetAppItem(uint64 PrimaryItemId, uint32 AppId, uint64 AppItemId) { Drafts.SetAppItem(PrimaryItemId, AppId, AppItemId); }
+	TArray<uint32> GetAppsWithItem(uint64 PrimaryItemId) const { return Drafts.GetAppsWithItem(PrimaryItemId); }
+
+	/* Dependency links registered for an item and the item a mod was published as, see FWorkshopDraftStore */
+	TArray<uint64> GetItemDependencies(uint64 PublishedFileId) const { return Drafts.GetItemDependencies(PublishedFileId); }
+	void SetItemDependencies(uint64 PublishedFileId, const TArray<uint64>& Dependencies) { Drafts.SetItemDependencies(PublishedFileId, Dependencies); }
+	uint64 FindWorkshopIdForPackage(const FString& Package) const { return Drafts.FindWorkshopIdForPackage(Package); }
+
+	/* Gallery each item was last published with */
+	TArray<FWorkshopPreview> GetPublishedGallery(uint64 PublishedFileId) const { return Drafts.GetPublishedGallery(PublishedFileId); }
+	void SetPublishedGallery(uint64 PublishedFileId, const TArray<FWorkshopPreview>& Gallery) { Drafts.SetPublishedGallery(PublishedFileId, Gallery); }
+
+	/* From the project's game config, edited in place then written back with SaveSizeBudgets */
+	FWorkshopSizeBudgets& GetSizeBudgets() { return SizeBudgets; }
+	void SaveSizeBudgets() const { SizeBudgets.Save(); }
+
+	void Tick(float DeltaTime);
+
+	/* Writes any unsaved draft changes straight away */
+	void SaveDrafts();
+
+	/* Packaged mods that can be published, shared by both pickers. Replaced whenever a refresh finishes, entries found in it stay valid */
+	FWorkshopModIndex& GetModIndex() { return *ModIndex; }
+
+	/**
+	 * Rescans for mods with staged builds on the thread pool, only measuring the ones staged again since the last scan,
+	 * then swaps the new index in and broadcasts OnPackagedModsChanged. Asking again while a refresh runs starts another once it's done
+	 */
+	void RefreshPackagedMods();
+
+	/* The same rescan done straight away, for scripts that need the list before they return */
+	void RefreshPackagedModsNow();
+
+	bool IsRefreshingPackagedMods() const { return bIsRefreshingMods; }
+
+	DECLARE_MULTICAST_DELEGATE(FOnPackagedModsChanged);
+	FOnPackagedModsChanged OnPackagedModsChanged;
+
+	/* Saves where mods are looked for and refreshes the packaged mods with them */
+	void ApplyDiscoverySettings(const FWorkshopModDiscoverySettings& Settings);
+
+	/* Upload status for either form */
+	const FWorkshopUploadStatus& GetStatus(bool IsUpdateMod) const { return IsUpdateMod ? UpdateModStatus : NewModStatus; }
+	void SetStatus(bool IsUpdateMod, EWorkshopUploadState State, const FText& Message);
+
+	/* Only one submission runs at a time */
+	bool IsPublishing() const;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnStatusChanged, bool /*IsUpdateMod*/);
+	FOnStatusChanged OnStatusChanged;
+
+	/* Result of the last staged size analysis */
+	const FText& GetSizeReport() const { return SizeReport; }
+	bool IsAnalyzingSizes() const { return bIsAnalyzingSizes; }
+	void SetSizeReport(bool bInProgress, const FText& Report);
+
+	DECLARE_MULTICAST_DELEGATE(FOnSizeReportChanged);
+	FOnSizeReportChanged OnSizeReportChanged;
+
+	/* Mods being watched and what happened the last time each one was published */
+	const FText& GetWatchStatus() const { return WatchStatus; }
+	bool IsWatching() const { return bIsWatching; }
+	void SetWatchStatus(bool bWatching, const FText& Status);
+
+	DECLARE_MULTICAST_DELEGATE(FOnWatchStatusChanged);
+	FOnWatchStatusChanged OnWatchStatusChanged;
+
+	/* Download every item after publishing it and check its files against what was uploaded */
+	bool bVerifyAfterPublish = false;
+
+	/* Result of the last patch size analysis of the update form */
+	const FText& GetPatchReport() const { return PatchReport; }
+	bool IsAnalyzingPatch() const { return bIsAnalyzingPatch; }
+	void SetPatchReport(bool bInProgress, const FText& Report);
+
+	DECLARE_MULTICAST_DELEGATE(FOnPatchReportChanged);
+	FOnPatchReportChanged OnPatchReportChanged;
+
+	/* Draft for a mod published by the package pipeline, filled from its plugin descriptor the first time */
+	FWorkshopItemDraft& GetPackageDraft(const FString& Package);
+
+	/* Every discovered mod, packaged or not */
+	TArray<FString> GetProjectMods() const;
+
+	/* Other mods in the project that a mod's .uplugin lists under Plugins */
+	TArray<FString> GetModDependencies(const FString& Package) const;
+
+	/* Mods ticked for packaging and publishing, and the change note they all get */
+	TSet<FString> PipelineSelection;
+	FText PipelineChangeNote = FText::FromString(TEXT("Updated."));
+
+	/* Progress of the package pipeline, one line per mod */
+	const FText& GetPipelineStatus() const { return PipelineStatus; }
+	bool IsPipelineRunning() const { return bIsPipelineRunning; }
+	void SetPipelineStatus(bool bRunning, const FText& Status);
+
+	DECLARE_MULTICAST_DELEGATE(FOnPipelineStatusChanged);
+	FOnPipelineStatusChanged OnPipelineStatusChanged;
+
+	/* Duplicate content analysis across mods and the shared item split out of them */
+	const FText& GetSharedContentReport() const { return SharedContentReport; }
+	bool IsProcessingSharedContent() const { return bIsProcessingSharedContent; }
+	void SetSharedContentReport(bool bInProgress, const FText& Report);
+
+	DECLARE_MULTICAST_DELEGATE(FOnSharedContentReportChanged);
+	FOnSharedContentReportChanged OnSharedContentReportChanged;
+
+	/* Published items picked for a bulk edit, one ID per line with anything after it ignored */
+	const FText& GetBulkItems() const { return BulkItems; }
+	void SetBulkItems(const FText& Items, bool bNotify);
+
+	DECLARE_MULTICAST_DELEGATE(FOnBulkItemsChanged);
+	FOnBulkItemsChanged OnBulkItemsChanged;
+
+	/* What the bulk edit changes, visibility 0 keeps it and 1 onwards is EWorkshopVisibility + 1 */
+	int32 BulkVisibilityIndex = 0;
+	FText BulkAddTags;
+	FText BulkRemoveTags;
+	FText BulkDescriptionTemplate;
+
+	/* Per item results of the running or last bulk edit */
+	const FText& GetBulkEditStatus() const { return BulkEditStatus; }
+	bool IsBulkEditing() const { return bIsBulkEditing; }
+	void SetBulkEditStatus(bool bRunning, const FText& Status);
+
+	DECLARE_MULTICAST_DELEGATE(FOnBulkEditStatusChanged);
+	FOnBulkEditStatusChanged OnBulkEditStatusChanged;
+
+private:
+
+	FWorkshopDraftStore Drafts;
+
+	FWorkshopUploadStatus NewModStatus;
+	FWorkshopUploadStatus UpdateModStatus;
+
+	FText PatchReport;
+	bool bIsAnalyzingPatch = false;
+
+	FText PipelineStatus;
+	bool bIsPipelineRunning = false;
+
+	FText SharedContentReport;
+	bool bIsProcessingSharedContent = false;
+
+	FText BulkItems;
+
+	FText BulkEditStatus;
+	bool bIsBulkEditing = false;
+
+	FText WatchStatus;
+	bool bIsWatching = false;
+
+	FText SizeReport;
+	bool bIsAnalyzingSizes = false;
+
+	TSharedRef<FWorkshopBackgroundTasks> BackgroundTasks;
+
+	TSharedRef<FWorkshopModIndex> ModIndex;
+	bool bIsRefreshingMods = false;
+	bool bRefreshModsAgain = false;
+
+	/* Tags and items of every mod with a draft, read on the game thread for the rescan to use */
+	TMap<FString, FWorkshopModEntry> GatherDraftInfo() const;
+
+	/* Rescans the mod folders and rebuilds a copy of Previous with what was found. Safe to run off the game thread */
+	static TSharedRef<FWorkshopModIndex> BuildModIndex(const FWorkshopModIndex& Previous, const TMap<FString, FWorkshopModEntry>& DraftInfo);
+
+	FWorkshopTagSettings TagSettings;
+	FWorkshopSizeBudgets SizeBudgets;
+};
@@ -0,0 +1,213 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "WorkshopWatchMode.h"
+#include "WorkshopUploader.h"
+#include "WorkshopStagedContent.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "WorkshopModDiscovery.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+
+static const TCHAR* GetWatchStateName(EWorkshopWatchState State)
+{
+	switch (State)
+	{
+		case EWorkshopWatchState::Watching: return TEXT("Watching");
+		case EWorkshopWatchState::Settling: return TEXT("Waiting for staging to finish");
+		case EWorkshopWatchState::Publishing: return TEXT("Publishing");
+	}
+
+	return TEXT("");
+}
+
+FWorkshopWatchMode::FWorkshopWatchMode(FPublishWatched InPublishWatched)
+	: PublishWatched(MoveTemp(InPublishWatched))
+{
+}
+
+FWorkshopWatchMode::~FWorkshopWatchMode()
+{
+	// The watcher callbacks point back at this object
+	for (FWorkshopWatch& Watch : Watches)
+		StopWatching(Watch);
+}
+
+bool FWorkshopWatchMode::Watch(const FString& Package, uint64 PublishedFileId)
+{
+	if (FindWatch(Package) != INDEX_NONE)
+		return false;
+
+	FWorkshopDiscoveredMod Mod;
+	if (!FWorkshopModDiscovery::Get().FindMod(Package, Mod))
+		return false;
+
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (DirectoryWatcher == nullptr)
+		return false;
+
+	FWorkshopWatch NewWatch;
+	NewWatch.Package = Package;
+	NewWatch.PublishedFileId = PublishedFileId;
+	NewWatch.WatchedDir = Mod.BaseDir / TEXT("Saved");
+
+	IFileManager::Get().MakeDirectory(*NewWatch.WatchedDir, true);
+
+	if (!DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(NewWatch.WatchedDir,
+		IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FWorkshopWatchMode::HandleDirectoryChanged, Package), NewWatch.WatcherHandle))
+	{
+		return false;
+	}
+
+	UE_LOG(LogWorkshopUploader, Log, TEXT("Watching %s, its staged build will be published to item %llu whenever it changes"), *Package, PublishedFileId);
+
+	Watches.Add(MoveTemp(NewWatch));
+	OnWatchesChanged.Broadcast();
+
+	return true;
+}
+
+void FWorkshopWatchMode::Unwatch(const FString& Package)
+{
+	const int32 WatchIndex = FindWatch(Package);
+	if (WatchIndex == INDEX_NONE)
+		return;
+
+	StopWatching(Watches[WatchIndex]);
+	Watches.RemoveAt(WatchIndex);
+
+	OnWatchesChanged.Broadcast();
+}
+
+void FWorkshopWatchMode::UnwatchAll()
+{
+	for (FWorkshopWatch& Watch : Watches)
+		StopWatching(Watch);
+
+	Watches.Empty();
+
+	OnWatchesChanged.Broadcast();
+}
+
+bool FWorkshopWatchMode::IsWatching(const FString& Package) const
+{
+	return FindWatch(Package) != INDEX_NONE;
+}
+
+void FWorkshopWatchMode::Tick()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (FWorkshopWatch& Watch : Watches)
+	{
+		if (Watch.State != EWorkshopWatchState::Settling || Now - Watch.LastChangeTime < DebounceSeconds)
+			continue;
+
+		Watch.State = EWorkshopWatchState::Publishing;
+		Watch.LastMessage = FString::Printf(TEXT("%d files changed"), Watch.NumChangedFiles);
+		Watch.NumChangedFiles = 0;
+
+		// Publishing can finish straight away and the watch can be gone by then, so it's looked up again by name
+		const FString Package = Watch.Package;
+
+		PublishWatched(Package, Watch.PublishedFileId, [this, Package](bool bSuccess, const FString& Message)
+		{
+			const int32 WatchIndex = FindWatch(Package);
+			if (WatchIndex == INDEX_NONE)
+				return;
+
+			FWorkshopWatch& FinishedWatch = Watches[WatchIndex];
+			FinishedWatch.LastMessage = Message;
+
+			if (bSuccess)
+				++FinishedWatch.NumPublishes;
+
+			if (FinishedWatch.bChangedWhilePublishing)
+			{
+				FinishedWatch.bChangedWhilePublishing = false;
+				FinishedWatch.State = EWorkshopWatchState::Settling;
+			}
+			else
+			{
+				FinishedWatch.State = EWorkshopWatchState::Watching;
+			}
+
+			OnWatchesChanged.Broadcast();
+		});
+
+		OnWatchesChanged.Broadcast();
+	}
+}
+
+FString FWorkshopWatchMode::Describe() const
+{
+	FString Description;
+
+	for (const FWorkshopWatch& Watch : Watches)
+	{
+		Description += FString::Printf(TEXT("%s -> %llu: %s, published %d times"), *Watch.Package, Watch.PublishedFileId, GetWatchStateName(Watch.State), Watch.NumPublishes);
+
+		if (!Watch.LastMessage.IsEmpty())
+			Description += FString::Printf(TEXT(" - %s"), *Watch.LastMessage);
+
+		Description += TEXT("\n");
+	}
+
+	return Description;
+}
+
+void FWorkshopWatchMode::HandleDirectoryChanged(const TArray<FFileChangeData>& Changes, FString Package)
+{
+	const int32 WatchIndex = FindWatch(Package);
+	if (WatchIndex == INDEX_NONE)
+		return;
+
+	FWorkshopWatch& Watch = Watches[WatchIndex];
+
+	// Only the staged build counts, the rest of Saved is logs and cooker leftovers
+	const FString StagedBuildsDir = FPaths::ConvertRelativePathToFull(FWorkshopStagedContent::GetStagedBuildsDir(Package)) / TEXT("");
+
+	int32 NumStagedChanges = 0;
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (FPaths::ConvertRelativePathToFull(Change.Filename).StartsWith(StagedBuildsDir))
+			++NumStagedChanges;
+	}
+
+	if (NumStagedChanges == 0)
+		return;
+
+	Watch.LastChangeTime = FPlatformTime::Seconds();
+	Watch.NumChangedFiles += NumStagedChanges;
+
+	if (Watch.State == EWorkshopWatchState::Publishing)
+	{
+		Watch.bChangedWhilePublishing = true;
+		return;
+	}
+
+	if (Watch.State != EWorkshopWatchState::Settling)
+	{
+		Watch.State = EWorkshopWatchState::Settling;
+		OnWatchesChanged.Broadcast();
+	}
+}
+
+void FWorkshopWatchMode::StopWatching(FWorkshopWatch& Watch)
+{
+	// The module can already be gone when the editor shuts down
+	FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+
+	if (DirectoryWatcherModule != nullptr && DirectoryWatcherModule->Get() != nullptr && Watch.WatcherHandle.IsValid())
+		DirectoryWatcherModule->Get()->UnregisterDirectoryChangedCallback_Handle(Watch.WatchedDir, Watch.WatcherHandle);
+
+	Watch.WatcherHandle.Reset();
+}
+
+int32 FWorkshopWatchMode::FindWatch(const FString& Package) const
+{
+	return Watches.IndexOfByPredicate([&Package](const FWorkshopWatch& Watch) { return Watch.Package == Package; });
+}
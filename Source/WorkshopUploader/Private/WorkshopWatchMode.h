@@ -0,0 +1,80 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+struct FFileChangeData;
+
+enum class EWorkshopWatchState : uint8
+{
+	Watching,
+	Settling,
+	Publishing,
+};
+
+struct FWorkshopWatch
+{
+	FString Package;
+	uint64 PublishedFileId = 0;
+	EWorkshopWatchState State = EWorkshopWatchState::Watching;
+
+	/* The mod's Saved folder, StagedBuilds itself gets deleted and recreated by UAT */
+	FString WatchedDir;
+	FDelegateHandle WatcherHandle;
+
+	double LastChangeTime = 0.0;
+	int32 NumChangedFiles = 0;
+
+	/* Files were written while the last publish was running, the build gets published again once that's done */
+	bool bChangedWhilePublishing = false;
+
+	int32 NumPublishes = 0;
+	FString LastMessage;
+};
+
+/**
+ * Watches mods' staged builds and publishes each one to its item once the files stop changing, so iterating on a
+ * private item is package and wait. Writes come in bursts while UAT stages, so nothing is published until the tree
+ * has been quiet for DebounceSeconds
+ */
+class FWorkshopWatchMode
+{
+public:
+
+	/* Publishes the staged build as a content only update, OnComplete must be called on the game thread once it's done */
+	typedef TFunction<void(const FString& Package, uint64 PublishedFileId, TFunction<void(bool bSuccess, const FString& Message)> OnComplete)> FPublishWatched;
+
+	explicit FWorkshopWatchMode(FPublishWatched InPublishWatched);
+	~FWorkshopWatchMode();
+
+	/* How long the staged build has to stay unchanged before it's published */
+	double DebounceSeconds = 5.0;
+
+	/* Returns false if the mod wasn't discovered or is already being watched */
+	bool Watch(const FString& Package, uint64 PublishedFileId);
+	void Unwatch(const FString& Package);
+	void UnwatchAll();
+
+	bool IsWatching(const FString& Package) const;
+	bool IsWatchingAny() const { return Watches.Num() > 0; }
+
+	void Tick();
+
+	/* One line per watched mod */
+	FString Describe() const;
+
+	DECLARE_MULTICAST_DELEGATE(FOnWatchesChanged);
+	FOnWatchesChanged OnWatchesChanged;
+
+private:
+
+	FPublishWatched PublishWatched;
+
+	TArray<FWorkshopWatch> Watches;
+
+	void HandleDirectoryChanged(const TArray<FFileChangeData>& Changes, FString Package);
+	void StopWatching(FWorkshopWatch& Watch);
+	int32 FindWatch(const FString& Package) const;
+};
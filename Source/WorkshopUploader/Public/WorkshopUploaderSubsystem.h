@@ -0,0 +1,191 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "WorkshopUploaderSubsystem.generated.h"
+
+/* A mod with a staged build, what GetPackagedMods returns */
+USTRUCT(BlueprintType)
+struct FWorkshopPackagedMod
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString Package;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString FriendlyName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	TArray<FString> Tags;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	TArray<FString> Platforms;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	int64 StagedSize = 0;
+
+	/* Workshop item IDs don't fit in Blueprint integers, empty if the mod was never published from here */
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString PublishedFileId;
+
+	/* FDateTime::MinValue() if its content was never published from here */
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FDateTime LastPublished;
+};
+
+UENUM(BlueprintType)
+enum class EWorkshopScriptVisibility : uint8
+{
+	Public,
+	FriendsOnly,
+	Private,
+	Unlisted,
+};
+
+/* A Workshop item as it currently is on the Workshop */
+USTRUCT(BlueprintType)
+struct FWorkshopScriptItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString PublishedFileId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString Title;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString Description;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	TArray<FString> Tags;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	EWorkshopScriptVisibility Visibility = EWorkshopScriptVisibility::Public;
+};
+
+UENUM(BlueprintType)
+enum class EWorkshopPublishStage : uint8
+{
+	Started,
+	Succeeded,
+	Failed,
+};
+
+/* Broadcast every time a queued publish starts or finishes */
+USTRUCT(BlueprintType)
+struct FWorkshopPublishProgress
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString Package;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	EWorkshopPublishStage Stage = EWorkshopPublishStage::Started;
+
+	/* Why it failed, or the item it was published to */
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	FString Message;
+
+	/* Publishes finished and queued since the queue was last empty */
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	int32 NumFinished = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Workshop Uploader")
+	int32 NumTotal = 0;
+};
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnWorkshopModValidated, const TArray<FString>&, Errors, const TArray<FString>&, Warnings);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnWorkshopModPublished, bool, bSuccess, const FString&, PublishedFileId, const FString&, Message);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnWorkshopScriptItemsQueried, bool, bSuccess, const TArray<FWorkshopScriptItem>&, Items, const FString&, Message);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorkshopPublishProgress, const FWorkshopPublishProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWorkshopPublishQueueEmptied, int32, NumSucceeded, int32, NumFailed);
+
+/**
+ * Python and Blueprint access to the uploader, for pipeline scripts that publish without the tab. Runs on the same
+ * implementation the tab does, so drafts, budgets and rate limiting are shared, but never builds any widgets.
+ * Everything that talks to the Workshop is asynchronous: completion delegates are called on the game thread, and
+ * queued publishes report through OnPublishProgress
+ */
+UCLASS()
+class WORKSHOPUPLOADER_API UWorkshopUploaderSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Whether Steam is running and the Workshop can be used, tries to initialise it again if it wasn't */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	bool IsWorkshopAvailable();
+
+	/* Rescans the mod folders, returns every mod with a staged build sorted by name */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	TArray<FWorkshopPackagedMod> GetPackagedMods();
+
+	/* Checks the mod is staged and within its size budget and the account's quota, without publishing anything */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void ValidateMod(const FString& Package, const FOnWorkshopModValidated& OnValidated);
+
+	/* Other apps (a demo, a playtest...) the mod is published to alongside the editor's own, each gets its own item with the same content */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void SetModTargetApps(const FString& Package, const TArray<int32>& AppIds);
+
+	/* Queues a packaged mod for publishing, creating its item the first time. ChangeNote is only used for mods that are already on the Workshop */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void PublishMod(const FString& Package, const FString& ChangeNote, const FOnWorkshopModPublished& OnPublished);
+
+	/* Queues every package, returns how many were queued. Progress is only reported through the events */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	int32 PublishMods(const TArray<FString>& Packages, const FString& ChangeNote);
+
+	/* Drops queued publishes that haven't started, ones already uploading still finish */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void CancelQueuedPublishes();
+
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	bool IsPublishing() const;
+
+	/* Current details of the given items, IDs that don't parse or don't exist are left out */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void QueryItems(const TArray<FString>& PublishedFileIds, const FOnWorkshopScriptItemsQueried& OnQueried);
+
+	/* Every item the logged in user has published for the game */
+	UFUNCTION(BlueprintCallable, Category = "Workshop Uploader")
+	void QueryPublishedItems(const FOnWorkshopScriptItemsQueried& OnQueried);
+
+	UPROPERTY(BlueprintAssignable, Category = "Workshop Uploader")
+	FOnWorkshopPublishProgress OnPublishProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = "Workshop Uploader")
+	FOnWorkshopPublishQueueEmptied OnPublishQueueEmptied;
+
+	/* Publishes that upload side by side, the rest wait in the queue. Workshop calls are rate limited either way */
+	UPROPERTY(BlueprintReadWrite, Category = "Workshop Uploader")
+	int32 MaxConcurrentPublishes = 2;
+
+private:
+
+	struct FQueuedPublish
+	{
+		FString Package;
+		FText ChangeNote;
+		FOnWorkshopModPublished OnPublished;
+	};
+
+	TArray<FQueuedPublish> PublishQueue;
+	TSet<FString> PublishingPackages;
+
+	/* Since the queue was last empty */
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	int32 NumQueued = 0;
+
+	void StartQueuedPublishes();
+	bool IsQueuedOrPublishing(const FString& Package) const;
+	void BroadcastProgress(const FString& Package, EWorkshopPublishStage Stage, const FString& Message);
+};
@@ -18,18 +18,29 @@ public class WorkshopUploader : ModuleRules
 			});
 
 
-        PublicDependencyModuleNames.AddRange(new string[] { "Core", "OnlineSubsystem", "OnlineSubsystemUtils", "Networking", "Sockets", "SlateCore", "InputCore"
-				,"Steamworks"
+        PublicDependencyModuleNames.AddRange(new string[] { "Core", "OnlineSubsystem", "OnlineSubsystemUtils", "Networking", "Sockets", "SlateCore", "InputCore", "CoreUObject", "EditorSubsystem"
 				// ... add other public dependencies that you statically link with here ...
 			});
 
 
         PrivateDependencyModuleNames.AddRange(new string[] { "Projects", "InputCore", "UnrealEd", "LevelEditor", "CoreUObject", "Engine", "Slate", "SlateCore", "InputCore", "OnlineSubsystem", "Sockets", "Networking", "OnlineSubsystemUtils"
-            ,"DesktopPlatform"
+            ,"DesktopPlatform", "Json", "ImageWrapper", "DirectoryWatcher", "PakFile"
 				// ... add private dependencies that you statically link with here ...	
 			});
 
 
+        // The Steam SDK is only used privately by the Steam backend, so dependent modules never need its headers
+        if (Target.Platform == UnrealTargetPlatform.Win64 || Target.Platform == UnrealTargetPlatform.Mac || Target.Platform == UnrealTargetPlatform.Linux)
+        {
+            PrivateDependencyModuleNames.Add("Steamworks");
+            PrivateDefinitions.Add("WITH_STEAM_WORKSHOP=1");
+        }
+        else
+        {
+            PrivateDefinitions.Add("WITH_STEAM_WORKSHOP=0");
+        }
+
+
         DynamicallyLoadedModuleNames.AddRange(new string[]{// ... add any modules that your module loads dynamically here ...
             });
     }